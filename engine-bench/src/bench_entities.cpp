@@ -0,0 +1,218 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "bench_harness.h"
+#include "include/archetype.h"
+#include "include/component.h"
+#include "include/world.h"
+
+// DEFINE_COMPONENT expects to be expanded inside namespace entities
+namespace entities {
+namespace benchmarks {
+
+DEFINE_POD_COMPONENT(BenchPosition, 1)
+    POD_MEMBER_DEFAULT(float, x, 0.0f);
+    POD_MEMBER_DEFAULT(float, y, 0.0f);
+END_POD_COMPONENT
+
+DEFINE_POD_COMPONENT(BenchVelocity, 1)
+    POD_MEMBER_DEFAULT(float, vx, 1.0f);
+    POD_MEMBER_DEFAULT(float, vy, 1.0f);
+END_POD_COMPONENT
+
+DEFINE_POD_COMPONENT(BenchRotation, 1)
+    POD_MEMBER_DEFAULT(float, angle, 0.0f);
+    POD_MEMBER_DEFAULT(float, spin, 0.1f);
+END_POD_COMPONENT
+
+DEFINE_POD_COMPONENT(BenchScale, 1)
+    POD_MEMBER_DEFAULT(float, sx, 1.0f);
+    POD_MEMBER_DEFAULT(float, sy, 1.0f);
+END_POD_COMPONENT
+
+// String-keyed components for the legacy Archetype API
+constexpr size_t LEGACY_MAX_ENTITIES = 100000;
+
+DEFINE_COMPONENT(LegacyPosition, LEGACY_MAX_ENTITIES)
+    COMPONENT_MEMBER(float, x) = 0.0f;
+    COMPONENT_MEMBER(float, y) = 0.0f;
+END_COMPONENT
+
+DEFINE_COMPONENT(LegacyVelocity, LEGACY_MAX_ENTITIES)
+    COMPONENT_MEMBER(float, vx) = 0.0f;
+    COMPONENT_MEMBER(float, vy) = 0.0f;
+END_COMPONENT
+
+DEFINE_ARCHETYPE(LegacyStatic, LegacyPosition);
+DEFINE_ARCHETYPE(LegacyMover, LegacyPosition, LegacyVelocity);
+
+} // namespace benchmarks
+} // namespace entities
+
+namespace bench {
+
+namespace {
+
+using entities::EntityId;
+using entities::World;
+using namespace entities::benchmarks;
+
+void PopulateAll(World& world, uint64_t count) {
+    for (uint64_t i = 0; i < count; ++i) {
+        const EntityId entity = world.CreateEntity();
+        world.AddComponent<BenchPosition>(entity, static_cast<float>(i), 0.0f);
+        world.AddComponent<BenchVelocity>(entity);
+        world.AddComponent<BenchRotation>(entity);
+        world.AddComponent<BenchScale>(entity);
+    }
+}
+
+void BenchChurn(Harness& harness) {
+    for (uint64_t scale : harness.Scales()) {
+        // Create N entities with two components, then destroy them all; indices are recycled after the first run
+        World world;
+        std::vector<EntityId> entities;
+        entities.reserve(scale);
+        harness.Run("entities", "churn_create_destroy", scale, scale, [&] {
+            for (uint64_t i = 0; i < scale; ++i) {
+                const EntityId entity = world.CreateEntity();
+                world.AddComponent<BenchPosition>(entity);
+                world.AddComponent<BenchVelocity>(entity);
+                entities.push_back(entity);
+            }
+            for (const EntityId entity : entities) {
+                world.DestroyEntity(entity);
+            }
+            entities.clear();
+        });
+
+        // Steady state: replace a tenth of a live population every repetition
+        World live;
+        std::vector<EntityId> alive;
+        alive.reserve(scale);
+        for (uint64_t i = 0; i < scale; ++i) {
+            const EntityId entity = live.CreateEntity();
+            live.AddComponent<BenchPosition>(entity);
+            alive.push_back(entity);
+        }
+        const uint64_t replaced = std::max<uint64_t>(scale / 10, 1);
+        uint64_t cursor = 0;
+        harness.Run("entities", "churn_replace_10pct", scale, replaced, [&] {
+            for (uint64_t i = 0; i < replaced; ++i) {
+                const uint64_t slot = (cursor * 7919 + i * 104729) % scale;
+                live.DestroyEntity(alive[slot]);
+                alive[slot] = live.CreateEntity();
+                live.AddComponent<BenchPosition>(alive[slot]);
+            }
+            ++cursor;
+        });
+    }
+}
+
+void BenchIteration(Harness& harness) {
+    for (uint64_t scale : harness.Scales()) {
+        World world;
+        PopulateAll(world, scale);
+        const float dt = 1.0f / 60.0f;
+
+        harness.Run("entities", "each_1_component", scale, scale, [&] {
+            world.Each<BenchPosition>([](EntityId, BenchPosition& position) {
+                position.x += 1.0f;
+            });
+        });
+        harness.Run("entities", "each_2_components", scale, scale, [&] {
+            world.Each<BenchPosition, BenchVelocity>([dt](EntityId, BenchPosition& position, BenchVelocity& velocity) {
+                position.x += velocity.vx * dt;
+                position.y += velocity.vy * dt;
+            });
+        });
+        harness.Run("entities", "each_3_components", scale, scale, [&] {
+            world.Each<BenchPosition, BenchVelocity, BenchRotation>(
+                [dt](EntityId, BenchPosition& position, BenchVelocity& velocity, BenchRotation& rotation) {
+                    position.x += velocity.vx * dt;
+                    position.y += velocity.vy * dt;
+                    rotation.angle += rotation.spin * dt;
+                });
+        });
+        harness.Run("entities", "each_4_components", scale, scale, [&] {
+            world.Each<BenchPosition, BenchVelocity, BenchRotation, BenchScale>(
+                [dt](EntityId, BenchPosition& position, BenchVelocity& velocity, BenchRotation& rotation, BenchScale& scale) {
+                    position.x += velocity.vx * dt * scale.sx;
+                    position.y += velocity.vy * dt * scale.sy;
+                    rotation.angle += rotation.spin * dt;
+                });
+        });
+        // Baseline: the same update over the dense arrays directly, to show the cost of Each's lookups
+        harness.Run("entities", "dense_2_components", scale, scale, [&] {
+            std::vector<BenchPosition>& positions = world.Storage<BenchPosition>().Data();
+            const std::vector<BenchVelocity>& velocities = world.Storage<BenchVelocity>().Data();
+            for (size_t i = 0; i < positions.size(); ++i) {
+                positions[i].x += velocities[i].vx * dt;
+                positions[i].y += velocities[i].vy * dt;
+            }
+            DoNotOptimize(positions.data());
+        });
+    }
+}
+
+void BenchQueries(Harness& harness) {
+    for (uint64_t scale : harness.Scales()) {
+        // Mixed population: every entity moves, every second one rotates, every fourth one scales
+        World world;
+        for (uint64_t i = 0; i < scale; ++i) {
+            const EntityId entity = world.CreateEntity();
+            world.AddComponent<BenchPosition>(entity);
+            world.AddComponent<BenchVelocity>(entity);
+            if (i % 2 == 0) world.AddComponent<BenchRotation>(entity);
+            if (i % 4 == 0) world.AddComponent<BenchScale>(entity);
+        }
+        harness.Run("queries", "world_query_2_of_4", scale, scale, [&] {
+            const std::vector<EntityId> result = world.Query<BenchPosition, BenchVelocity>();
+            DoNotOptimize(result.data());
+        });
+        harness.Run("queries", "world_query_4_of_4", scale, scale, [&] {
+            const std::vector<EntityId> result = world.Query<BenchPosition, BenchVelocity, BenchRotation, BenchScale>();
+            DoNotOptimize(result.data());
+        });
+    }
+
+    // The legacy Archetype API keys everything by string and is capped by its component pools
+    for (uint64_t scale : harness.Scales(entities::benchmarks::LEGACY_MAX_ENTITIES)) {
+        if (!harness.Enabled("queries", "archetype_query")) break;
+        std::vector<std::string> ids;
+        ids.reserve(scale);
+        for (uint64_t i = 0; i < scale; ++i) {
+            ids.push_back("bench_" + std::to_string(i));
+            if (i % 2 == 0) {
+                LegacyMover::Create(ids.back());
+            } else {
+                LegacyStatic::Create(ids.back());
+            }
+        }
+        harness.Run("queries", "archetype_query", scale, scale, [&] {
+            const std::vector<std::string> result = LegacyMover::Query();
+            DoNotOptimize(result.data());
+        });
+        for (uint64_t i = 0; i < scale; ++i) {
+            if (i % 2 == 0) {
+                LegacyMover::DestroyFor(ids[i]);
+            } else {
+                LegacyStatic::DestroyFor(ids[i]);
+            }
+        }
+    }
+}
+
+} // namespace
+
+void RunEntitySuites(Harness& harness) {
+    if (harness.SuiteEnabled("entities")) {
+        BenchChurn(harness);
+        BenchIteration(harness);
+    }
+    if (harness.SuiteEnabled("queries")) {
+        BenchQueries(harness);
+    }
+}
+
+} // namespace bench
@@ -0,0 +1,148 @@
+#include "bench_harness.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#ifndef ENGINE_BENCH_VERSION
+#define ENGINE_BENCH_VERSION "unknown"
+#endif
+#ifndef ENGINE_BENCH_BUILD_TYPE
+#define ENGINE_BENCH_BUILD_TYPE "unknown"
+#endif
+
+namespace bench {
+
+namespace {
+
+const char* CompilerName() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc";
+#else
+    return "unknown";
+#endif
+}
+
+std::string Timestamp() {
+    const std::time_t now = std::time(nullptr);
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    return buffer;
+}
+
+} // namespace
+
+std::vector<uint64_t> Harness::Scales(uint64_t maxScale) const {
+    std::vector<uint64_t> scales;
+    for (uint64_t scale : m_options.scales) {
+        if (scale <= maxScale) scales.push_back(scale);
+    }
+    return scales;
+}
+
+bool Harness::Enabled(const std::string& suite, const std::string& name) const {
+    return m_options.filter.empty() || (suite + "/" + name).find(m_options.filter) != std::string::npos;
+}
+
+bool Harness::SuiteEnabled(const std::string& suite) const {
+    // Without a '/' the filter may match a case name in any suite
+    const size_t slash = m_options.filter.find('/');
+    if (slash == std::string::npos) return true;
+    // Otherwise the text before it must be the end of the suite name
+    return slash <= suite.size() && suite.compare(suite.size() - slash, slash, m_options.filter, 0, slash) == 0;
+}
+
+void Harness::Run(const std::string& suite, const std::string& name, uint64_t scale, uint64_t items,
+                  const std::function<void()>& body, const std::function<void()>& setup) {
+    if (!Enabled(suite, name)) return;
+
+    // Warm-up
+    if (setup) setup();
+    body();
+
+    std::vector<double> samples;
+    samples.reserve(m_options.repetitions);
+    for (uint32_t i = 0; i < m_options.repetitions; ++i) {
+        if (setup) setup();
+        const auto start = std::chrono::steady_clock::now();
+        body();
+        const auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+
+    Result result;
+    result.suite = suite;
+    result.name = name;
+    result.scale = scale;
+    result.items = items;
+    result.repetitions = m_options.repetitions;
+    result.minNs = samples.front();
+    result.maxNs = samples.back();
+    result.medianNs = samples[samples.size() / 2];
+    double total = 0.0;
+    for (double sample : samples) total += sample;
+    result.meanNs = total / static_cast<double>(samples.size());
+    m_results.push_back(result);
+
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-10s %-32s %9llu  %12.3f ms  %10.2f ns/item",
+                  suite.c_str(), name.c_str(), static_cast<unsigned long long>(scale),
+                  result.medianNs * 1e-6, result.NsPerItem());
+    std::cout << line << std::endl;
+}
+
+bool Harness::WriteJson(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open " << path << std::endl;
+        return false;
+    }
+    file << "{\n";
+    file << "  \"version\": \"" << ENGINE_BENCH_VERSION << "\",\n";
+    file << "  \"build_type\": \"" << ENGINE_BENCH_BUILD_TYPE << "\",\n";
+    file << "  \"compiler\": \"" << CompilerName() << "\",\n";
+    file << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+    file << "  \"timestamp\": \"" << Timestamp() << "\",\n";
+    file << "  \"results\": [";
+    char buffer[512];
+    for (size_t i = 0; i < m_results.size(); ++i) {
+        const Result& r = m_results[i];
+        std::snprintf(buffer, sizeof(buffer),
+                      "%s\n    {\"suite\": \"%s\", \"name\": \"%s\", \"scale\": %llu, \"items\": %llu, \"repetitions\": %u, "
+                      "\"min_ns\": %.1f, \"median_ns\": %.1f, \"mean_ns\": %.1f, \"max_ns\": %.1f, \"ns_per_item\": %.3f, \"items_per_second\": %.1f}",
+                      i == 0 ? "" : ",", r.suite.c_str(), r.name.c_str(),
+                      static_cast<unsigned long long>(r.scale), static_cast<unsigned long long>(r.items), r.repetitions,
+                      r.minNs, r.medianNs, r.meanNs, r.maxNs, r.NsPerItem(), r.ItemsPerSecond());
+        file << buffer;
+    }
+    file << "\n  ]\n}\n";
+    return file.good();
+}
+
+bool Harness::WriteCsv(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open " << path << std::endl;
+        return false;
+    }
+    file << "suite,name,scale,items,repetitions,min_ns,median_ns,mean_ns,max_ns,ns_per_item,items_per_second\n";
+    char buffer[512];
+    for (const Result& r : m_results) {
+        std::snprintf(buffer, sizeof(buffer), "%s,%s,%llu,%llu,%u,%.1f,%.1f,%.1f,%.1f,%.3f,%.1f\n",
+                      r.suite.c_str(), r.name.c_str(),
+                      static_cast<unsigned long long>(r.scale), static_cast<unsigned long long>(r.items), r.repetitions,
+                      r.minNs, r.medianNs, r.meanNs, r.maxNs, r.NsPerItem(), r.ItemsPerSecond());
+        file << buffer;
+    }
+    return file.good();
+}
+
+} // namespace bench
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+// One measured case; times are per repetition of the whole body
+struct Result {
+    std::string suite;
+    std::string name;
+    uint64_t scale = 0;        // problem size (entities, jobs, sprites)
+    uint64_t items = 0;        // work items processed by one repetition
+    uint32_t repetitions = 0;
+    double minNs = 0.0;
+    double medianNs = 0.0;
+    double meanNs = 0.0;
+    double maxNs = 0.0;
+
+    double NsPerItem() const { return items ? medianNs / static_cast<double>(items) : 0.0; }
+    double ItemsPerSecond() const { return medianNs > 0.0 ? static_cast<double>(items) * 1e9 / medianNs : 0.0; }
+};
+
+struct Options {
+    std::vector<uint64_t> scales = { 1000, 10000, 100000, 1000000 };
+    uint32_t repetitions = 5;
+    std::string filter;        // only run cases whose "suite/name" contains this
+    std::string jsonPath;
+    std::string csvPath;
+    bool render = false;       // offscreen Vulkan suite; needs a device (lavapipe is enough)
+    std::string framePath;     // render suite writes its last frame here as PPM
+};
+
+/**
+ * @brief Runs benchmark cases and collects their timings
+ *
+ * Every case runs once untimed to warm caches and allocators, then
+ * `repetitions` timed runs. The optional setup callback runs before each
+ * repetition and is not timed. Results are reported as the median, which is
+ * what regression tracking compares.
+ */
+class Harness {
+public:
+    explicit Harness(Options options) : m_options(std::move(options)) {}
+
+    const Options& GetOptions() const { return m_options; }
+
+    // Scales to sweep, capped at `maxScale`
+    std::vector<uint64_t> Scales(uint64_t maxScale = UINT64_MAX) const;
+
+    bool Enabled(const std::string& suite, const std::string& name) const;
+    // True if the filter can match any case of `suite`; suites skip their setup otherwise
+    bool SuiteEnabled(const std::string& suite) const;
+
+    void Run(const std::string& suite, const std::string& name, uint64_t scale, uint64_t items,
+             const std::function<void()>& body, const std::function<void()>& setup = nullptr);
+
+    const std::vector<Result>& Results() const { return m_results; }
+
+    bool WriteJson(const std::string& path) const;
+    bool WriteCsv(const std::string& path) const;
+
+private:
+    Options m_options;
+    std::vector<Result> m_results;
+};
+
+inline volatile const void* g_optimizerSink = nullptr;
+
+// Keeps the optimizer from discarding a computed value (portable to MSVC, which has no inline asm on x64)
+template<typename T>
+inline void DoNotOptimize(const T& value) {
+    g_optimizerSink = &value;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+// Suites, one per translation unit
+void RunEntitySuites(Harness& harness);
+void RunJobSuites(Harness& harness);
+void RunSpriteSuites(Harness& harness);
+void RunRenderSuites(Harness& harness);
+
+} // namespace bench
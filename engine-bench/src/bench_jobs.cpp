@@ -0,0 +1,58 @@
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include "bench_harness.h"
+#include "include/job.h"
+#include "include/job_scheduler.h"
+
+namespace bench {
+
+namespace {
+
+constexpr uint64_t MAX_JOBS = 100000;
+
+// Smallest possible job: measures scheduling overhead, not work
+class CountingJob : public JobSystem::JobBase {
+public:
+    explicit CountingJob(std::atomic<uint64_t>& counter) : JobBase("CountingJob"), m_counter(counter) {}
+
+    void Execute(float) override { m_counter.fetch_add(1, std::memory_order_relaxed); }
+    void RefreshCache() override {}
+
+private:
+    std::atomic<uint64_t>& m_counter;
+};
+
+void BenchScheduling(Harness& harness, size_t threads) {
+    const std::string name = "schedule_" + std::to_string(threads) + "_threads";
+    if (!harness.Enabled("jobs", name)) return;
+
+    JobSystem::JobScheduler scheduler(threads);
+    std::atomic<uint64_t> counter{ 0 };
+    for (uint64_t scale : harness.Scales(MAX_JOBS)) {
+        // Schedule `scale` jobs and wait until every one has executed
+        harness.Run("jobs", name, scale, scale, [&] {
+            counter.store(0, std::memory_order_relaxed);
+            for (uint64_t i = 0; i < scale; ++i) {
+                scheduler.ScheduleJob(new CountingJob(counter));
+            }
+            while (counter.load(std::memory_order_relaxed) < scale) {
+                std::this_thread::yield();
+            }
+            // Release the completed jobs so memory does not grow across repetitions
+            scheduler.Update(0.0f);
+        });
+    }
+}
+
+} // namespace
+
+void RunJobSuites(Harness& harness) {
+    const size_t hardware = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    BenchScheduling(harness, 1);
+    if (hardware >= 4) BenchScheduling(harness, 4);
+    if (hardware != 1 && hardware != 4) BenchScheduling(harness, hardware);
+}
+
+} // namespace bench
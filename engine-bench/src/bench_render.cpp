@@ -0,0 +1,105 @@
+#include <cstdio>
+#include <iostream>
+#include <vector>
+#include "bench_harness.h"
+#include "renderer.h"
+
+namespace bench {
+
+namespace {
+
+constexpr uint32_t FRAME_WIDTH = 1280;
+constexpr uint32_t FRAME_HEIGHT = 720;
+constexpr uint64_t FRAMES = 120;
+// Software rasterizers take seconds per frame beyond this
+constexpr uint64_t MAX_SPRITES = 100000;
+
+// Binary PPM; alpha is dropped. Golden-image tests compare these files
+bool WritePpm(const std::string& path, const std::vector<uint8_t>& rgba, uint32_t width, uint32_t height) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Failed to open " << path << std::endl;
+        return false;
+    }
+    std::fprintf(file, "P6\n%u %u\n255\n", width, height);
+    std::vector<uint8_t> row(static_cast<size_t>(width) * 3);
+    for (uint32_t y = 0; y < height; ++y) {
+        const uint8_t* src = rgba.data() + static_cast<size_t>(y) * width * 4;
+        for (uint32_t x = 0; x < width; ++x) {
+            row[x * 3 + 0] = src[x * 4 + 0];
+            row[x * 3 + 1] = src[x * 4 + 1];
+            row[x * 3 + 2] = src[x * 4 + 2];
+        }
+        std::fwrite(row.data(), 1, row.size(), file);
+    }
+    return std::fclose(file) == 0;
+}
+
+} // namespace
+
+void RunRenderSuites(Harness& harness) {
+    if (!harness.GetOptions().render || !harness.SuiteEnabled("render")) return;
+
+    engine::Renderer renderer;
+    if (!renderer.initializeOffscreen(FRAME_WIDTH, FRAME_HEIGHT)) {
+        std::cerr << "render: no usable Vulkan device, suite skipped" << std::endl;
+        renderer.shutdown();
+        return;
+    }
+    engine::graphics::VulkanRenderingContext& context = *renderer.getRenderingContext();
+    const VkDevice device = context.getDevice().logicalDevice;
+
+    // Frames are pipelined as in the game loop; the wait at the end charges the GPU work still in flight
+    harness.Run("render", "offscreen_frame_720p", FRAMES, FRAMES, [&] {
+        for (uint64_t i = 0; i < FRAMES; ++i) {
+            renderer.render();
+        }
+        vkDeviceWaitIdle(device);
+    });
+
+    // Timestamp scopes of the last completed frame; the lavapipe CI job checks for these lines
+    const engine::graphics::GpuProfiler& gpuProfiler = context.getGpuProfiler();
+    if (gpuProfiler.isSupported()) {
+        std::cout << "render: gpu frame " << gpuProfiler.getFrameMs() << " ms" << std::endl;
+        for (const engine::graphics::GpuScopeResult& scope : gpuProfiler.getResults()) {
+            std::cout << "render: gpu scope " << scope.name << " " << scope.durationMs << " ms" << std::endl;
+        }
+    } else {
+        std::cout << "render: gpu timestamps unsupported" << std::endl;
+    }
+
+    // The same frames with the instanced sprite pass drawing a growing grid of sprites
+    engine::graphics::SpriteManager& sprites = context.getSpriteManager();
+    for (uint64_t scale : harness.Scales(MAX_SPRITES)) {
+        while (sprites.liveCount() < scale) {
+            const uint64_t i = sprites.liveCount();
+            engine::graphics::SpriteDesc desc{};
+            desc.posX = static_cast<float>(i % 1000) * 0.002f - 1.0f;
+            desc.posY = static_cast<float>(i / 1000) * 0.002f - 1.0f;
+            desc.scaleX = 0.002f;
+            desc.scaleY = 0.002f;
+            desc.uvMaxX = 1.0f;
+            desc.uvMaxY = 1.0f;
+            desc.colorRGBA = 0xFF8020FFu;
+            sprites.createSprite(desc);
+        }
+        harness.Run("render", "offscreen_sprites_720p", scale, FRAMES, [&] {
+            for (uint64_t i = 0; i < FRAMES; ++i) {
+                renderer.render();
+            }
+            vkDeviceWaitIdle(device);
+        });
+    }
+
+    const std::string& framePath = harness.GetOptions().framePath;
+    if (!framePath.empty()) {
+        std::vector<uint8_t> pixels;
+        uint32_t width = 0, height = 0;
+        if (context.readbackFrame(pixels, width, height) && WritePpm(framePath, pixels, width, height)) {
+            std::cout << "render: wrote " << framePath << std::endl;
+        }
+    }
+    renderer.shutdown();
+}
+
+} // namespace bench
@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "bench_harness.h"
+#include "sprite_batcher.h"
+#include "sprite_manager.h"
+#include "sprite_packer.h"
+
+namespace bench {
+
+namespace {
+
+using engine::graphics::SpriteDesc;
+using engine::graphics::SpriteHandle;
+using engine::graphics::SpriteManager;
+using engine::graphics::SpritePatch;
+
+SpriteDesc MakeSprite(uint64_t i) {
+    SpriteDesc desc{};
+    desc.posX = static_cast<float>(i % 1024);
+    desc.posY = static_cast<float>(i / 1024);
+    desc.scaleX = 1.0f;
+    desc.scaleY = 1.0f;
+    desc.uvMaxX = 1.0f;
+    desc.uvMaxY = 1.0f;
+    desc.depth = static_cast<float>(i % 16) / 16.0f;
+    desc.textureIndex = static_cast<uint32_t>(i % 8);
+    desc.colorRGBA = 0xFFFFFFFFu;
+    return desc;
+}
+
+// `count` patches spread evenly over the sprites; `mixed` cycles through position, rotation, color and UV
+std::vector<SpritePatch> MakePatches(const std::vector<SpriteHandle>& handles, uint64_t count, bool mixed) {
+    std::vector<SpritePatch> patches(count);
+    const uint64_t stride = handles.size() / count;
+    for (uint64_t i = 0; i < count; ++i) {
+        SpritePatch& patch = patches[i];
+        patch.handle = handles[i * stride];
+        switch (mixed ? i % 4 : 0) {
+            case 0:
+                patch.kind = SpritePatch::Kind::Position;
+                patch.data.vec2v = glm::vec2(static_cast<float>(i), 1.0f);
+                break;
+            case 1:
+                patch.kind = SpritePatch::Kind::Rotation;
+                patch.data.f32v = 0.5f;
+                break;
+            case 2:
+                patch.kind = SpritePatch::Kind::Color;
+                patch.data.u32v = 0xFF00FF00u;
+                break;
+            default:
+                patch.kind = SpritePatch::Kind::UV;
+                patch.data.uv.uvMin = glm::vec2(0.0f, 0.0f);
+                patch.data.uv.uvMax = glm::vec2(0.5f, 0.5f);
+                break;
+        }
+    }
+    return patches;
+}
+
+void BenchSpriteManager(Harness& harness, uint64_t scale) {
+    std::unique_ptr<SpriteManager> fresh;
+    harness.Run("sprites", "create", scale, scale, [&] {
+        for (uint64_t i = 0; i < scale; ++i) {
+            fresh->createSprite(MakeSprite(i));
+        }
+    }, [&] {
+        fresh = std::make_unique<SpriteManager>(static_cast<uint32_t>(scale));
+    });
+    fresh.reset();
+
+    SpriteManager manager(static_cast<uint32_t>(scale));
+    std::vector<SpriteHandle> handles;
+    handles.reserve(scale);
+    for (uint64_t i = 0; i < scale; ++i) {
+        handles.push_back(manager.createSprite(MakeSprite(i)));
+    }
+    manager.buildFrameBatch();
+
+    const uint64_t tenth = std::max<uint64_t>(scale / 10, 1);
+    const std::vector<SpritePatch> position10 = MakePatches(handles, tenth, false);
+    const std::vector<SpritePatch> mixed10 = MakePatches(handles, tenth, true);
+    const std::vector<SpritePatch> position100 = MakePatches(handles, scale, false);
+    const auto clearDirty = [&] { manager.buildFrameBatch(); };
+
+    harness.Run("sprites", "patch_position_10pct", scale, tenth, [&] {
+        manager.applyPatches(position10);
+    }, clearDirty);
+    harness.Run("sprites", "patch_mixed_10pct", scale, tenth, [&] {
+        manager.applyPatches(mixed10);
+    }, clearDirty);
+    harness.Run("sprites", "patch_position_100pct", scale, scale, [&] {
+        manager.applyPatches(position100);
+    }, clearDirty);
+
+    harness.Run("sprites", "build_10pct_dirty", scale, tenth, [&] {
+        const SpriteManager::BuildResult batch = manager.buildFrameBatch();
+        DoNotOptimize(batch.ranges);
+    }, [&] {
+        manager.applyPatches(position10);
+    });
+    harness.Run("sprites", "build_100pct_dirty", scale, scale, [&] {
+        const SpriteManager::BuildResult batch = manager.buildFrameBatch();
+        DoNotOptimize(batch.ranges);
+    }, [&] {
+        manager.applyPatches(position100);
+    });
+
+    // A full frame: 10% of the sprites move, then the batch is rebuilt
+    harness.Run("sprites", "frame_patch_build_10pct", scale, tenth, [&] {
+        manager.applyPatches(position10);
+        const SpriteManager::BuildResult batch = manager.buildFrameBatch();
+        DoNotOptimize(batch.ranges);
+    });
+
+    // Build plus the dirty-range copy SpriteGpuBuffer does, into host memory standing in for the mapped buffer
+    std::vector<engine::graphics::GPUSpritePacked> mirror(scale);
+    const uint64_t hundredth = std::max<uint64_t>(scale / 100, 1);
+    const std::vector<SpritePatch> position1 = MakePatches(handles, hundredth, false);
+    harness.Run("sprites", "frame_upload_1pct", scale, hundredth, [&] {
+        manager.applyPatches(position1);
+        const SpriteManager::BuildResult batch = manager.buildFrameBatch();
+        for (uint32_t i = 0; i < batch.rangeCount; ++i) {
+            manager.copyPacked(batch.ranges[i].first, batch.ranges[i].count, mirror.data() + batch.ranges[i].first);
+        }
+        DoNotOptimize(mirror.data());
+    });
+
+    // SpriteDesc to the 32-byte GPU format over contiguous descriptions, the cost of a full repack
+    std::vector<SpriteDesc> descs(scale);
+    for (uint64_t i = 0; i < scale; ++i) {
+        descs[i] = MakeSprite(i);
+    }
+    harness.Run("sprites", "pack", scale, scale, [&] {
+        engine::graphics::sprite_packer::pack(descs.data(), mirror.data(), descs.size());
+        DoNotOptimize(mirror.data());
+    });
+
+    // Non-bindless path: radix sort of every live sprite into texture runs (MakeSprite spreads 8 textures)
+    engine::graphics::SpriteBatcher batcher;
+    harness.Run("sprites", "batch_sort", scale, scale, [&] {
+        batcher.build(manager);
+        DoNotOptimize(batcher.getRuns().data());
+    });
+}
+
+} // namespace
+
+void RunSpriteSuites(Harness& harness) {
+    if (!harness.SuiteEnabled("sprites")) return;
+    for (uint64_t scale : harness.Scales()) {
+        BenchSpriteManager(harness, scale);
+    }
+}
+
+} // namespace bench
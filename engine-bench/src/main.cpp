@@ -0,0 +1,71 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "bench_harness.h"
+#include "utils/logger.h"
+
+namespace {
+
+void PrintUsage() {
+    std::cout <<
+        "Usage: engine-bench [options]\n"
+        "  --json <path>        write results as JSON\n"
+        "  --csv <path>         write results as CSV\n"
+        "  --filter <text>      only run cases whose suite/name contains <text>\n"
+        "  --max-scale <n>      skip scales above <n> (default 1000000)\n"
+        "  --repetitions <n>    timed repetitions per case (default 5)\n"
+        "  --quick              smoke run: scales up to 10000, 2 repetitions\n"
+        "  --render             also time offscreen frames (needs a Vulkan device, e.g. lavapipe)\n"
+        "  --frame-out <path>   with --render, save the last rendered frame as PPM\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Options options;
+    uint64_t maxScale = UINT64_MAX;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--json" && hasValue) {
+            options.jsonPath = argv[++i];
+        } else if (arg == "--csv" && hasValue) {
+            options.csvPath = argv[++i];
+        } else if (arg == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        } else if (arg == "--max-scale" && hasValue) {
+            maxScale = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--repetitions" && hasValue) {
+            options.repetitions = static_cast<uint32_t>(std::max(1ul, std::strtoul(argv[++i], nullptr, 10)));
+        } else if (arg == "--render") {
+            options.render = true;
+        } else if (arg == "--frame-out" && hasValue) {
+            options.framePath = argv[++i];
+        } else if (arg == "--quick") {
+            maxScale = 10000;
+            options.repetitions = 2;
+        } else {
+            PrintUsage();
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+    options.scales.erase(std::remove_if(options.scales.begin(), options.scales.end(),
+                                        [maxScale](uint64_t scale) { return scale > maxScale; }),
+                         options.scales.end());
+
+    // Keep engine logging out of the measurements
+    Logging::Logger::getInstance().setLogLevel(Logging::LogLevel::Warning);
+
+    bench::Harness harness(options);
+    bench::RunEntitySuites(harness);
+    bench::RunJobSuites(harness);
+    bench::RunSpriteSuites(harness);
+    bench::RunRenderSuites(harness);
+
+    bool ok = true;
+    if (!options.jsonPath.empty()) ok = harness.WriteJson(options.jsonPath) && ok;
+    if (!options.csvPath.empty()) ok = harness.WriteCsv(options.csvPath) && ok;
+    return ok ? 0 : 1;
+}
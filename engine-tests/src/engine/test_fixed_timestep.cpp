@@ -0,0 +1,81 @@
+#include "fixed_timestep.h"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+namespace engine {
+    namespace tests {
+
+static bool near(double a, double b) {
+    return std::fabs(a - b) < 1e-5;
+}
+
+void test_fixed_timestep_accumulates() {
+    FixedTimestep timestep(0.01, 5);
+
+    // Frames shorter than a step run no simulation
+    auto steps = timestep.advance(0.004);
+    assert(steps == 0 && "Short frame should not step");
+    steps = timestep.advance(0.004);
+    assert(steps == 0 && "Short frame should not step");
+    assert(near(timestep.getAlpha(), 0.8) && "Alpha should be the leftover fraction");
+
+    // The leftover carries over into the next frame
+    steps = timestep.advance(0.004);
+    assert(steps == 1 && "Accumulated time should produce a step");
+    assert(near(timestep.getAlpha(), 0.2) && "Alpha should wrap after a step");
+
+    steps = timestep.advance(0.025);
+    assert(steps == 2 && "Long frame should produce several steps");
+    assert(timestep.getTotalSteps() == 3 && "Step count should accumulate");
+    steps = timestep.advance(0.0);
+    assert(steps == 0 && "Zero frames should be ignored");
+    steps = timestep.advance(-1.0);
+    assert(steps == 0 && "Negative frames should be ignored");
+    (void)steps;
+}
+
+void test_fixed_timestep_clamps() {
+    FixedTimestep timestep(0.01, 4);
+
+    // A one second stall runs at most maxSteps and drops the rest
+    const auto steps = timestep.advance(1.0);
+    assert(steps == 4 && "Steps should be clamped");
+    (void)steps;
+    assert(near(timestep.getDroppedTime(), 0.96) && "Clamped time should be dropped");
+    assert(timestep.getAlpha() < 1.0f && "Alpha should stay below one after clamping");
+}
+
+void test_fixed_timestep_is_rate_independent() {
+    // After the same number of steps the simulation state is identical at 30, 60 and 144 fps
+    const double rates[] = { 30.0, 60.0, 144.0 };
+    const uint64_t compareSteps = 200;
+    double positions[3];
+    for (int r = 0; r < 3; ++r) {
+        FixedTimestep timestep(1.0 / 120.0, 8);
+        double position = 0.0;
+        double velocity = 0.0;
+        uint64_t steps = 0;
+        while (steps < compareSteps) {
+            timestep.update(1.0 / rates[r], [&](float dt) {
+                if (steps++ >= compareSteps) return;
+                velocity += 9.8 * dt;
+                position += velocity * dt;
+            });
+        }
+        positions[r] = position;
+    }
+    assert(positions[0] == positions[1] && positions[1] == positions[2] && "Simulation should not depend on frame rate");
+}
+
+}
+} // namespace engine::tests
+
+int main() {
+    std::cout << "=== Testing FixedTimestep ===" << std::endl;
+    engine::tests::test_fixed_timestep_accumulates();
+    engine::tests::test_fixed_timestep_clamps();
+    engine::tests::test_fixed_timestep_is_rate_independent();
+    std::cout << "FixedTimestep test completed successfully." << std::endl;
+    return 0;
+}
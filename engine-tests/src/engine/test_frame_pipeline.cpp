@@ -0,0 +1,127 @@
+#include "frame_pipeline.h"
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine {
+    namespace tests {
+
+struct TestRenderState {
+    uint64_t simulatedFrame = 0;
+    std::vector<float> positions;
+};
+
+// Lets simulation and rendering of one frame wait for each other, so overlap is checked
+// by structure instead of timing: a side that is not concurrent with the other times out
+struct Rendezvous {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool active = false;
+    uint64_t simulations = 0;
+    uint64_t renders = 0;
+    int missed = 0;
+
+    void arrive(uint64_t& mine, const uint64_t& other) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!active) return;
+        ++mine;
+        cv.notify_all();
+        if (!cv.wait_for(lock, std::chrono::seconds(10), [&] { return other >= mine; })) {
+            ++missed;
+        }
+    }
+};
+
+// Runs `frames` frames with fixed simulation/render costs and returns the elapsed time in ms
+static double run_frames(FramePipeline<TestRenderState>& pipeline, int frames) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i) {
+        pipeline.frame(1.0f / 60.0f);
+    }
+    pipeline.wait();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void test_frame_pipeline() {
+    JobSystem::JobScheduler scheduler(2);
+    FramePipeline<TestRenderState> pipeline(scheduler);
+
+    uint64_t simulated = 0;
+    std::vector<uint64_t> rendered;
+    Rendezvous rendezvous;
+    pipeline.setSimulate([&simulated, &rendezvous](float, TestRenderState& next) {
+        rendezvous.arrive(rendezvous.simulations, rendezvous.renders);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        next.simulatedFrame = ++simulated;
+        next.positions.assign(64, float(simulated));
+    });
+    pipeline.setRender([&rendered, &rendezvous](const TestRenderState& current) {
+        rendezvous.arrive(rendezvous.renders, rendezvous.simulations);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        assert(current.positions.size() == 64 && current.positions[0] == float(current.simulatedFrame) && "Render state should be complete");
+        rendered.push_back(current.simulatedFrame);
+    });
+
+    const int frames = 20;
+    double serial = run_frames(pipeline, frames);
+    assert(rendered.back() == simulated && "Serial mode renders the frame it just simulated");
+
+    pipeline.setPipelined(true);
+    assert(pipeline.isPipelined() && "Two worker threads should allow pipelining");
+    rendered.clear();
+    uint64_t before = simulated;
+    // The priming frame runs serially; every frame after it must meet at the rendezvous
+    double pipelined = run_frames(pipeline, 1);
+    {
+        std::lock_guard<std::mutex> lock(rendezvous.mutex);
+        rendezvous.active = true;
+    }
+    pipelined += run_frames(pipeline, frames - 1);
+
+    // Every frame renders a complete state, one frame behind simulation. The first
+    // pipelined frame is a serial priming frame, so its state is shown twice.
+    assert(rendered.size() == size_t(frames) && "Every frame should render");
+    assert(rendered[0] == rendered[1] && "Priming frame state is rendered again by the first overlapped frame");
+    for (size_t i = 2; i < rendered.size(); ++i) {
+        assert(rendered[i] == rendered[i - 1] + 1 && "Rendered frames should be consecutive");
+    }
+    assert(rendered.back() == simulated - 1 && "Rendering should trail simulation by one frame");
+    assert(simulated - before == uint64_t(frames) && "One simulation per frame");
+
+    assert(rendezvous.missed == 0 && rendezvous.simulations == uint64_t(frames - 1) && "Simulation and rendering should run concurrently");
+    std::cout << "  serial " << serial << " ms, pipelined " << pipelined << " ms" << std::endl;
+
+    scheduler.Update(0.0f);
+}
+
+void test_frame_pipeline_single_thread_fallback() {
+    JobSystem::JobScheduler scheduler(1);
+    FramePipeline<TestRenderState> pipeline(scheduler);
+    pipeline.setPipelined(true);
+    assert(!pipeline.isPipelined() && "One worker thread should fall back to serial frames");
+
+    int frames = 0;
+    pipeline.setSimulate([&frames](float, TestRenderState& next) { next.simulatedFrame = ++frames; });
+    pipeline.setRender([&frames](const TestRenderState& current) {
+        assert(current.simulatedFrame == uint64_t(frames) && "Serial frames render the latest simulation");
+    });
+    for (int i = 0; i < 5; ++i) {
+        pipeline.frame(0.016f);
+    }
+    assert(pipeline.getFrameCount() == 5 && "Frame count should advance");
+}
+
+}
+} // namespace engine::tests
+
+int main() {
+    std::cout << "=== Testing FramePipeline ===" << std::endl;
+    engine::tests::test_frame_pipeline();
+    engine::tests::test_frame_pipeline_single_thread_fallback();
+    std::cout << "FramePipeline test completed successfully." << std::endl;
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include "sprite_batcher.h"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+namespace engine {
+    namespace tests {
+
+using graphics::SpriteBatcher;
+using graphics::SpriteDesc;
+using graphics::SpriteHandle;
+using graphics::SpriteManager;
+
+static SpriteDesc makeSprite(uint32_t textureIndex, float depth) {
+    SpriteDesc desc{};
+    desc.scaleX = 1.0f;
+    desc.scaleY = 1.0f;
+    desc.textureIndex = textureIndex;
+    desc.depth = depth;
+    return desc;
+}
+
+void test_sprite_batcher_sort_key_orders_depth() {
+    const float depths[] = { -2.5f, -1.0f, -0.0f, 0.0f, 0.25f, 1.0f, 1000.0f };
+    for (size_t i = 1; i < sizeof(depths) / sizeof(depths[0]); ++i) {
+        assert(SpriteBatcher::sortKey(0, depths[i - 1]) <= SpriteBatcher::sortKey(0, depths[i]) && "Keys should follow float depth order");
+    }
+    assert(SpriteBatcher::sortKey(0, 1000.0f) < SpriteBatcher::sortKey(1, -1000.0f) && "Texture should take precedence over depth");
+}
+
+void test_sprite_batcher_groups_by_texture() {
+    SpriteManager manager;
+    const uint32_t count = SpriteManager::CHUNK_SIZE + 300;
+    std::vector<SpriteHandle> handles;
+    for (uint32_t i = 0; i < count; ++i) {
+        // Textures interleaved and depths descending, so the sort has to move everything
+        handles.push_back(manager.createSprite(makeSprite((i * 7) % 5 + 3, static_cast<float>(count - i) * 0.5f - 100.0f)));
+    }
+    manager.destroySprite(handles[10]);
+    manager.destroySprite(handles[count - 1]);
+
+    SpriteBatcher batcher;
+    batcher.build(manager);
+    const std::vector<uint32_t>& order = batcher.getOrder();
+    assert(order.size() == count - 2 && "Only live sprites should be ordered");
+    assert(batcher.getRuns().size() == 5 && "One run per distinct texture");
+    assert(batcher.getVersion() == 1 && "Each build should bump the version");
+
+    uint32_t expectedFirst = 0;
+    uint32_t previousTexture = 0;
+    for (const SpriteBatcher::TextureRun& run : batcher.getRuns()) {
+        assert(run.first == expectedFirst && run.count > 0 && "Runs should tile the order");
+        assert(run.textureIndex > previousTexture && "Runs should be in texture order");
+        previousTexture = run.textureIndex;
+        float previousDepth = -1e30f;
+        for (uint32_t i = run.first; i < run.first + run.count; ++i) {
+            SpriteDesc desc{};
+            const uint32_t slot = order[i];
+            assert(slot != 10 && slot != count - 1 && "Destroyed sprites should be skipped");
+            manager.getSprite(handles[slot], desc);
+            assert(desc.textureIndex == run.textureIndex && "Run should hold a single texture");
+            assert(desc.depth >= previousDepth && "Depth should ascend within a run");
+            previousDepth = desc.depth;
+        }
+        (void)previousDepth;
+        expectedFirst += run.count;
+    }
+    assert(expectedFirst == order.size() && "Runs should cover every live sprite");
+    (void)previousTexture;
+}
+
+void test_sprite_batcher_empty_and_single_texture() {
+    SpriteManager manager;
+    SpriteBatcher batcher;
+    batcher.build(manager);
+    assert(batcher.getOrder().empty() && batcher.getRuns().empty() && "Nothing to draw without sprites");
+
+    for (uint32_t i = 0; i < 100; ++i) {
+        manager.createSprite(makeSprite(0, static_cast<float>(i % 10)));
+    }
+    batcher.build(manager);
+    assert(batcher.getRuns().size() == 1 && batcher.getRuns()[0].count == 100 && "Same texture should be one draw");
+}
+
+void test_sprite_batcher_resort_only_on_key_change() {
+    SpriteManager manager;
+    const SpriteHandle handle = manager.createSprite(makeSprite(1, 0.0f));
+    bool resorted = manager.buildFrameBatch().sortKeysChanged;
+    assert(resorted && "Creating a sprite should change the order");
+
+    graphics::SpritePatch patch{};
+    patch.handle = handle;
+    patch.kind = graphics::SpritePatch::Kind::Position;
+    patch.data.vec2v = glm::vec2(3.0f, 4.0f);
+    manager.applyPatch(patch);
+    resorted = manager.buildFrameBatch().sortKeysChanged;
+    assert(!resorted && "Moving a sprite should keep the order");
+
+    patch.kind = graphics::SpritePatch::Kind::TextureIndex;
+    patch.data.u32v = 2;
+    manager.applyPatch(patch);
+    resorted = manager.buildFrameBatch().sortKeysChanged;
+    assert(resorted && "Changing the texture should change the order");
+    (void)resorted;
+}
+
+}
+} // namespace engine::tests
+
+int main() {
+    std::cout << "=== Testing SpriteBatcher ===" << std::endl;
+    engine::tests::test_sprite_batcher_sort_key_orders_depth();
+    engine::tests::test_sprite_batcher_groups_by_texture();
+    engine::tests::test_sprite_batcher_empty_and_single_texture();
+    engine::tests::test_sprite_batcher_resort_only_on_key_change();
+    std::cout << "SpriteBatcher test completed successfully." << std::endl;
+    return 0;
+}
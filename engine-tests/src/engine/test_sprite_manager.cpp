@@ -0,0 +1,245 @@
+#include "sprite_manager.h"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+namespace engine {
+    namespace tests {
+
+using graphics::SpriteDesc;
+using graphics::SpriteHandle;
+using graphics::SpriteManager;
+using graphics::SpritePatch;
+
+static SpriteDesc makeSprite(uint32_t i) {
+    SpriteDesc desc{};
+    desc.posX = static_cast<float>(i);
+    desc.posY = static_cast<float>(i) * 2.0f;
+    desc.scaleX = 1.0f;
+    desc.scaleY = 1.0f;
+    desc.textureIndex = i % 4;
+    return desc;
+}
+
+void test_sprite_manager_grows_on_demand() {
+    SpriteManager manager;
+    assert(manager.capacity() == 0 && "No storage should exist before the first sprite");
+
+    manager.createSprite(makeSprite(0));
+    assert(manager.capacity() == SpriteManager::CHUNK_SIZE && "The first sprite should allocate one chunk");
+
+    SpriteManager reserved(SpriteManager::CHUNK_SIZE + 1);
+    assert(reserved.capacity() == 2 * SpriteManager::CHUNK_SIZE && "Reserve should round up to whole chunks");
+    assert(reserved.liveCount() == 0 && "Reserving should not create sprites");
+}
+
+void test_sprite_manager_handles_survive_growth() {
+    SpriteManager manager;
+    const uint32_t count = SpriteManager::CHUNK_SIZE * 3 + 17;
+    std::vector<SpriteHandle> handles;
+    for (uint32_t i = 0; i < count; ++i) {
+        handles.push_back(manager.createSprite(makeSprite(i)));
+    }
+    assert(manager.liveCount() == count && "All sprites should be alive");
+    assert(manager.capacity() == 4 * SpriteManager::CHUNK_SIZE && "Capacity should track the live sprites");
+
+    // Handles taken before later chunks were added still resolve to their own sprite
+    for (uint32_t i = 0; i < count; ++i) {
+        SpriteDesc desc{};
+        const bool found = manager.getSprite(handles[i], desc);
+        assert(found && "Handle should stay valid across growth");
+        assert(desc.posX == static_cast<float>(i) && desc.posY == static_cast<float>(i) * 2.0f && "Sprite data should survive growth");
+        (void)found;
+    }
+
+    SpritePatch patch{};
+    patch.handle = handles[5];
+    patch.kind = SpritePatch::Kind::Position;
+    patch.data.vec2v = glm::vec2(-1.0f, -2.0f);
+    const bool patched = manager.applyPatch(patch);
+    assert(patched && "Patching an early sprite should work after growth");
+    (void)patched;
+    const SpriteManager::BuildResult build = manager.buildFrameBatch();
+    assert(build.spriteCount == count && "Every created sprite should be dirty once");
+    assert(build.rangeCount == 1 && build.ranges[0].first == 0 && build.ranges[0].count == count && "Consecutive slots should form one range");
+    (void)build;
+}
+
+void test_sprite_manager_reuses_destroyed_slots() {
+    SpriteManager manager;
+    const SpriteHandle first = manager.createSprite(makeSprite(1));
+    const SpriteHandle second = manager.createSprite(makeSprite(2));
+    manager.destroySprite(first);
+    assert(!manager.isValid(first) && "Destroyed handle should be invalid");
+    assert(manager.isValid(second) && "Other handles should be unaffected");
+
+    const SpriteHandle reused = manager.createSprite(makeSprite(3));
+    assert(reused.id == first.id && reused.version != first.version && "Destroyed slot should be reused with a new version");
+    (void)second;
+    (void)reused;
+    assert(!manager.isValid(first) && "Stale handle should not alias the new sprite");
+    assert(manager.slotCount() == 2 && manager.liveCount() == 2 && "Reuse should not hand out a new slot");
+
+    SpriteManager bounded(0, 2);
+    bounded.createSprite(makeSprite(0));
+    bounded.createSprite(makeSprite(1));
+    assert(bounded.capacity() == SpriteManager::CHUNK_SIZE && "Bounded manager still allocates whole chunks");
+}
+
+void test_sprite_manager_rejects_past_max() {
+    const uint32_t maxSprites = 3;
+    SpriteManager manager(0, maxSprites);
+    std::vector<SpriteHandle> handles;
+    for (uint32_t i = 0; i < maxSprites; ++i) {
+        handles.push_back(manager.createSprite(makeSprite(i)));
+        assert(manager.isValid(handles.back()) && "Sprites up to the limit should be created");
+    }
+    SpriteHandle overflow = manager.createSprite(makeSprite(maxSprites));
+    assert(overflow.id == graphics::InvalidSpriteHandle.id && overflow.version == graphics::InvalidSpriteHandle.version && "Creating past the limit should fail");
+    assert(!manager.isValid(overflow) && "The failed handle should not be valid");
+    assert(manager.slotCount() == maxSprites && manager.liveCount() == maxSprites && "A failed create should not take a slot");
+
+    // The failed handle can be passed back like any stale one
+    manager.destroySprite(overflow);
+    SpriteDesc out{};
+    SpritePatch patch{};
+    patch.handle = overflow;
+    patch.kind = SpritePatch::Kind::Position;
+    const bool set = manager.setSprite(overflow, makeSprite(0));
+    const bool patched = manager.applyPatch(patch);
+    const bool read = manager.getSprite(overflow, out);
+    manager.applyPatches(&patch, 1);
+    assert(!set && !patched && !read && manager.liveCount() == maxSprites && "The failed handle should be rejected");
+    (void)set;
+    (void)patched;
+    (void)read;
+
+    // Destroying a sprite frees a slot again
+    manager.destroySprite(handles[1]);
+    overflow = manager.createSprite(makeSprite(maxSprites));
+    assert(overflow.id == handles[1].id && "A freed slot should be reused at the limit");
+    (void)overflow;
+}
+
+void test_sprite_manager_coalesces_dirty_ranges() {
+    SpriteManager manager;
+    std::vector<SpriteHandle> handles;
+    for (uint32_t i = 0; i < 10000; ++i) {
+        handles.push_back(manager.createSprite(makeSprite(i)));
+    }
+    manager.buildFrameBatch();
+    const uint32_t cleanRanges = manager.buildFrameBatch().rangeCount;
+    assert(cleanRanges == 0 && "Nothing should be dirty after a build");
+    (void)cleanRanges;
+
+    // Out of order patches, a duplicate, a short gap that is merged and a long one that is not
+    const uint32_t patched[] = { 5000, 100, 101, 100, 103, 4095, 4096 };
+    for (uint32_t id : patched) {
+        SpritePatch patch{};
+        patch.handle = handles[id];
+        patch.kind = SpritePatch::Kind::Color;
+        patch.data.u32v = 0xFF0000FFu;
+        const bool applied = manager.applyPatch(patch);
+        assert(applied && "Patch should apply");
+        (void)applied;
+    }
+    SpriteManager::BuildResult build = manager.buildFrameBatch();
+    assert(build.spriteCount == 6 && "Each dirty sprite should be packed once");
+    assert(build.rangeCount == 3 && "Nearby dirty slots should share a range");
+    assert(build.ranges[0].first == 100 && build.ranges[0].count == 4 && "Gap within the merge distance should be absorbed");
+    assert(build.ranges[1].first == 4095 && build.ranges[1].count == 2 && "Ranges may span chunks");
+    assert(build.ranges[2].first == 5000 && build.ranges[2].count == 1 && "Distant slot should get its own range");
+
+    graphics::GPUSpritePacked packed[2];
+    manager.copyPacked(4095, 2, packed);
+    assert(packed[0].colorRGBA == 0xFF0000FFu && packed[1].posX == 4096.0f && "Packed mirror should be copied across chunks");
+
+    // Destroying a sprite clears its packed slot on the next build
+    manager.destroySprite(handles[7]);
+    build = manager.buildFrameBatch();
+    assert(build.rangeCount == 1 && build.ranges[0].first == 7 && "Destroyed slot should be uploaded");
+    manager.copyPacked(7, 1, packed);
+    assert(packed[0].scaleX == 0 && packed[0].scaleY == 0 && "Destroyed slot should be packed as zero");
+}
+
+void test_sprite_manager_batched_patches_match_single() {
+    SpriteManager batched;
+    SpriteManager single;
+    std::vector<SpriteHandle> handles;
+    for (uint32_t i = 0; i < 64; ++i) {
+        handles.push_back(batched.createSprite(makeSprite(i)));
+        single.createSprite(makeSprite(i));
+    }
+    batched.destroySprite(handles[5]);
+    single.destroySprite(handles[5]);
+    batched.buildFrameBatch();
+    single.buildFrameBatch();
+
+    // Mixed kinds, repeated patches to one sprite, a stale handle and an unsupported kind
+    std::vector<SpritePatch> patches;
+    for (uint32_t i = 0; i < 200; ++i) {
+        SpritePatch patch{};
+        patch.handle = handles[(i * 7) % handles.size()];
+        switch (i % 5) {
+            case 0: patch.kind = SpritePatch::Kind::Position; patch.data.vec2v = glm::vec2(static_cast<float>(i), 1.0f); break;
+            case 1: patch.kind = SpritePatch::Kind::Rotation; patch.data.f32v = static_cast<float>(i) * 0.01f; break;
+            case 2: patch.kind = SpritePatch::Kind::Color; patch.data.u32v = i; break;
+            case 3: patch.kind = SpritePatch::Kind::Depth; patch.data.f32v = static_cast<float>(i % 3) * 0.5f; break;
+            default: patch.kind = SpritePatch::Kind::Pivot; break;
+        }
+        patches.push_back(patch);
+    }
+
+    batched.applyPatches(patches);
+    for (const SpritePatch& patch : patches) {
+        single.applyPatch(patch);
+    }
+    const SpriteManager::BuildResult batchedBuild = batched.buildFrameBatch();
+    const SpriteManager::BuildResult singleBuild = single.buildFrameBatch();
+    assert(batchedBuild.spriteCount == singleBuild.spriteCount && "Each patched sprite should be dirty once");
+    assert(batchedBuild.sortKeysChanged && "Depth patches should change the sort keys");
+    (void)batchedBuild;
+    (void)singleBuild;
+
+    for (uint32_t i = 0; i < handles.size(); ++i) {
+        SpriteDesc a{};
+        SpriteDesc b{};
+        const bool batchedValid = batched.getSprite(handles[i], a);
+        const bool singleValid = single.getSprite(handles[i], b);
+        assert(batchedValid == singleValid && "Validity should match");
+        assert(a.posX == b.posX && a.posY == b.posY && a.rotation == b.rotation && a.colorRGBA == b.colorRGBA && a.depth == b.depth
+               && "Batched patches should end in the same state as applying them one by one");
+        (void)batchedValid;
+        (void)singleValid;
+    }
+
+    // A single-kind batch is applied in place; the last patch to a sprite still wins
+    std::vector<SpritePatch> moves(3);
+    for (uint32_t i = 0; i < moves.size(); ++i) {
+        moves[i].handle = handles[1];
+        moves[i].kind = SpritePatch::Kind::Position;
+        moves[i].data.vec2v = glm::vec2(static_cast<float>(i), 0.0f);
+    }
+    batched.applyPatches(moves);
+    SpriteDesc moved{};
+    batched.getSprite(handles[1], moved);
+    assert(moved.posX == 2.0f && "Later patches of one kind should override earlier ones");
+    const SpriteManager::BuildResult movedBuild = batched.buildFrameBatch();
+    assert(movedBuild.spriteCount == 1 && !movedBuild.sortKeysChanged && "One moved sprite, order unchanged");
+    (void)movedBuild;
+}
+
+}
+} // namespace engine::tests
+
+int main() {
+    std::cout << "=== Testing SpriteManager ===" << std::endl;
+    engine::tests::test_sprite_manager_grows_on_demand();
+    engine::tests::test_sprite_manager_handles_survive_growth();
+    engine::tests::test_sprite_manager_reuses_destroyed_slots();
+    engine::tests::test_sprite_manager_rejects_past_max();
+    engine::tests::test_sprite_manager_coalesces_dirty_ranges();
+    engine::tests::test_sprite_manager_batched_patches_match_single();
+    std::cout << "SpriteManager test completed successfully." << std::endl;
+    return 0;
+}
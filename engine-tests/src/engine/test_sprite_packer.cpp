@@ -0,0 +1,163 @@
+#include "sprite_packer.h"
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+namespace engine {
+    namespace tests {
+
+using graphics::GPUSpritePacked;
+using graphics::SpriteDesc;
+namespace sprite_packer = graphics::sprite_packer;
+
+static float fromBits(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+void test_sprite_packer_half_conversion() {
+    assert(sprite_packer::floatToHalf(0.0f) == 0x0000 && "Zero");
+    assert(sprite_packer::floatToHalf(-0.0f) == 0x8000 && "Negative zero keeps its sign");
+    assert(sprite_packer::floatToHalf(1.0f) == 0x3C00 && "One");
+    assert(sprite_packer::floatToHalf(-2.0f) == 0xC000 && "Minus two");
+    assert(sprite_packer::floatToHalf(65504.0f) == 0x7BFF && "Largest half");
+    assert(sprite_packer::floatToHalf(65520.0f) == 0x7C00 && "Halfway past the largest half rounds to infinity");
+    assert(sprite_packer::floatToHalf(std::numeric_limits<float>::infinity()) == 0x7C00 && "Infinity");
+    assert(sprite_packer::floatToHalf(std::numeric_limits<float>::quiet_NaN()) == 0x7E00 && "NaN stays NaN");
+    assert(sprite_packer::floatToHalf(5.9604644775390625e-8f) == 0x0001 && "Smallest subnormal half");
+    // 1 + 2^-11 is halfway between 1 and the next half: ties go to the even mantissa
+    assert(sprite_packer::floatToHalf(1.0f + 0.00048828125f) == 0x3C00 && "Tie rounds to even (down)");
+    assert(sprite_packer::floatToHalf(1.0f + 3.0f * 0.00048828125f) == 0x3C02 && "Tie rounds to even (up)");
+
+    // Every half survives a round trip through float
+    for (uint32_t half = 0; half < 0x10000; ++half) {
+        const float value = sprite_packer::halfToFloat(static_cast<uint16_t>(half));
+        if (std::isnan(value)) continue;
+        assert(sprite_packer::floatToHalf(value) == half && "Half to float to half should be exact");
+    }
+}
+
+void test_sprite_packer_matches_scalar_reference() {
+    // Edge cases first, then a sweep of float bit patterns across every exponent
+    std::vector<float> values = { 0.0f, -0.0f, 1.0f, 0.5f, 65504.0f, 65519.0f, 65520.0f, 1e-8f, -3e-5f, 6.1e-5f,
+                                  std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() };
+    for (uint32_t bits = 0; bits < 0xFF000000u; bits += 0x000F4243u) {
+        const float value = fromBits(bits);
+        if (!std::isnan(value)) values.push_back(value);
+    }
+    while (values.size() % 6 != 0) values.push_back(0.0f);
+
+    std::vector<SpriteDesc> sprites(values.size() / 6);
+    for (size_t i = 0; i < sprites.size(); ++i) {
+        SpriteDesc& desc = sprites[i];
+        const float* v = &values[i * 6];
+        desc.scaleX = v[0]; desc.scaleY = v[1];
+        desc.uvMinX = v[2]; desc.uvMinY = v[3];
+        desc.uvMaxX = v[4]; desc.uvMaxY = v[5];
+        desc.textureIndex = static_cast<uint32_t>(i & 0xFFF);
+    }
+    std::vector<GPUSpritePacked> packed(sprites.size());
+    sprite_packer::pack(sprites.data(), packed.data(), sprites.size());
+
+    for (size_t i = 0; i < sprites.size(); ++i) {
+        const SpriteDesc& desc = sprites[i];
+        const GPUSpritePacked& p = packed[i];
+        assert(p.scaleX == sprite_packer::floatToHalf(desc.scaleX) && p.scaleY == sprite_packer::floatToHalf(desc.scaleY) && "Vector and scalar scale should match");
+        assert(p.uvMinX == sprite_packer::floatToHalf(desc.uvMinX) && p.uvMinY == sprite_packer::floatToHalf(desc.uvMinY) && "Vector and scalar uvMin should match");
+        assert(p.uvMaxX == sprite_packer::floatToHalf(desc.uvMaxX) && p.uvMaxY == sprite_packer::floatToHalf(desc.uvMaxY) && "Vector and scalar uvMax should match");
+        assert((p.depthTexture & 0xFFFF) == desc.textureIndex && "Texture index should be kept");
+        (void)desc;
+        (void)p;
+    }
+}
+
+void test_sprite_packer_quantizes_fields() {
+    SpriteDesc desc{};
+    desc.posX = 1234.5678f;
+    desc.posY = -98765.4321f;
+    desc.scaleX = 32.0f;
+    desc.scaleY = 0.75f;
+    desc.uvMaxX = 0.5f;
+    desc.uvMaxY = 1.0f;
+    desc.rotation = 1.0f;
+    desc.depth = 0.25f;
+    desc.textureIndex = 4095;
+    desc.colorRGBA = 0x11223344u;
+
+    const GPUSpritePacked packed = sprite_packer::pack(desc);
+    assert(packed.posX == desc.posX && packed.posY == desc.posY && "Position should keep full precision");
+    assert(sprite_packer::halfToFloat(packed.scaleX) == 32.0f && sprite_packer::halfToFloat(packed.scaleY) == 0.75f && "Exact halves should round trip");
+    assert(packed.uvMinX == 0 && sprite_packer::halfToFloat(packed.uvMaxX) == 0.5f && "UVs should be halves");
+    assert(std::fabs(sprite_packer::dequantizeRotation(packed.rotation) - 1.0f) < 1e-4f && "Rotation should be within one step");
+    assert(packed.depthTexture >> 16 == 16384 && (packed.depthTexture & 0xFFFF) == 4095 && "Depth and texture should share a word");
+    assert(packed.colorRGBA == desc.colorRGBA && packed.reserved == 0 && "Color should be copied");
+    (void)packed;
+
+    // Whole turns wrap; negative angles land on the same step as their positive equivalent
+    assert(sprite_packer::quantizeRotation(-1.0f) == sprite_packer::quantizeRotation(6.28318530717958647692f - 1.0f) && "Rotation should wrap");
+    assert(sprite_packer::packDepthTexture(-5.0f, 0) == 0 && sprite_packer::packDepthTexture(2.0f, 0) == 0xFFFF0000u && "Depth should clamp to [0, 1]");
+    assert(sprite_packer::packDepthTexture(0.0f, sprite_packer::MAX_TEXTURE_INDEX + 1) == sprite_packer::DEFAULT_TEXTURE_INDEX &&
+           "Out of range texture indices should fall back to the default texture");
+
+    // Values whose float to integer conversion would be undefined still pack to something defined
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    assert(sprite_packer::quantizeRotation(nan) == 0 && sprite_packer::quantizeRotation(-std::numeric_limits<float>::infinity()) == 0 &&
+           "Non-finite rotations should pack as 0");
+    assert(sprite_packer::quantizeRotation(1e30f) == sprite_packer::quantizeRotation(std::remainder(1e30f, 6.28318530717958647692f)) &&
+           "Huge rotations should drop their whole turns");
+    assert(sprite_packer::packDepthTexture(nan, 7) == 7 && "NaN depth should pack as 0");
+    (void)nan;
+}
+
+void test_sprite_packer_soa_matches_aos() {
+    constexpr size_t count = 37;
+    std::vector<SpriteDesc> descs(count);
+    std::vector<glm::vec2> position(count), scale(count), uvMin(count), uvMax(count);
+    std::vector<float> rotation(count), depth(count);
+    std::vector<uint32_t> textureIndex(count), colorRGBA(count);
+    for (size_t i = 0; i < count; ++i) {
+        const float f = static_cast<float>(i);
+        descs[i] = SpriteDesc{ f, -f, 1.0f + f * 0.1f, 2.0f, 0.0f, f / count, 1.0f, 0.5f, f * 0.3f, f / count,
+                               static_cast<uint32_t>(i % 5), static_cast<uint32_t>(i * 0x01010101u) };
+        position[i] = glm::vec2(descs[i].posX, descs[i].posY);
+        scale[i] = glm::vec2(descs[i].scaleX, descs[i].scaleY);
+        uvMin[i] = glm::vec2(descs[i].uvMinX, descs[i].uvMinY);
+        uvMax[i] = glm::vec2(descs[i].uvMaxX, descs[i].uvMaxY);
+        rotation[i] = descs[i].rotation;
+        depth[i] = descs[i].depth;
+        textureIndex[i] = descs[i].textureIndex;
+        colorRGBA[i] = descs[i].colorRGBA;
+    }
+    const graphics::SpriteFieldsView fields{ position.data(), scale.data(), uvMin.data(), uvMax.data(),
+                                             rotation.data(), depth.data(), textureIndex.data(), colorRGBA.data() };
+
+    std::vector<GPUSpritePacked> fromSoA(count - 3);
+    sprite_packer::pack(fields, 3, fromSoA.size(), fromSoA.data());
+    for (size_t i = 0; i < count; ++i) {
+        const GPUSpritePacked aos = sprite_packer::pack(descs[i]);
+        const GPUSpritePacked soa = sprite_packer::pack(fields, i);
+        assert(std::memcmp(&aos, &soa, sizeof(aos)) == 0 && "Field arrays should pack like SpriteDesc");
+        if (i >= 3) {
+            assert(std::memcmp(&aos, &fromSoA[i - 3], sizeof(aos)) == 0 && "Range packing should start at `first`");
+        }
+        (void)aos;
+        (void)soa;
+    }
+}
+
+}
+} // namespace engine::tests
+
+int main() {
+    std::cout << "=== Testing SpritePacker (" << engine::graphics::sprite_packer::simdPath() << ") ===" << std::endl;
+    engine::tests::test_sprite_packer_half_conversion();
+    engine::tests::test_sprite_packer_matches_scalar_reference();
+    engine::tests::test_sprite_packer_quantizes_fields();
+    engine::tests::test_sprite_packer_soa_matches_aos();
+    std::cout << "SpritePacker test completed successfully." << std::endl;
+    return 0;
+}
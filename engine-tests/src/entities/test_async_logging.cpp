@@ -0,0 +1,203 @@
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "utils/logger.h"
+#include "utils/AsyncLogBackend.h"
+
+namespace entities {
+namespace tests {
+
+using namespace Logging;
+
+// Records everything written to it
+class CaptureSink : public LogSink {
+public:
+    void write(LogLevel, std::string_view message) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_messages.emplace_back(message);
+    }
+
+    void flush() override { ++m_flushes; }
+
+    std::vector<std::string> messages() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_messages;
+    }
+
+    std::atomic<int> m_flushes{ 0 };
+
+private:
+    std::mutex m_mutex;
+    std::vector<std::string> m_messages;
+};
+
+void test_async_backend_ordering() {
+    std::vector<uint64_t> sequences;
+    std::atomic<size_t> batches{ 0 };
+    AsyncLogConfig config;
+    config.ringCapacity = 64;
+    config.overflowPolicy = LogOverflowPolicy::Block;
+    AsyncLogBackend backend(config, [&](const std::vector<LogRecord>& records, uint64_t) {
+        for (const LogRecord& record : records) sequences.push_back(record.sequence);
+        ++batches;
+    });
+
+    const int threads = 4;
+    const int per_thread = 2000;
+    std::vector<std::thread> producers;
+    for (int t = 0; t < threads; ++t) {
+        producers.emplace_back([&backend] {
+            for (int i = 0; i < per_thread; ++i) {
+                const bool accepted = backend.push(LogLevel::Info, "message");
+                assert(accepted && "Block policy never drops");
+                (void)accepted;
+            }
+        });
+    }
+    for (auto& producer : producers) producer.join();
+    backend.flush();
+
+    assert(sequences.size() == static_cast<size_t>(threads * per_thread) && "Every message should be written");
+    assert(backend.droppedCount() == 0 && "Nothing should be dropped");
+    assert(batches < sequences.size() && "Records should be written in batches");
+    std::vector<uint64_t> sorted = sequences;
+    std::sort(sorted.begin(), sorted.end());
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        assert(sorted[i] == i && "Each sequence number should be written exactly once");
+    }
+}
+
+void test_async_backend_drop_policy() {
+    std::mutex gate_mutex;
+    std::condition_variable gate_cv;
+    bool writer_entered = false;
+    bool gate_open = false;
+    size_t written = 0;
+    uint64_t reported_dropped = 0;
+
+    AsyncLogConfig config;
+    config.ringCapacity = 4;
+    config.overflowPolicy = LogOverflowPolicy::Drop;
+    AsyncLogBackend backend(config, [&](const std::vector<LogRecord>& records, uint64_t dropped) {
+        std::unique_lock<std::mutex> lock(gate_mutex);
+        writer_entered = true;
+        gate_cv.notify_all();
+        gate_cv.wait(lock, [&] { return gate_open; });
+        written += records.size();
+        reported_dropped += dropped;
+    });
+
+    // Stall the background thread inside the write callback
+    backend.push(LogLevel::Info, "first");
+    {
+        std::unique_lock<std::mutex> lock(gate_mutex);
+        gate_cv.wait(lock, [&] { return writer_entered; });
+    }
+
+    // Ring holds 4 records; the rest overflow
+    int accepted = 0;
+    for (int i = 0; i < 14; ++i) {
+        if (backend.push(LogLevel::Info, "overflow")) ++accepted;
+    }
+    assert(accepted == 4 && "Only the ring capacity should be accepted");
+    assert(backend.droppedCount() == 10 && "Overflowing messages should be counted");
+
+    {
+        std::lock_guard<std::mutex> lock(gate_mutex);
+        gate_open = true;
+    }
+    gate_cv.notify_all();
+    backend.flush();
+
+    assert(written == 5 && "Accepted messages should all be written");
+    assert(reported_dropped == 10 && "The writer should be told how many were dropped");
+}
+
+void test_async_backend_block_from_writer() {
+    // A sink that logs runs on the background thread, the only thread that drains its ring
+    AsyncLogConfig config;
+    config.ringCapacity = 4;
+    config.overflowPolicy = LogOverflowPolicy::Block;
+    AsyncLogBackend* self = nullptr;
+    std::atomic<bool> logged{ false };
+    int nested_accepted = 0;
+    AsyncLogBackend backend(config, [&](const std::vector<LogRecord>&, uint64_t) {
+        if (logged.exchange(true)) return;
+        for (int i = 0; i < 10; ++i) {
+            if (self->push(LogLevel::Info, "from writer")) ++nested_accepted;
+        }
+    });
+    self = &backend;
+
+    backend.push(LogLevel::Info, "first");
+    backend.flush();
+    assert(nested_accepted == 4 && "The writer thread should drop instead of waiting on itself");
+    assert(backend.droppedCount() == 0 && "Drops should be reported to the writer");
+}
+
+void test_async_logger() {
+    Logger& logger = Logger::getInstance();
+    auto sink = std::make_shared<CaptureSink>();
+    logger.addSink(sink);
+    logger.setLogLevel(LogLevel::Warning);
+
+    AsyncLogConfig config;
+    config.overflowPolicy = LogOverflowPolicy::Block;
+    config.flushInterval = std::chrono::milliseconds(1000);
+    logger.enableAsync(config);
+    assert(logger.isAsync() && "Logger should be in async mode");
+
+    const int threads = 4;
+    const int per_thread = 25;
+    std::vector<std::thread> producers;
+    for (int t = 0; t < threads; ++t) {
+        producers.emplace_back([&logger, t] {
+            for (int i = 0; i < per_thread; ++i) {
+                logger.log(LogLevel::Warning, std::to_string(t) + ":" + std::to_string(i));
+            }
+        });
+    }
+    for (auto& producer : producers) producer.join();
+    logger.log(LogLevel::Debug, "filtered");
+    logger.flush();
+
+    std::vector<std::string> messages = sink->messages();
+    assert(messages.size() == static_cast<size_t>(threads * per_thread) && "All messages should reach the sink");
+    // Each thread's messages keep their order
+    std::vector<int> next(threads, 0);
+    for (const std::string& message : messages) {
+        const int t = message[0] - '0';
+        assert(message == std::to_string(t) + ":" + std::to_string(next[t]) && "Per-thread order should be preserved");
+        ++next[t];
+    }
+    assert(sink->m_flushes < threads * per_thread && "Sinks should be flushed per batch, not per line");
+
+    // Fatal messages are drained before log() returns, even with a long flush interval
+    logger.log(LogLevel::Fatal, "fatal");
+    assert(sink->messages().back() == "fatal" && "Fatal message should be written synchronously");
+
+    logger.disableAsync();
+    assert(!logger.isAsync() && "Logger should be back in sync mode");
+    logger.log(LogLevel::Warning, "sync");
+    assert(sink->messages().back() == "sync" && "Sync mode should write immediately");
+    logger.setLogLevel(LogLevel::Info);
+}
+
+} // namespace tests
+} // namespace entities
+
+int main() {
+    std::cout << "Running async logging test..." << std::endl;
+    entities::tests::test_async_backend_ordering();
+    entities::tests::test_async_backend_drop_policy();
+    entities::tests::test_async_backend_block_from_writer();
+    entities::tests::test_async_logger();
+    std::cout << "Async logging test passed!" << std::endl;
+    return 0;
+}
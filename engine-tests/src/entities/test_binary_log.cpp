@@ -0,0 +1,185 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "utils/BinaryLog.h"
+#include "job_scheduler.h"
+
+namespace entities {
+namespace tests {
+
+using namespace Logging;
+
+const std::string LOG_PATH = "test_binary_log.bin";
+
+class TracedJob : public JobSystem::JobBase {
+public:
+    explicit TracedJob(std::atomic<bool>& ran) : JobBase("TracedJob"), m_ran(ran) {}
+    void Execute(float) override { m_ran = true; }
+    void RefreshCache() override {}
+
+private:
+    std::atomic<bool>& m_ran;
+};
+
+bool contains(const std::vector<std::string>& lines, const std::string& text) {
+    for (const auto& line : lines) {
+        if (line.find(text) != std::string::npos) return true;
+    }
+    return false;
+}
+
+void test_binary_log_round_trip() {
+    BinaryLog log;
+    const bool opened = log.open(LOG_PATH, 1 << 20);
+    assert(opened && "Log file should be created");
+    (void)opened;
+    BinaryLog::setGlobal(&log);
+
+    int value = -12;
+    const char* name = "sprite";
+    LOG_TRACE("no arguments");
+    LOG_TRACE("entity {} at {} {}", 42u, 1.5f, -2.25);
+    LOG_TRACE("{} {} {} {}", name, value, true, std::string("owned"));
+    LOG_BINARY(LogLevel::Warning, "extra", 7);
+
+    // Regular log messages can go to the same file through the sink
+    BinaryLogSink sink(log);
+    sink.write(LogLevel::Warning, "text message 3");
+
+    log.close();
+    assert(BinaryLog::global() == nullptr && "Closing the global log should uninstall it");
+    LOG_TRACE("not written");
+
+    std::vector<std::string> lines;
+    const bool decoded = BinaryLog::decodeFile(LOG_PATH, lines);
+    assert(decoded && "Log should decode");
+    (void)decoded;
+    assert(lines.size() == 5 && "One line per event");
+    assert(contains(lines, "[DEBUG] no arguments") && "Format without arguments");
+    assert(contains(lines, "[DEBUG] entity 42 at 1.5 -2.25") && "Numbers should be substituted");
+    assert(contains(lines, "sprite -12 true owned") && "Strings and bools should be substituted");
+    assert(contains(lines, "[WARNING] extra 7") && "Unplaced arguments are appended");
+    assert(contains(lines, "[WARNING] text message 3") && "Sink messages should be stored");
+    std::remove(LOG_PATH.c_str());
+}
+
+void test_binary_log_threads() {
+    BinaryLog log;
+    const bool opened = log.open(LOG_PATH, 4 << 20);
+    assert(opened && "Log file should be created");
+    (void)opened;
+    BinaryLog::setGlobal(&log);
+
+    const int threads = 4;
+    const int per_thread = 10000;
+    std::vector<std::thread> writers;
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (int t = 0; t < threads; ++t) {
+        writers.emplace_back([t] {
+            for (int i = 0; i < per_thread; ++i) {
+                LOG_TRACE("thread {} record {}", t, i);
+            }
+        });
+    }
+    for (auto& writer : writers) writer.join();
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - start).count();
+    std::cout << "Binary trace: " << elapsed / (threads * per_thread) << " ns per record" << std::endl;
+
+    // Job scheduler workers trace every job
+    std::atomic<bool> ran{ false };
+    {
+        JobSystem::JobScheduler scheduler(2);
+        scheduler.ScheduleJob(new TracedJob(ran));
+        for (int i = 0; i < 1000 && !ran; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    assert(ran && "Job should run");
+    log.close();
+
+    std::vector<std::string> lines;
+    const bool decoded = BinaryLog::decodeFile(LOG_PATH, lines);
+    assert(decoded && "Log should decode");
+    (void)decoded;
+    assert(lines.size() == static_cast<size_t>(threads * per_thread) + 2 && "No record should be lost");
+    assert(contains(lines, "thread 3 record 9999") && "Last record of each thread should be present");
+    assert(contains(lines, "job begin TracedJob") && contains(lines, "job end TracedJob") && "Jobs should be traced");
+    std::remove(LOG_PATH.c_str());
+}
+
+void test_binary_log_close_while_writing() {
+    BinaryLog log;
+    const bool opened = log.open(LOG_PATH, 1 << 20);
+    assert(opened && "Log file should be created");
+    (void)opened;
+    BinaryLog::setGlobal(&log);
+
+    // Writers keep tracing while the log is closed under them; close() waits for the ones already inside
+    std::atomic<bool> stop{ false };
+    std::atomic<int> started{ 0 };
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&stop, &started, t] {
+            started.fetch_add(1);
+            for (int i = 0; !stop.load(std::memory_order_relaxed); ++i) {
+                LOG_TRACE("thread {} record {}", t, i);
+            }
+        });
+    }
+    while (started.load() < 4) {
+        std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    log.close();
+    assert(BinaryLog::global() == nullptr && "Closing should uninstall the global log");
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    stop = true;
+    for (auto& writer : writers) writer.join();
+
+    std::vector<std::string> lines;
+    const bool decoded = BinaryLog::decodeFile(LOG_PATH, lines);
+    assert(decoded && !lines.empty() && "Log closed under writers should decode");
+    (void)decoded;
+    std::remove(LOG_PATH.c_str());
+}
+
+void test_binary_log_full() {
+    BinaryLog log;
+    const bool opened = log.open(LOG_PATH, 4096);
+    assert(opened && "Log file should be created");
+    (void)opened;
+    const uint32_t format = BinaryLog::registerFormat(LogLevel::Info, "value {}", __FILE__, __LINE__);
+    size_t written = 0;
+    for (int i = 0; i < 1000; ++i) {
+        if (log.write(format, LogLevel::Info, i)) ++written;
+    }
+    assert(written > 0 && written < 1000 && "Log should fill up");
+    assert(log.droppedCount() == 1000 - written && "Records that do not fit are counted");
+    log.close();
+
+    std::vector<std::string> lines;
+    const bool decoded = BinaryLog::decodeFile(LOG_PATH, lines);
+    assert(decoded && "Full log should decode");
+    (void)decoded;
+    assert(lines.size() == written + 1 && "Decoded events plus the dropped note");
+    assert(contains(lines, "records dropped") && "Dropped records should be reported");
+    std::remove(LOG_PATH.c_str());
+}
+
+} // namespace tests
+} // namespace entities
+
+int main() {
+    std::cout << "Running binary log test..." << std::endl;
+    entities::tests::test_binary_log_round_trip();
+    entities::tests::test_binary_log_threads();
+    entities::tests::test_binary_log_close_while_writing();
+    entities::tests::test_binary_log_full();
+    std::cout << "Binary log test passed!" << std::endl;
+    return 0;
+}
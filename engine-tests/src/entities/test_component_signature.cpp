@@ -0,0 +1,76 @@
+#include <cassert>
+#include <iostream>
+#include "include/archetype.h"
+
+namespace entities {
+namespace tests {
+
+DEFINE_COMPONENT(PositionComponent, 10)
+    COMPONENT_MEMBER(float, x) = 0.0f;
+    COMPONENT_MEMBER(float, y) = 0.0f;
+END_COMPONENT
+
+DEFINE_COMPONENT(VelocityComponent, 10)
+    COMPONENT_MEMBER(float, vx) = 0.0f;
+    COMPONENT_MEMBER(float, vy) = 0.0f;
+END_COMPONENT
+
+DEFINE_POD_COMPONENT(HealthComponent, 10)
+    POD_MEMBER_DEFAULT(int, health, 100);
+END_POD_COMPONENT
+
+DEFINE_ARCHETYPE(MovableEntity, PositionComponent, VelocityComponent);
+DEFINE_ARCHETYPE(StaticEntity, PositionComponent);
+DEFINE_ARCHETYPE(LivingEntity, PositionComponent, VelocityComponent, HealthComponent);
+
+void test_component_signature() {
+    // Ids are dense and distinct per component type
+    ComponentTypeId position_id = PositionComponent::TypeId();
+    ComponentTypeId velocity_id = VelocityComponent::TypeId();
+    ComponentTypeId health_id = HealthComponent::TypeId();
+    assert(position_id != velocity_id && velocity_id != health_id && position_id != health_id && "Type ids should be unique");
+    assert(position_id < 3 && velocity_id < 3 && health_id < 3 && "Type ids should be dense");
+    assert(PositionComponent::TypeId() == GetComponentTypeId<PositionComponent>() && "Type id should be stable");
+
+    ComponentSignature movable = MovableEntity::Signature();
+    assert(movable.count() == 2 && movable.test(position_id) && movable.test(velocity_id) && "Archetype signature should have its components");
+
+    MovableEntity::Create("mover");
+    StaticEntity::Create("rock");
+    LivingEntity::Create("player");
+
+    // Signature matching is a single AND/compare
+    assert(MovableEntity::HasComponents("mover") && "Mover should match its archetype");
+    assert(!MovableEntity::HasComponents("rock") && "Rock has no velocity");
+    assert(StaticEntity::HasComponents("mover") && "Mover also has a position");
+    assert(StaticEntity::GetComponent<PositionComponent>("mover") == MovableEntity::GetComponent<PositionComponent>("mover") &&
+           StaticEntity::GetComponent<PositionComponent>("mover") != nullptr && "Archetypes sharing a component should see the same one");
+    assert(!MovableEntity::HasComponents("rock") && MovableEntity::GetComponent<VelocityComponent>("rock") == nullptr && "Missing components match HasComponents");
+    assert(MovableEntity::HasComponents("player") && "Player has position and velocity");
+    assert(LivingEntity::HasComponents("player") && "Player should match its archetype");
+    assert(!LivingEntity::HasComponents("mover") && "Mover has no health");
+
+    assert(MovableEntity::Query().size() == 2 && "Two entities have position and velocity");
+    assert(StaticEntity::Query().size() == 3 && "All entities have a position");
+    assert(EntitySignatures::Query(MakeSignature<HealthComponent>()).size() == 1 && "Only the player has health");
+
+    // Destroying components clears their bits
+    LivingEntity::DestroyFor("player");
+    assert(!LivingEntity::HasComponents("player") && "Player components were destroyed");
+    assert(LivingEntity::GetComponent<HealthComponent>("player") == nullptr && "Destroyed components should not be found");
+    assert(EntitySignatures::Get("player").none() && "Player signature should be empty");
+
+    MovableEntity::DestroyFor("mover");
+    StaticEntity::DestroyFor("rock");
+    assert(StaticEntity::Query().empty() && "No entities should remain");
+}
+
+} // namespace tests
+} // namespace entities
+
+int main() {
+    std::cout << "Running component signature test..." << std::endl;
+    entities::tests::test_component_signature();
+    std::cout << "Component signature test passed!" << std::endl;
+    return 0;
+}
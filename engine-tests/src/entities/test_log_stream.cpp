@@ -0,0 +1,145 @@
+// Compile Debug and Info messages out of this file
+#undef LOGGING_MIN_LEVEL
+#define LOGGING_MIN_LEVEL 2
+
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include "utils/LogMacros.h"
+
+// Count heap allocations made by this test
+static std::atomic<size_t> g_allocations{ 0 };
+
+void* operator new(size_t size) {
+    ++g_allocations;
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+namespace entities {
+namespace tests {
+
+using namespace Logging;
+
+// Keeps the last message in a fixed buffer so writing does not allocate
+class LastMessageSink : public LogSink {
+public:
+    void write(LogLevel level, std::string_view message) override {
+        m_level = level;
+        m_length = message.size() < sizeof(m_text) ? message.size() : sizeof(m_text);
+        std::memcpy(m_text, message.data(), m_length);
+        ++m_count;
+    }
+
+    std::string_view last() const { return std::string_view(m_text, m_length); }
+
+    LogLevel m_level = LogLevel::Debug;
+    int m_count = 0;
+
+private:
+    char m_text[1024];
+    size_t m_length = 0;
+};
+
+struct Vec2 {
+    float x, y;
+};
+
+std::ostream& operator<<(std::ostream& out, const Vec2& v) {
+    return out << "(" << v.x << ", " << v.y << ")";
+}
+
+enum class Mode { A, B, C };
+
+int g_evaluated = 0;
+
+int expensive() {
+    ++g_evaluated;
+    return 42;
+}
+
+void test_filtered_levels_cost_nothing(LastMessageSink& sink) {
+    Logger& logger = Logger::getInstance();
+    logger.setLogLevel(LogLevel::Error);
+
+    const size_t allocations = g_allocations;
+    for (int i = 0; i < 1000; ++i) {
+        // Runtime-filtered
+        LOG_WARNING << "warning " << i << " " << expensive() << LOG_END;
+        // Compiled out
+        LOG_DEBUG << "debug " << std::string(100, 'x') << expensive() << LOG_END;
+        LOG_INFO << "info " << expensive() << LOG_END;
+    }
+    assert(g_allocations == allocations && "Filtered messages should not allocate");
+    assert(g_evaluated == 0 && "Arguments of filtered messages should not be evaluated");
+    assert(sink.m_count == 0 && "Nothing should be written");
+
+    // Compiled-out levels stay out even when the runtime level allows them
+    logger.setLogLevel(LogLevel::Debug);
+    LOG_DEBUG << "debug" << LOG_END;
+    assert(sink.m_count == 0 && "Levels below LOGGING_MIN_LEVEL are stripped");
+
+    // The macro must behave as a single statement
+    bool else_taken = false;
+    if (sink.m_count != 0)
+        LOG_ERROR << "unreachable" << LOG_END;
+    else
+        else_taken = true;
+    assert(else_taken && "Dangling else should bind to the caller's if");
+}
+
+void test_enabled_levels_do_not_allocate(LastMessageSink& sink) {
+    Logger::getInstance().setLogLevel(LogLevel::Warning);
+
+    const char* name = "sprite";
+    const size_t allocations = g_allocations;
+    LOG_WARNING << name << " " << 42 << " " << -7 << " " << 3u << " " << 1.5f << " " << 0.25 << " " << true
+                << " " << 'c' << " " << Mode::C << " " << std::string_view("view") << LOG_END;
+    assert(g_allocations == allocations && "Built-in types should be formatted without allocating");
+    assert(sink.last() == "sprite 42 -7 3 1.5 0.25 true c 2 view" && "Message should be formatted");
+    assert(sink.m_level == LogLevel::Warning && "Level should be forwarded");
+
+    // Types with their own ostream operator still work
+    LOG_ERROR << "at " << Vec2{ 1.0f, 2.0f } << LOG_END;
+    assert(sink.last() == "at (1, 2)" && "Fallback formatting should use operator<<");
+
+    // Pointers are printed in hex
+    LOG_ERROR << reinterpret_cast<const void*>(uintptr_t(0xbeef)) << LOG_END;
+    assert(sink.last() == "0xbeef" && "Pointers should be printed in hex");
+
+    // Long messages are truncated to the stack buffer
+    LOG_ERROR << std::string(2 * LOG_STREAM_CAPACITY, 'x') << "tail" << LOG_END;
+    assert(sink.last().size() == LOG_STREAM_CAPACITY && "Message should be truncated");
+
+    // A stream without LOG_END flushes when it goes out of scope
+    const int count = sink.m_count;
+    { LOG_ERROR << "scoped"; }
+    assert(sink.m_count == count + 1 && sink.last() == "scoped" && "Stream should flush on destruction");
+}
+
+} // namespace tests
+} // namespace entities
+
+int main() {
+    std::cout << "Running log stream test..." << std::endl;
+    auto sink = std::make_shared<entities::tests::LastMessageSink>();
+    Logging::Logger& logger = Logging::Logger::getInstance();
+    logger.addSink(sink);
+    // Warm up the console sink so its first-use allocations are not counted
+    logger.setLogLevel(Logging::LogLevel::Error);
+    LOG_ERROR << "log stream test" << LOG_END;
+    sink->m_count = 0;
+
+    entities::tests::test_filtered_levels_cost_nothing(*sink);
+    entities::tests::test_enabled_levels_do_not_allocate(*sink);
+    logger.setLogLevel(Logging::LogLevel::Info);
+    std::cout << "Log stream test passed!" << std::endl;
+    return 0;
+}
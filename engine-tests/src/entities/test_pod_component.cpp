@@ -0,0 +1,82 @@
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+#include "include/component.h"
+
+namespace entities {
+    namespace tests {
+
+// Stand-in for glm::vec2; any trivially copyable math type works the same way
+struct Vec2 {
+    float x, y;
+};
+
+DEFINE_POD_COMPONENT(PodSpriteComponent, 10)
+    POD_MEMBER(Vec2, position);
+    POD_MEMBER_DEFAULT(float, rotation, 0.0f);
+    POD_MEMBER(utils::FixedString<15>, label);
+    POD_MEMBER(utils::NameHandle, atlas);
+END_POD_COMPONENT
+
+DEFINE_COMPONENT(ClassicComponent, 10)
+    COMPONENT_MEMBER(float, x) = 0.0f;
+END_COMPONENT
+
+static_assert(std::is_trivially_copyable_v<PodSpriteComponent>, "POD component must be trivially copyable");
+static_assert(!std::is_polymorphic_v<PodSpriteComponent>, "POD component must not carry a vtable");
+static_assert(detail::is_pod_component_v<PodSpriteComponent>, "POD component must satisfy the POD trait");
+static_assert(!detail::is_pod_component_v<ClassicComponent>, "Classic components are not POD");
+static_assert(sizeof(PodSpriteComponent) == sizeof(Vec2) + sizeof(float) + sizeof(utils::FixedString<15>) + sizeof(utils::NameHandle),
+    "POD component should be packed without hidden members");
+static_assert(!detail::is_valid_pod_member_v<int*>, "Raw pointers are not valid POD members");
+static_assert(!detail::is_valid_pod_member_v<std::string>, "std::string is not a valid POD member");
+
+void test_pod_component() {
+    auto* sprite = PodSpriteComponent::Create();
+    assert(sprite != nullptr && "POD component should be created");
+    assert(PodSpriteComponent::IsActive(sprite) && "POD component should be active");
+    assert(sprite->position.x == 0.0f && sprite->position.y == 0.0f && "POD members should be zero-initialized");
+    assert(sprite->label.empty() && "FixedString should start empty");
+    // Default-initialized on its own (no pool zeroing), the label is still empty and fully zeroed
+    utils::FixedString<15> blank;
+    assert(blank.empty() && blank == utils::FixedString<15>("") && "Default FixedString should be zero-filled");
+
+    sprite->position = Vec2{ 1.0f, 2.0f };
+    sprite->rotation = 0.5f;
+    sprite->label = "player_sprite_with_a_long_name";
+    sprite->atlas = utils::MakeName("characters");
+
+    // Long labels are truncated to the fixed capacity
+    assert(sprite->label.size() == 15 && "FixedString should truncate to its capacity");
+    assert(sprite->label == std::string_view("player_sprite_w") && "FixedString should keep the prefix");
+
+    // Name handles intern to the same id and resolve back to text
+    assert(sprite->atlas == utils::MakeName("characters") && "Interned names should compare equal");
+    assert(sprite->atlas != utils::MakeName("props") && "Different names should differ");
+    assert(utils::NameTable::getInstance().Resolve(sprite->atlas) == "characters" && "Name should resolve");
+
+    // Components can be relocated with a raw memcpy
+    auto* copy = PodSpriteComponent::Create();
+    std::memcpy(static_cast<void*>(copy), sprite, sizeof(PodSpriteComponent));
+    assert(copy->position.x == 1.0f && copy->position.y == 2.0f && "memcpy should copy position");
+    assert(copy->label == sprite->label && "memcpy should copy the label");
+    assert(copy->atlas == sprite->atlas && "memcpy should copy the name handle");
+
+    // Pool storage is dense: consecutive creations are adjacent in memory
+    assert(copy == PodSpriteComponent::GetComponentsPtr() + 1 && "POD components should be packed densely");
+
+    PodSpriteComponent::Destroy(copy);
+    PodSpriteComponent::Destroy(sprite);
+    assert(PodSpriteComponent::GetActiveCount() == 0 && "All POD components should be destroyed");
+}
+
+} // namespace tests
+} // namespace entities
+
+int main() {
+    std::cout << "Running POD component test..." << std::endl;
+    entities::tests::test_pod_component();
+    std::cout << "POD component test passed!" << std::endl;
+    return 0;
+}
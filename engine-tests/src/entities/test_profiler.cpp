@@ -0,0 +1,191 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "utils/profiler.h"
+#include "job_scheduler.h"
+
+namespace entities {
+namespace tests {
+
+using namespace Profiling;
+
+size_t countOccurrences(const std::string& text, const std::string& pattern) {
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+void busyWait(int microseconds) {
+    const auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(microseconds);
+    while (std::chrono::steady_clock::now() < end) {}
+}
+
+void inner() {
+    PROFILE_FUNCTION();
+    busyWait(200);
+}
+
+void outer() {
+    PROFILE_ZONE("outer");
+    inner();
+    inner();
+}
+
+void test_profiler_nested_zones() {
+    Profiler& profiler = Profiler::getInstance();
+    profiler.clear();
+
+    outer();
+    assert(profiler.eventCount() == 0 && "Nothing is recorded while disabled");
+
+    profiler.setEnabled(true);
+    outer();
+    profiler.setEnabled(false);
+
+    std::vector<ProfileEvent> events = profiler.events();
+    assert(events.size() == 3 && "Two inner zones and one outer zone");
+    // Zones are recorded when they close, so the outer zone comes last
+    const ProfileEvent& parent = events[2];
+    assert(std::string(parent.name) == "outer" && std::string(events[0].name) == "inner" && "Zone names");
+    for (int i = 0; i < 2; ++i) {
+        assert(events[i].start >= parent.start && "Child starts inside parent");
+        assert(events[i].start + events[i].duration <= parent.start + parent.duration && "Child ends inside parent");
+        assert(events[i].duration >= 200000 && "Zone covers the work");
+    }
+    assert(events[1].start >= events[0].start + events[0].duration && "Siblings do not overlap");
+}
+
+void test_profiler_threads_and_export() {
+    Profiler& profiler = Profiler::getInstance();
+    profiler.clear();
+    profiler.setEnabled(true);
+
+    const int threads = 4;
+    const int zones = 1000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([t] {
+            PROFILE_THREAD_NAME("Worker \"" + std::to_string(t) + "\"");
+            for (int i = 0; i < zones; ++i) {
+                PROFILE_ZONE("work");
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    // Job scheduler workers name their threads and profile each job by name
+    std::atomic<bool> ran{ false };
+    {
+        class ProfiledJob : public JobSystem::JobBase {
+        public:
+            explicit ProfiledJob(std::atomic<bool>& ran) : JobBase("ProfiledJob"), m_ran(ran) {}
+            void Execute(float) override { m_ran = true; }
+            void RefreshCache() override {}
+
+        private:
+            std::atomic<bool>& m_ran;
+        };
+        JobSystem::JobScheduler scheduler(1);
+        scheduler.ScheduleJob(new ProfiledJob(ran));
+        for (int i = 0; i < 1000 && !ran; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    assert(ran && "Job should run");
+    profiler.setEnabled(false);
+
+    assert(profiler.eventCount() == static_cast<size_t>(threads * zones) + 1 && "Every zone is recorded");
+    const std::string path = "test_profiler_trace.json";
+    const bool exported = profiler.exportChromeTrace(path);
+    assert(exported && "Trace should be written");
+    (void)exported;
+
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    const std::string json = contents.str();
+    std::remove(path.c_str());
+
+    assert(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0) == 0 && "Trace header");
+    assert(countOccurrences(json, "\"name\":\"work\"") == static_cast<size_t>(threads * zones) && "All zones exported");
+    assert(countOccurrences(json, "\"ph\":\"X\"") == static_cast<size_t>(threads * zones) + 1 && "Complete events");
+    assert(json.find("\"name\":\"Worker \\\"2\\\"\"") != std::string::npos && "Thread names are escaped");
+    assert(json.find("\"name\":\"Job worker 0\"") != std::string::npos && "Job workers are named");
+    assert(json.find("\"name\":\"ProfiledJob\"") != std::string::npos && "Jobs are profiled by name");
+    assert(countOccurrences(json, "{") == countOccurrences(json, "}") && "Braces balance");
+}
+
+void test_profiler_capacity() {
+    Profiler& profiler = Profiler::getInstance();
+    profiler.clear();
+    profiler.setEventCapacity(100);
+    profiler.setEnabled(true);
+    std::thread worker([] {
+        for (int i = 0; i < 150; ++i) {
+            PROFILE_ZONE("bounded");
+        }
+    });
+    worker.join();
+    profiler.setEnabled(false);
+    assert(profiler.eventCount() == 100 && "Recording stops when the thread buffer is full");
+    assert(profiler.droppedCount() == 50 && "Overflowing zones are counted");
+    profiler.setEventCapacity(1 << 14);
+}
+
+void test_profiler_gpu_track() {
+    Profiler& profiler = Profiler::getInstance();
+    profiler.clear();
+    profiler.setEnabled(true);
+    {
+        PROFILE_ZONE("submit");
+    }
+    profiler.recordGpuZone("RenderPass", 1000000, 250000);
+    profiler.recordGpuZone("UIOverlay", 1100000, 50000);
+    profiler.setEnabled(false);
+
+    assert(profiler.eventCount() == 3 && "GPU zones are recorded alongside CPU zones");
+    const std::string json = profiler.toChromeTrace();
+    assert(json.find("\"name\":\"GPU\"") != std::string::npos && "GPU zones get their own track");
+    assert(countOccurrences(json, "\"cat\":\"gpu\"") == 2 && "GPU zones are tagged");
+    assert(json.find("\"name\":\"RenderPass\",\"cat\":\"gpu\",\"ph\":\"X\"") != std::string::npos && "GPU zone exported");
+    assert(json.find("\"ts\":1000.000,\"dur\":250.000") != std::string::npos && "GPU times in microseconds");
+    profiler.clear();
+}
+
+void test_profiler_overhead() {
+    Profiler& profiler = Profiler::getInstance();
+    profiler.clear();
+    profiler.setEnabled(true);
+    const int zones = 10000;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < zones; ++i) {
+        PROFILE_ZONE("overhead");
+    }
+    const double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    profiler.setEnabled(false);
+    std::cout << "Profile zone cost: " << elapsed / zones << " ns" << std::endl;
+    profiler.clear();
+}
+
+} // namespace tests
+} // namespace entities
+
+int main() {
+    std::cout << "Running profiler test..." << std::endl;
+    entities::tests::test_profiler_nested_zones();
+    entities::tests::test_profiler_threads_and_export();
+    entities::tests::test_profiler_capacity();
+    entities::tests::test_profiler_gpu_track();
+    entities::tests::test_profiler_overhead();
+    std::cout << "Profiler test passed!" << std::endl;
+    return 0;
+}
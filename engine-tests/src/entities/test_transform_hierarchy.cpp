@@ -0,0 +1,117 @@
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include "include/hierarchy.h"
+
+namespace entities {
+namespace tests {
+
+static bool near(float a, float b) {
+    return std::fabs(a - b) < 1e-4f;
+}
+
+void test_hierarchy_structure() {
+    TransformHierarchy hierarchy;
+    hierarchy.Add("root", Transform2D{ 10.0f, 0.0f });
+    hierarchy.Add("arm", Transform2D{ 5.0f, 0.0f });
+    hierarchy.Add("hand", Transform2D{ 1.0f, 0.0f });
+    hierarchy.Add("effect", Transform2D{ 0.0f, 2.0f });
+    bool ok = hierarchy.Add("root");
+    assert(!ok && "Duplicate ids should be rejected");
+
+    ok = hierarchy.Attach("arm", "root");
+    assert(ok && "Attach should succeed");
+    ok = hierarchy.Attach("hand", "arm");
+    assert(ok && "Attach should succeed");
+    ok = hierarchy.Attach("effect", "root");
+    assert(ok && "Attach should succeed");
+    ok = hierarchy.Attach("root", "hand");
+    assert(!ok && "Cycles should be rejected");
+    ok = hierarchy.Attach("root", "root");
+    assert(!ok && "Self-parenting should be rejected");
+    ok = hierarchy.Attach("missing", "root");
+    assert(!ok && "Unknown ids should be rejected");
+    (void)ok;
+
+    assert(hierarchy.GetParent("hand") == "arm" && "Parent should be tracked");
+    assert(hierarchy.GetLevelCount() == 3 && "Hierarchy should have three levels");
+
+    // Children of a node are contiguous and every parent precedes its children
+    auto children = hierarchy.GetChildren("root");
+    assert(children.size() == 2 && "Root should have two children");
+    uint32_t root = hierarchy.GetNodeIndex("root");
+    uint32_t first = hierarchy.GetFirstChild(root);
+    assert(hierarchy.GetChildCount(root) == 2 && "Root child count should be 2");
+    assert(hierarchy.GetParentNode(first) == root && hierarchy.GetParentNode(first + 1) == root && "Children should be contiguous");
+    assert(hierarchy.GetNodeIndex("hand") > hierarchy.GetNodeIndex("arm") && "Parents should come before children");
+    auto level1 = hierarchy.GetLevelRange(1);
+    assert(level1.first == first && level1.second == first + 2 && "Level 1 should hold the root's children");
+
+    hierarchy.Propagate();
+    assert(near(hierarchy.GetWorld("hand")->x, 16.0f) && "World position should accumulate");
+    assert(near(hierarchy.GetWorld("effect")->y, 2.0f) && "World position should accumulate");
+
+    // Rotating and scaling the root moves every descendant
+    hierarchy.SetLocal("root", Transform2D{ 10.0f, 0.0f, 3.14159265f / 2.0f, 2.0f, 2.0f });
+    hierarchy.Propagate();
+    const Transform2D* hand = hierarchy.GetWorld("hand");
+    assert(near(hand->x, 10.0f) && near(hand->y, 12.0f) && "Rotation and scale should propagate");
+    assert(near(hand->scaleX, 2.0f) && "Scale should propagate");
+
+    // Detached and orphaned nodes become roots
+    hierarchy.Detach("hand");
+    hierarchy.Propagate();
+    assert(near(hierarchy.GetWorld("hand")->x, 1.0f) && "Detached node should use its local transform");
+    hierarchy.Remove("root");
+    assert(hierarchy.GetParent("arm").empty() && "Children of a removed node should become roots");
+    assert(hierarchy.GetLevelCount() == 1 && "Only roots should remain");
+    assert(hierarchy.GetWorld("root") == nullptr && "Removed node should be gone");
+}
+
+void test_hierarchy_parallel_propagation() {
+    // Wide, multi-level tree so each level is split across several jobs
+    TransformHierarchy serial;
+    TransformHierarchy parallel;
+    const int roots = 64;
+    const int children_per_node = 8;
+    for (TransformHierarchy* hierarchy : { &serial, &parallel }) {
+        for (int r = 0; r < roots; ++r) {
+            std::string root_id = "r" + std::to_string(r);
+            hierarchy->Add(root_id, Transform2D{ float(r), 0.0f, 0.1f * r });
+            for (int c = 0; c < children_per_node; ++c) {
+                std::string child_id = root_id + "c" + std::to_string(c);
+                hierarchy->Add(child_id, Transform2D{ 1.0f, float(c), 0.05f, 1.5f, 0.5f });
+                hierarchy->Attach(child_id, root_id);
+                for (int g = 0; g < children_per_node; ++g) {
+                    std::string grandchild_id = child_id + "g" + std::to_string(g);
+                    hierarchy->Add(grandchild_id, Transform2D{ float(g), 1.0f });
+                    hierarchy->Attach(grandchild_id, child_id);
+                }
+            }
+        }
+    }
+
+    JobSystem::JobScheduler scheduler(4);
+    serial.Propagate();
+    parallel.Propagate(scheduler, 32);
+
+    for (int r = 0; r < roots; ++r) {
+        std::string id = "r" + std::to_string(r) + "c3g5";
+        const Transform2D* a = serial.GetWorld(id);
+        const Transform2D* b = parallel.GetWorld(id);
+        assert(a->x == b->x && a->y == b->y && a->rotation == b->rotation && "Parallel propagation should match serial");
+    }
+    scheduler.Update(0.0f);
+}
+
+} // namespace tests
+} // namespace entities
+
+int main() {
+    std::cout << "Running transform hierarchy test..." << std::endl;
+    entities::tests::test_hierarchy_structure();
+    entities::tests::test_hierarchy_parallel_propagation();
+    std::cout << "Transform hierarchy test passed!" << std::endl;
+    return 0;
+}
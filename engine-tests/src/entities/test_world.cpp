@@ -0,0 +1,105 @@
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include "include/component.h"
+#include "include/world.h"
+
+namespace entities {
+namespace tests {
+
+DEFINE_POD_COMPONENT(WorldPosition, 10)
+    POD_MEMBER_DEFAULT(float, x, 0.0f);
+    POD_MEMBER_DEFAULT(float, y, 0.0f);
+END_POD_COMPONENT
+
+DEFINE_POD_COMPONENT(WorldVelocity, 10)
+    POD_MEMBER_DEFAULT(float, vx, 0.0f);
+    POD_MEMBER_DEFAULT(float, vy, 0.0f);
+END_POD_COMPONENT
+
+void test_world_entities() {
+    World world;
+    EntityId a = world.CreateEntity();
+    EntityId b = world.CreateEntity();
+    assert(world.IsAlive(a) && world.IsAlive(b) && "Entities should be alive");
+    assert(world.GetEntityCount() == 2 && "Two entities should exist");
+
+    world.AddComponent<WorldPosition>(a, 1.0f, 2.0f);
+    world.AddComponent<WorldVelocity>(a, 0.5f, 0.0f);
+    world.AddComponent<WorldPosition>(b);
+    assert(world.GetComponent<WorldPosition>(a)->y == 2.0f && "Component data should be stored");
+    assert(world.HasComponent<WorldVelocity>(a) && !world.HasComponent<WorldVelocity>(b) && "Signatures should track components");
+    assert(world.Query<WorldPosition>().size() == 2 && "Both entities have a position");
+    assert((world.Query<WorldPosition, WorldVelocity>().size() == 1) && "Only a moves");
+
+    // Removing a component swaps the last element in, without disturbing other entities
+    world.RemoveComponent<WorldPosition>(a);
+    assert(world.GetComponent<WorldPosition>(a) == nullptr && "Removed component should be gone");
+    assert(world.GetComponent<WorldPosition>(b) != nullptr && "Other components should survive");
+    assert(world.Storage<WorldPosition>().Size() == 1 && "Store should stay dense");
+
+    // Destroyed handles go stale even when the index is reused
+    world.DestroyEntity(a);
+    assert(!world.IsAlive(a) && "Destroyed entity should not be alive");
+    EntityId c = world.CreateEntity();
+    assert(c.index == a.index && c.generation != a.generation && "Index should be recycled with a new generation");
+    assert(world.GetComponent<WorldVelocity>(c) == nullptr && "Recycled entity should start empty");
+    assert(world.GetComponent<WorldVelocity>(a) == nullptr && "Stale handle should not resolve");
+
+    world.Clear();
+    assert(world.GetEntityCount() == 0 && "Clear should destroy every entity");
+}
+
+void test_world_isolation() {
+    World first;
+    World second;
+    EntityId e = first.CreateEntity();
+    first.AddComponent<WorldPosition>(e, 5.0f, 5.0f);
+    assert(second.Query<WorldPosition>().empty() && "Worlds should not share components");
+    assert(WorldPosition::GetActiveCount() == 0 && "Worlds should not touch the static pools");
+}
+
+// Run an independent simulation in a world and return the summed x positions
+static float simulate(World& world, int entities, int steps, float speed) {
+    for (int i = 0; i < entities; ++i) {
+        EntityId entity = world.CreateEntity();
+        world.AddComponent<WorldPosition>(entity, float(i), 0.0f);
+        world.AddComponent<WorldVelocity>(entity, speed, 0.0f);
+    }
+    for (int step = 0; step < steps; ++step) {
+        world.Each<WorldPosition, WorldVelocity>([](EntityId, WorldPosition& position, WorldVelocity& velocity) {
+            position.x += velocity.vx;
+            position.y += velocity.vy;
+        });
+    }
+    float sum = 0.0f;
+    world.Each<WorldPosition>([&sum](EntityId, WorldPosition& position) { sum += position.x; });
+    return sum;
+}
+
+void test_world_parallel_simulations() {
+    World left;
+    World right;
+    float left_sum = 0.0f;
+    float right_sum = 0.0f;
+    std::thread left_thread([&] { left_sum = simulate(left, 1000, 100, 1.0f); });
+    std::thread right_thread([&] { right_sum = simulate(right, 1000, 100, 2.0f); });
+    left_thread.join();
+    right_thread.join();
+
+    // sum(i) + entities * steps * speed
+    assert(left_sum == 499500.0f + 100000.0f && "Left world should only see its own entities");
+    assert(right_sum == 499500.0f + 200000.0f && "Right world should only see its own entities");
+}
+
+} // namespace tests
+} // namespace entities
+
+int main() {
+    std::cout << "Running world test..." << std::endl;
+    entities::tests::test_world_entities();
+    entities::tests::test_world_isolation();
+    entities::tests::test_world_parallel_simulations();
+    std::cout << "World test passed!" << std::endl;
+    return 0;
+}
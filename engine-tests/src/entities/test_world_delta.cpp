@@ -0,0 +1,165 @@
+#include <cassert>
+#include <iostream>
+#include <tuple>
+#include <vector>
+#include "include/component.h"
+#include "include/world_delta.h"
+
+namespace entities {
+namespace tests {
+
+DEFINE_POD_COMPONENT(DeltaPosition, 10)
+    POD_MEMBER_DEFAULT(float, x, 0.0f);
+    POD_MEMBER_DEFAULT(float, y, 0.0f);
+END_POD_COMPONENT
+
+DEFINE_POD_COMPONENT(DeltaHealth, 10)
+    POD_MEMBER_DEFAULT(int, value, 100);
+END_POD_COMPONENT
+
+// (index, generation, has position, x, y, has health, health) for every live entity
+using EntityState = std::tuple<uint32_t, uint32_t, bool, float, float, bool, int>;
+
+static std::vector<EntityState> capture(const World& world, const std::vector<EntityId>& ids) {
+    std::vector<EntityState> state;
+    for (EntityId id : ids) {
+        if (!world.IsAlive(id)) continue;
+        const DeltaPosition* position = world.ReadComponent<DeltaPosition>(id);
+        const DeltaHealth* health = world.ReadComponent<DeltaHealth>(id);
+        state.emplace_back(id.index, id.generation,
+                           position != nullptr, position ? position->x : 0.0f, position ? position->y : 0.0f,
+                           health != nullptr, health ? health->value : 0);
+    }
+    return state;
+}
+
+void test_delta_round_trip() {
+    World world;
+    std::vector<EntityId> ids;
+    for (int i = 0; i < 1000; ++i) {
+        EntityId id = world.CreateEntity();
+        world.AddComponent<DeltaPosition>(id, float(i), 0.0f);
+        ids.push_back(id);
+    }
+
+    DeltaRecorder recorder(64);
+    recorder.Begin(world);
+    std::vector<std::vector<EntityState>> frames{ capture(world, ids) };
+
+    for (int frame = 1; frame <= 10; ++frame) {
+        // Move a handful of entities each frame
+        for (int i = 0; i < 10; ++i) {
+            world.GetComponent<DeltaPosition>(ids[frame * 10 + i])->y += 1.0f;
+        }
+        // Reads are not tracked and must not show up in the delta
+        for (EntityId id : ids) {
+            (void)world.ReadComponent<DeltaPosition>(id);
+        }
+        // Structural changes: components and entities come and go
+        if (frame == 3) world.AddComponent<DeltaHealth>(ids[5], 42);
+        if (frame == 5) world.RemoveComponent<DeltaPosition>(ids[6]);
+        if (frame == 6) world.DestroyEntity(ids[7]);
+        if (frame == 7) {
+            EntityId id = world.CreateEntity();
+            world.AddComponent<DeltaHealth>(id, 7);
+            ids.push_back(id);
+        }
+
+        size_t bytes = recorder.Record(world);
+        assert(bytes < 400 && "Delta should only contain the changed components");
+        frames.push_back(capture(world, ids));
+    }
+    assert(recorder.GetHistorySize() == 10 && "Every frame should be retained");
+
+    // Walk all the way back and forward again, checking every frame
+    for (int frame = 9; frame >= 0; --frame) {
+        const bool stepped = recorder.StepBack(world);
+        assert(stepped && "Should step back");
+        (void)stepped;
+        assert(capture(world, ids) == frames[frame] && "Rewound state should match the recorded frame");
+    }
+    assert(!recorder.CanStepBack() && "Cannot step back past the beginning");
+    assert(world.GetEntityCount() == 1000 && "Entity count should be restored");
+    for (int frame = 1; frame <= 10; ++frame) {
+        const bool stepped = recorder.StepForward(world);
+        assert(stepped && "Should step forward");
+        (void)stepped;
+        assert(capture(world, ids) == frames[frame] && "Replayed state should match the recorded frame");
+    }
+    assert(!recorder.CanStepForward() && "Cannot step past the latest frame");
+
+    // Rollback and resimulate: recording after stepping back drops the old future
+    recorder.StepBack(world);
+    recorder.StepBack(world);
+    world.GetComponent<DeltaPosition>(ids[0])->x = -1.0f;
+    recorder.Record(world);
+    assert(recorder.GetHistorySize() == 9 && "Resimulated frame should replace the old future");
+    assert(!recorder.CanStepForward() && "Old future should be discarded");
+    recorder.StepBack(world);
+    assert(capture(world, ids) == frames[8] && "Stepping back over the resimulated frame should restore frame 8");
+}
+
+void test_delta_ring_capacity() {
+    World world;
+    EntityId id = world.CreateEntity();
+    world.AddComponent<DeltaPosition>(id);
+
+    DeltaRecorder recorder(4);
+    recorder.Begin(world);
+    for (int frame = 1; frame <= 10; ++frame) {
+        world.GetComponent<DeltaPosition>(id)->x = float(frame);
+        recorder.Record(world);
+    }
+    assert(recorder.GetHistorySize() == 4 && "Ring should keep only the newest frames");
+    int steps = 0;
+    while (recorder.StepBack(world)) ++steps;
+    assert(steps == 4 && "Should step back exactly the retained frames");
+    assert(world.ReadComponent<DeltaPosition>(id)->x == 6.0f && "Oldest retained state should be frame 6");
+}
+
+void test_delta_skips_unchanged_stores() {
+    World world;
+    std::vector<EntityId> ids;
+    for (int i = 0; i < 100; ++i) {
+        EntityId id = world.CreateEntity();
+        world.AddComponent<DeltaPosition>(id, float(i), 0.0f);
+        world.AddComponent<DeltaHealth>(id, i);
+        ids.push_back(id);
+    }
+    const ComponentStore<DeltaPosition>& positions = world.Storage<DeltaPosition>();
+    const uint64_t structure = positions.StructureVersion();
+
+    DeltaRecorder recorder;
+    recorder.Begin(world);
+    const size_t empty = recorder.Record(world);
+    assert(empty <= 8 && "A frame without changes should only hold the headers");
+
+    // Writes alone leave the structure version alone and raise the store's newest change
+    world.GetComponent<DeltaHealth>(ids[40])->value = -1;
+    assert(positions.StructureVersion() == structure && "Writes are not structural changes");
+    assert(world.Storage<DeltaHealth>().MaxChangeVersion() == world.GetChangeTick() && "Writes should raise the newest change");
+    const size_t written = recorder.Record(world);
+    assert(written > empty && written < empty + 16 && "Only the written component should be encoded");
+
+    world.RemoveComponent<DeltaPosition>(ids[3]);
+    assert(positions.StructureVersion() != structure && "Removing should change the structure version");
+    recorder.Record(world);
+
+    const bool back = recorder.StepBack(world) && recorder.StepBack(world);
+    assert(back && "Should step back over both frames");
+    assert(world.ReadComponent<DeltaHealth>(ids[40])->value == 40 && "Written value should be restored");
+    assert(world.ReadComponent<DeltaPosition>(ids[3]) != nullptr && "Removed component should be restored");
+    (void)back;
+}
+
+} // namespace tests
+} // namespace entities
+
+int main() {
+    std::cout << "Running world delta test..." << std::endl;
+    entities::tests::test_delta_round_trip();
+    entities::tests::test_delta_ring_capacity();
+    entities::tests::test_delta_skips_unchanged_stores();
+    std::cout << "World delta test passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,195 @@
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include "include/component.h"
+#include "include/world_snapshot.h"
+
+namespace entities {
+namespace tests {
+
+DEFINE_POD_COMPONENT(SnapshotPosition, 10)
+    POD_MEMBER_DEFAULT(float, x, 0.0f);
+    POD_MEMBER_DEFAULT(float, y, 0.0f);
+END_POD_COMPONENT
+
+DEFINE_POD_COMPONENT(SnapshotLabel, 10)
+    POD_MEMBER(utils::FixedString<15>, text);
+    POD_MEMBER_DEFAULT(int, layer, 0);
+END_POD_COMPONENT
+
+// Not trivially copyable, so it is left out of snapshots
+struct SnapshotScript {
+    std::string source;
+};
+
+static std::string snapshot_path() {
+    return (std::filesystem::temp_directory_path() / "test_world_snapshot.ecs").string();
+}
+
+void test_snapshot_round_trip() {
+    World world;
+    std::vector<EntityId> entities;
+    for (int i = 0; i < 1000; ++i) {
+        EntityId entity = world.CreateEntity();
+        world.AddComponent<SnapshotPosition>(entity, float(i), float(-i));
+        if (i % 3 == 0) {
+            world.AddComponent<SnapshotLabel>(entity, utils::FixedString<15>("entity"), i);
+        }
+        entities.push_back(entity);
+    }
+    world.AddComponent<SnapshotScript>(entities[0], SnapshotScript{ "print('hi')" });
+    // Punch holes so the free list and generations are exercised
+    for (int i = 0; i < 1000; i += 7) {
+        world.DestroyEntity(entities[i]);
+    }
+
+    const std::string path = snapshot_path();
+    const bool saved = WorldSnapshot::Save(world, path);
+    assert(saved && "Snapshot should be saved");
+    (void)saved;
+
+    World loaded;
+    loaded.RegisterComponent<SnapshotPosition>();
+    loaded.RegisterComponent<SnapshotLabel>();
+    const bool restored = WorldSnapshot::Load(loaded, path);
+    assert(restored && "Snapshot should load");
+    (void)restored;
+
+    assert(loaded.GetEntityCount() == world.GetEntityCount() && "Entity count should match");
+    for (int i = 0; i < 1000; ++i) {
+        EntityId entity = entities[i];
+        assert(loaded.IsAlive(entity) == world.IsAlive(entity) && "Liveness and generations should match");
+        if (!world.IsAlive(entity)) continue;
+        assert(loaded.GetComponent<SnapshotPosition>(entity)->x == float(i) && "Position should round-trip");
+        assert(loaded.HasComponent<SnapshotLabel>(entity) == (i % 3 == 0) && "Signatures should be rebuilt");
+        if (i % 3 == 0) {
+            assert(loaded.GetComponent<SnapshotLabel>(entity)->text == std::string_view("entity") && "Label should round-trip");
+            assert(loaded.GetComponent<SnapshotLabel>(entity)->layer == i && "Label should round-trip");
+        }
+    }
+    assert((loaded.Query<SnapshotPosition, SnapshotLabel>().size() == world.Query<SnapshotPosition, SnapshotLabel>().size()) && "Queries should match");
+
+    // The free list is restored, so the next entity reuses the same index as in the source world
+    EntityId next_original = world.CreateEntity();
+    EntityId next_loaded = loaded.CreateEntity();
+    assert(next_original == next_loaded && "Entity allocation should continue identically");
+
+    std::remove(path.c_str());
+}
+
+void test_snapshot_rejects_bad_input() {
+    World world;
+    world.AddComponent<SnapshotPosition>(world.CreateEntity());
+    std::vector<uint8_t> data = WorldSnapshot::Capture(world);
+
+    World target;
+    target.RegisterComponent<SnapshotPosition>();
+    std::vector<uint8_t> corrupt = data;
+    corrupt[0] = 'X';
+    const bool bad_magic = WorldSnapshot::Restore(target, corrupt.data(), corrupt.size());
+    assert(!bad_magic && "Bad magic should be rejected");
+    const bool truncated = WorldSnapshot::Restore(target, data.data(), data.size() / 2);
+    assert(!truncated && "Truncated data should be rejected");
+    (void)bad_magic;
+    (void)truncated;
+    const bool valid = WorldSnapshot::Restore(target, data.data(), data.size());
+    assert(valid && "Valid data should load");
+    (void)valid;
+    assert(target.Query<SnapshotPosition>().size() == 1 && "Component should be restored");
+}
+
+void test_snapshot_rejects_corrupt_columns() {
+    World world;
+    for (int i = 0; i < 4; ++i) {
+        world.AddComponent<SnapshotPosition>(world.CreateEntity(), float(i), 0.0f);
+    }
+    const std::vector<uint8_t> data = WorldSnapshot::Capture(world);
+    SnapshotHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    SnapshotColumn column;
+    std::memcpy(static_cast<void*>(&column), data.data() + header.columns_offset, sizeof(column));
+
+    // The target already holds state that a rejected snapshot must leave alone
+    World target;
+    EntityId existing = target.CreateEntity();
+    target.AddComponent<SnapshotPosition>(existing, 42.0f, 0.0f);
+    auto expect_rejected = [&](const std::vector<uint8_t>& corrupt, const char* message) {
+        const bool restored = WorldSnapshot::Restore(target, corrupt.data(), corrupt.size());
+        assert(!restored && message);
+        assert(target.GetEntityCount() == 1 && target.GetComponent<SnapshotPosition>(existing)->x == 42.0f && "Rejected snapshot should not touch the world");
+        (void)restored;
+        (void)message;
+    };
+
+    std::vector<uint8_t> corrupt = data;
+    const uint32_t bad_slot = 1000;
+    std::memcpy(corrupt.data() + column.sparse_offset, &bad_slot, sizeof(bad_slot));
+    expect_rejected(corrupt, "Sparse entry past the dense array should be rejected");
+
+    corrupt = data;
+    const uint32_t bad_owner = 3;
+    std::memcpy(corrupt.data() + column.owners_offset, &bad_owner, sizeof(bad_owner));
+    expect_rejected(corrupt, "Owner that disagrees with the sparse array should be rejected");
+
+    corrupt = data;
+    SnapshotColumn huge = column;
+    huge.element_size = 16;
+    huge.count = (UINT64_MAX / 16) + 2; // count * element_size wraps to a small number
+    std::memcpy(corrupt.data() + header.columns_offset, &huge, sizeof(huge));
+    expect_rejected(corrupt, "Overflowing column size should be rejected");
+
+    corrupt = data;
+    SnapshotHeader wrapped = header;
+    wrapped.free_count = (UINT64_MAX / 4) + 1;
+    std::memcpy(corrupt.data(), &wrapped, sizeof(wrapped));
+    expect_rejected(corrupt, "Overflowing free list size should be rejected");
+}
+
+void test_snapshot_large_world() {
+    const int count = 500000;
+    World world;
+    for (int i = 0; i < count; ++i) {
+        EntityId entity = world.CreateEntity();
+        world.AddComponent<SnapshotPosition>(entity, float(i), 0.0f);
+        world.AddComponent<SnapshotLabel>(entity, utils::FixedString<15>("bulk"), i);
+    }
+
+    const std::string path = snapshot_path();
+    auto start = std::chrono::steady_clock::now();
+    const bool saved = WorldSnapshot::Save(world, path);
+    assert(saved && "Large snapshot should be saved");
+    (void)saved;
+    auto saved_at = std::chrono::steady_clock::now();
+
+    World loaded;
+    loaded.RegisterComponent<SnapshotPosition>();
+    loaded.RegisterComponent<SnapshotLabel>();
+    const bool restored = WorldSnapshot::Load(loaded, path);
+    assert(restored && "Large snapshot should load");
+    (void)restored;
+    auto end = std::chrono::steady_clock::now();
+
+    assert(loaded.GetEntityCount() == size_t(count) && "All entities should load");
+    assert(loaded.GetComponent<SnapshotLabel>(EntityId{ count - 1, 0 })->layer == count - 1 && "Last entity should load");
+    std::cout << "  500k entities: save "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(saved_at - start).count() << " ms, load "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(end - saved_at).count() << " ms" << std::endl;
+    std::remove(path.c_str());
+}
+
+} // namespace tests
+} // namespace entities
+
+int main() {
+    std::cout << "Running world snapshot test..." << std::endl;
+    entities::tests::test_snapshot_round_trip();
+    entities::tests::test_snapshot_rejects_bad_input();
+    entities::tests::test_snapshot_rejects_corrupt_columns();
+    entities::tests::test_snapshot_large_world();
+    std::cout << "World snapshot test passed!" << std::endl;
+    return 0;
+}
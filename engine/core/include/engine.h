@@ -1,9 +1,15 @@
 #pragma once
 
 #include "entity_manager.h"
+#include "world.h"
 #include "job_scheduler.h"
 #include "renderer.h"
 #include <memory>
+#include <functional>
+#include "fixed_timestep.h"
+#include "frame_pipeline.h"
+#include "sprite.h"
+#include <vector>
 
 #include "vulkan_rendering_context.h"
 #include "input_manager.h"
@@ -12,6 +18,13 @@ namespace engine {
 // Forward declaration for window class
 class glfw_window;
 
+// Snapshot handed from simulation to rendering each frame
+struct FrameRenderState {
+    uint64_t simulationStep = 0;           // fixed steps completed when the state was extracted
+    float interpolationAlpha = 0.0f;       // FixedTimestep alpha at extraction; use this for render interpolation
+    std::vector<graphics::SpriteDesc> sprites; // filled by the extract callback
+};
+
 class Engine {
 public:
     Engine();
@@ -23,11 +36,37 @@ public:
     // Shutdown the engine
     void shutdown();
     
-    // Run a single frame of the engine
+    // Run the main loop until the window is closed
+    void run();
+
+    // Run a single frame of the engine: as many fixed simulation steps as are due, then render,
+    // then process completed jobs (JobScheduler::Update) on the calling thread
     void update(float deltaTime);
+
+    // Called once per fixed simulation step with the fixed delta time
+    void setSimulationCallback(std::function<void(float)> callback) { m_simulationCallback = std::move(callback); }
+
+    // Fixed simulation step in seconds (default 1/60)
+    void setFixedTimestep(double seconds) { m_timestep.setStep(seconds); }
+    // Main thread only, outside update(): in pipelined mode the simulation job advances the
+    // timestep while the frame renders. Render code reads FrameRenderState::interpolationAlpha.
+    FixedTimestep& getTimestep() { return m_timestep; }
+
+    // Copies simulation results into the render state; runs right after the simulation steps
+    void setRenderExtractCallback(std::function<void(FrameRenderState&)> callback) { m_extractCallback = std::move(callback); }
+
+    // Consumes the render state on the render side, before the renderer records the frame
+    void setRenderCallback(std::function<void(const FrameRenderState&)> callback) { m_renderCallback = std::move(callback); }
+
+    // Pipelined mode: simulate frame N+1 on the job system while frame N renders.
+    // Rendering then trails simulation by one frame.
+    void setPipelined(bool enabled);
+    bool isPipelined() const { return m_framePipeline && m_framePipeline->isPipelined(); }
     
-    //TODO: handle the entity manager memory on engine instead of using a singleton
-    // Get entity manager
+    // Get the engine's ECS world (owned by the engine, not a singleton)
+    entities::World& getWorld() { return m_world; }
+
+    // Get entity manager (legacy string-id entities, process-wide singleton)
     entities::EntityManager& getEntityManager() { return entities::EntityManager::getInstance(); }
     
     // Get job scheduler
@@ -38,10 +77,20 @@ public:
 
 private:
     std::unique_ptr<JobSystem::JobScheduler> m_jobScheduler;
+    entities::World m_world;
     bool m_initialized;
     std::shared_ptr<glfw_window> m_window;
 	std::unique_ptr<Renderer> m_renderer;
     InputManager m_inputManager;
+    FixedTimestep m_timestep;
+    std::function<void(float)> m_simulationCallback;
+    std::function<void(FrameRenderState&)> m_extractCallback;
+    std::function<void(const FrameRenderState&)> m_renderCallback;
+    std::unique_ptr<FramePipeline<FrameRenderState>> m_framePipeline;
+    bool m_pipelined = false;
+
+    void simulateFrame(float deltaTime, FrameRenderState& next);
+    void renderFrame(const FrameRenderState& current);
 };
 
 } // namespace engine
\ No newline at end of file
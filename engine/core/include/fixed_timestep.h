@@ -0,0 +1,87 @@
+#pragma once
+#include <cstdint>
+#include <cmath>
+
+namespace engine {
+
+/**
+ * @brief Fixed-timestep accumulator
+ *
+ * Variable frame times are accumulated and consumed in whole simulation steps
+ * of a constant size, so simulation results do not depend on the render rate.
+ * Frame time is clamped to maxSteps * step before it is accumulated: after a
+ * long stall (debugger, loading hitch) the simulation falls behind real time
+ * instead of trying to catch up with an ever growing number of steps.
+ * getAlpha() is the fraction of a step left in the accumulator, used to
+ * interpolate between the previous and current simulation state when rendering.
+ */
+class FixedTimestep {
+public:
+    static constexpr double DEFAULT_STEP = 1.0 / 60.0;
+    static constexpr uint32_t DEFAULT_MAX_STEPS = 5;
+
+    explicit FixedTimestep(double step = DEFAULT_STEP, uint32_t maxSteps = DEFAULT_MAX_STEPS)
+        : m_step(step > 0.0 ? step : DEFAULT_STEP), m_maxSteps(maxSteps > 0 ? maxSteps : 1) {}
+
+    // Accumulate a frame's elapsed time and return how many fixed steps are due
+    uint32_t advance(double frameSeconds) {
+        if (!(frameSeconds > 0.0)) {
+            return 0;
+        }
+        const double maxFrame = m_step * m_maxSteps;
+        if (frameSeconds > maxFrame) {
+            m_droppedTime += frameSeconds - maxFrame;
+            frameSeconds = maxFrame;
+        }
+        m_accumulator += frameSeconds;
+
+        uint32_t steps = static_cast<uint32_t>(std::floor(m_accumulator / m_step));
+        if (steps > m_maxSteps) {
+            steps = m_maxSteps;
+        }
+        m_accumulator -= steps * m_step;
+        m_totalSteps += steps;
+        return steps;
+    }
+
+    // Advance and invoke `stepFunc(float dt)` once per due step; returns the number of steps run
+    template<typename StepFunc>
+    uint32_t update(double frameSeconds, StepFunc&& stepFunc) {
+        const uint32_t steps = advance(frameSeconds);
+        const float dt = static_cast<float>(m_step);
+        for (uint32_t i = 0; i < steps; ++i) {
+            stepFunc(dt);
+        }
+        return steps;
+    }
+
+    // Interpolation factor in [0, 1) between the last two simulation states
+    float getAlpha() const { return static_cast<float>(m_accumulator / m_step); }
+
+    double getStep() const { return m_step; }
+    void setStep(double step) { if (step > 0.0) m_step = step; }
+    uint32_t getMaxSteps() const { return m_maxSteps; }
+    void setMaxSteps(uint32_t maxSteps) { m_maxSteps = maxSteps > 0 ? maxSteps : 1; }
+
+    // Total fixed steps taken since construction/reset
+    uint64_t getTotalSteps() const { return m_totalSteps; }
+    // Simulation time, an exact multiple of the step
+    double getSimulationTime() const { return m_totalSteps * m_step; }
+    // Real time discarded by the clamp
+    double getDroppedTime() const { return m_droppedTime; }
+
+    void reset() {
+        m_accumulator = 0.0;
+        m_droppedTime = 0.0;
+        m_totalSteps = 0;
+    }
+
+private:
+    double m_step;
+    uint32_t m_maxSteps;
+    double m_accumulator = 0.0;
+    double m_droppedTime = 0.0;
+    uint64_t m_totalSteps = 0;
+};
+
+} // namespace engine
@@ -0,0 +1,136 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include "job_scheduler.h"
+
+namespace engine {
+
+/**
+ * @brief Overlaps simulation of the next frame with rendering of the current one
+ *
+ * Holds two copies of a render state. Each frame, the simulate callback runs
+ * as a job on the JobScheduler and writes the back state, while the render
+ * callback consumes the front state on the calling thread; the states are
+ * swapped once both are done. Rendering therefore trails simulation by one
+ * frame, and the two callbacks must not share mutable data other than through
+ * the state they are given.
+ *
+ * The first frame after enabling pipelining runs serially to fill the front
+ * state, so the following frame shows that state a second time.
+ *
+ * With pipelining disabled (or fewer than two scheduler threads, so jobs the
+ * simulation schedules itself can still make progress) both callbacks run
+ * serially on the calling thread against a single state.
+ *
+ * @tparam State Render snapshot produced by simulation; reused frame to frame,
+ *               so containers inside it keep their capacity
+ */
+template<typename State>
+class FramePipeline {
+public:
+    using SimulateFunc = std::function<void(float deltaTime, State& next)>;
+    using RenderFunc = std::function<void(const State& current)>;
+
+    explicit FramePipeline(JobSystem::JobScheduler& scheduler)
+        : m_scheduler(scheduler) {}
+
+    ~FramePipeline() { wait(); }
+
+    FramePipeline(const FramePipeline&) = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+
+    void setSimulate(SimulateFunc simulate) { m_simulate = std::move(simulate); }
+    void setRender(RenderFunc render) { m_render = std::move(render); }
+
+    void setPipelined(bool enabled) {
+        wait();
+        m_pipelined = enabled;
+    }
+
+    // True when frames actually overlap simulation and rendering
+    bool isPipelined() const {
+        return m_pipelined && m_scheduler.GetThreadCount() >= 2;
+    }
+
+    // Run one frame
+    void frame(float deltaTime) {
+        if (!isPipelined() || !m_primed) {
+            // Serial frame; also primes the pipeline so the first pipelined frame has something to render
+            simulate(deltaTime, m_states[m_front]);
+            render(m_states[m_front]);
+            m_primed = isPipelined();
+            ++m_frameCount;
+            return;
+        }
+
+        const uint32_t back = m_front ^ 1u;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_inFlight = true;
+        }
+        m_scheduler.ScheduleJob(new SimulationJob(*this, deltaTime, m_states[back]));
+
+        render(m_states[m_front]);
+
+        wait();
+        m_front = back;
+        ++m_frameCount;
+    }
+
+    // Block until the in-flight simulation (if any) has finished
+    void wait() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this] { return !m_inFlight; });
+    }
+
+    // State most recently handed to (or about to be handed to) the render callback
+    const State& getRenderState() const { return m_states[m_front]; }
+    uint64_t getFrameCount() const { return m_frameCount; }
+
+private:
+    class SimulationJob : public JobSystem::JobBase {
+    public:
+        SimulationJob(FramePipeline& pipeline, float deltaTime, State& next)
+            : JobBase("FrameSimulation"), m_pipeline(pipeline), m_deltaTime(deltaTime), m_next(next) {}
+
+        void Execute(float) override {
+            m_pipeline.simulate(m_deltaTime, m_next);
+            // Notify under the lock: once wait() returns the pipeline may be destroyed
+            std::lock_guard<std::mutex> lock(m_pipeline.m_mutex);
+            m_pipeline.m_inFlight = false;
+            m_pipeline.m_done.notify_all();
+        }
+
+        void RefreshCache() override {}
+
+    private:
+        FramePipeline& m_pipeline;
+        float m_deltaTime;
+        State& m_next;
+    };
+
+    void simulate(float deltaTime, State& next) {
+        if (m_simulate) m_simulate(deltaTime, next);
+    }
+
+    void render(const State& current) {
+        if (m_render) m_render(current);
+    }
+
+    JobSystem::JobScheduler& m_scheduler;
+    SimulateFunc m_simulate;
+    RenderFunc m_render;
+    State m_states[2];
+    uint32_t m_front = 0;
+    bool m_pipelined = false;
+    bool m_primed = false;
+    uint64_t m_frameCount = 0;
+
+    std::mutex m_mutex;
+    std::condition_variable m_done;
+    bool m_inFlight = false;
+};
+
+} // namespace engine
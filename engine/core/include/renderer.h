@@ -3,6 +3,7 @@
 #include "camera.h"
 #include "input_manager.h"
 #include <chrono>
+#include "utils/profiler.h"
 
 namespace engine {
 
@@ -14,7 +15,16 @@ namespace engine {
             bool initialize(const glfw_window& window) {
                 m_renderingContext = std::make_unique<graphics::VulkanRenderingContext>(window);
 				m_camera = std::make_unique<engine::Camera>();
-                setupCamera(window);
+                int width, height; window.getWindowSize(&width, &height);
+                setupCamera(width, height);
+                return m_renderingContext->initialize();
+            }
+
+            // Headless rendering to offscreen images, for benchmarks and image tests without a display
+            bool initializeOffscreen(uint32_t width, uint32_t height) {
+                m_renderingContext = std::make_unique<graphics::VulkanRenderingContext>(width, height);
+                m_camera = std::make_unique<engine::Camera>();
+                setupCamera(static_cast<int>(width), static_cast<int>(height));
                 return m_renderingContext->initialize();
             }
 
@@ -25,6 +35,7 @@ namespace engine {
             }
 
             void render() {
+                PROFILE_ZONE("Renderer::render");
                 if (m_renderingContext) {
 					auto tStart = std::chrono::high_resolution_clock::now();
                     
@@ -57,6 +68,7 @@ namespace engine {
             }
 
             Camera& getCamera() { return *m_camera; }
+            graphics::VulkanRenderingContext* getRenderingContext() { return m_renderingContext.get(); }
 
             void UpdateCameraInput(const engine::InputManager& inputManager) {
                 if (m_camera) {
@@ -71,8 +83,7 @@ namespace engine {
         std::unique_ptr<graphics::VulkanRenderingContext> m_renderingContext;
         std::unique_ptr<engine::Camera> m_camera;
         
-        void setupCamera(const glfw_window& window) {
-            int width, height; window.getWindowSize(&width, &height);
+        void setupCamera(int width, int height) {
             m_camera->type = engine::Camera::CameraType::firstperson; // enable movement
             m_camera->flipY = true;
             float aspectRatio = static_cast<float>(width) / static_cast<float>(height);
@@ -1,7 +1,10 @@
 #include "engine.h"
 #include "logger.h"
 #include "LogMacros.h"
+#include "BinaryLog.h"
+#include "profiler.h"
 #include "window.h"
+#include <chrono>
 
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
@@ -66,19 +69,10 @@ bool Engine::initialize() {
         return false;
     }
 
-    while (!m_window->shouldClose()) {
-#ifdef DEBUG
-        // Update camera movement based on input
-        if (m_renderer) {
-			m_renderer->UpdateCameraInput(m_inputManager);
-        }
-#endif
-
-		m_renderer->render();
-        m_window->pollEvents();
-        m_inputManager.endFrame();
-    }
-	m_window->shutdown();
+    m_framePipeline = std::make_unique<FramePipeline<FrameRenderState>>(*m_jobScheduler);
+    m_framePipeline->setSimulate([this](float deltaTime, FrameRenderState& next) { simulateFrame(deltaTime, next); });
+    m_framePipeline->setRender([this](const FrameRenderState& current) { renderFrame(current); });
+    m_framePipeline->setPipelined(m_pipelined);
 
     LOG_INFO << "Engine initialized successfully" << LOG_END;
     m_initialized = true;
@@ -92,18 +86,88 @@ void Engine::shutdown() {
     }
     
     LOG_INFO << "Shutting down engine" << LOG_END;
-    
+
+    if (m_framePipeline) {
+        m_framePipeline->wait();
+    }
+
+    if (m_window) {
+        m_window->shutdown();
+    }
     m_initialized = false;
     LOG_INFO << "Engine shutdown completed" << LOG_END;
 }
 
+void Engine::run() {
+    if (!m_initialized) {
+        LOG_ERROR << "Cannot run: Engine is not initialized" << LOG_END;
+        return;
+    }
+
+    auto lastFrame = std::chrono::steady_clock::now();
+    while (!m_window->shouldClose()) {
+        auto now = std::chrono::steady_clock::now();
+        float deltaTime = std::chrono::duration<float>(now - lastFrame).count();
+        lastFrame = now;
+
+        update(deltaTime);
+        m_window->pollEvents();
+        m_inputManager.endFrame();
+    }
+}
+
 void Engine::update(float deltaTime) {
     if (!m_initialized) {
         LOG_ERROR << "Cannot update: Engine is not initialized" << LOG_END;
         return;
     }
-    
-    m_jobScheduler->Update(deltaTime);
+
+    m_framePipeline->frame(deltaTime);
+    // Completion callbacks (PostExecute, System::OnJobsCompleted) run on the main thread, between
+    // frames: in pipelined mode the simulation runs on a job worker, and no simulation is in flight here
+    m_jobScheduler->Update(static_cast<float>(m_timestep.getStep()));
+}
+
+void Engine::setPipelined(bool enabled) {
+    m_pipelined = enabled;
+    if (m_framePipeline) {
+        m_framePipeline->setPipelined(enabled);
+        if (enabled && !m_framePipeline->isPipelined()) {
+            LOG_WARNING << "Pipelined mode needs at least two job threads, running serially" << LOG_END;
+        }
+    }
+}
+
+void Engine::simulateFrame(float deltaTime, FrameRenderState& next) {
+    PROFILE_ZONE("Engine::simulateFrame");
+    // Simulation advances in fixed steps, decoupled from the render rate;
+    // frames shorter than a step only render
+    m_timestep.update(deltaTime, [this](float fixedDeltaTime) {
+        PROFILE_ZONE("Engine::fixedStep");
+        if (m_simulationCallback) {
+            m_simulationCallback(fixedDeltaTime);
+        }
+    });
+
+    next.simulationStep = m_timestep.getTotalSteps();
+    next.interpolationAlpha = m_timestep.getAlpha();
+    if (m_extractCallback) {
+        m_extractCallback(next);
+    }
+}
+
+void Engine::renderFrame(const FrameRenderState& current) {
+    PROFILE_ZONE("Engine::renderFrame");
+    LOG_TRACE("render step {} sprites {}", current.simulationStep, current.sprites.size());
+#ifdef DEBUG
+    // Update camera movement based on input
+    if (m_renderer) {
+        m_renderer->UpdateCameraInput(m_inputManager);
+    }
+#endif
+    if (m_renderCallback) {
+        m_renderCallback(current);
+    }
     m_renderer->render();
 }
 
@@ -33,19 +33,28 @@ public:
 
     // Check if an entity has all components of this archetype
     static bool HasComponents(const std::string& entity_id) {
-        return (HasComponent<Components>(entity_id) && ...);
+        return EntitySignatures::Matches(entity_id, Signature());
     }
 
-    // Get a specific component for an entity
+    // Signature with the bit of every component in this archetype
+    static const ComponentSignature& Signature() {
+        static const ComponentSignature signature = MakeSignature<Components...>();
+        return signature;
+    }
+
+    // Get all entities that own every component of this archetype
+    static std::vector<std::string> Query() {
+        return EntitySignatures::Query(Signature());
+    }
+
+    // Get a specific component for an entity. Reads the component's owner registry, the
+    // same source as the signatures behind HasComponents, so a component the entity got
+    // through another archetype is found too
     template<typename T>
     static T* GetComponent(const std::string& entity_id) {
         static_assert((std::is_same_v<T, Components> || ...), 
             "Component type not in archetype");
-        auto it = component_maps<T>.find(entity_id);
-        if (it != component_maps<T>.end()) {
-            return it->second;
-        }
-        return nullptr;
+        return T::FindByOwner(entity_id);
     }
 
     // Get all entities that have a specific component
@@ -101,12 +110,6 @@ private:
             T::UnregisterOwner(entity_id);
         }
     }
-
-    // Helper to check if an entity has a specific component
-    template<typename T>
-    static bool HasComponent(const std::string& entity_id) {
-        return component_maps<T>.find(entity_id) != component_maps<T>.end();
-    }
 };
 
 // Macro to define an archetype
@@ -6,6 +6,9 @@
 #include <vector>
 #include <map>
 #include "pool.h"
+#include "component_type.h"
+#include "utils/fixed_string.h"
+#include "utils/name_handle.h"
 
 namespace entities {
 
@@ -59,6 +62,24 @@ struct Member : ValidatedMember {
     operator const T&() const { return value; }
 };
 
+// Type trait to check if T is a valid POD component member.
+// Anything trivially copyable qualifies (arithmetic types, enums, utils::FixedString,
+// utils::NameHandle, glm::vec2/vec3, ...). Raw pointers are rejected because they
+// cannot survive a memcpy into another process or a snapshot.
+template<typename T>
+struct is_valid_pod_member {
+    static constexpr bool value = std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>;
+};
+
+template<typename T>
+inline constexpr bool is_valid_pod_member_v = is_valid_pod_member<T>::value;
+
+// A POD component has no vtable and can be relocated with memcpy
+template<typename T>
+inline constexpr bool is_pod_component_v = std::is_trivially_copyable_v<T> &&
+                                           std::is_standard_layout_v<T> &&
+                                           !std::is_polymorphic_v<T>;
+
 // Helper to check if all data members of a class are ValidatedMembers
 template<typename T>
 struct has_only_validated_members {
@@ -96,16 +117,20 @@ public:
 
 #define COMPONENT_MEMBER_DEFAULT(Type, Name, Default) detail::Member<Type> Name = Default
 
-#define DEFINE_COMPONENT(Name, PoolSize) \
-    struct Name : public Component<Name> { \
+// Static storage and API shared by DEFINE_COMPONENT and DEFINE_POD_COMPONENT
+#define COMPONENT_STORAGE(Name, PoolSize) \
         static inline entities::Pool<Name> pool{PoolSize}; \
         static inline std::map<std::string, Name*> component_map; \
+        static inline const entities::ComponentTypeId type_id = entities::GetComponentTypeId<Name>(); \
+        static entities::ComponentTypeId TypeId() { return entities::GetComponentTypeId<Name>(); } \
+        static const char* TypeName() { return #Name; } \
         static Name* Create() { return pool.Create(); } \
         template<typename... Args> \
         static Name* Create(Args&&... args) { return pool.Create(std::forward<Args>(args)...); } \
         static void Destroy(Name* component) { \
             const std::string* owner = FindOwnerEntity(component); \
             if (owner) { \
+                entities::EntitySignatures::Remove(*owner, TypeId()); \
                 component_map.erase(*owner); \
             } \
             pool.Destroy(component); \
@@ -126,17 +151,48 @@ public:
         static const std::string* FindOwnerEntity(Name* component) { \
             return FindOwnerEntity(static_cast<const Name*>(component)); \
         } \
+        static Name* FindByOwner(const std::string& entity_id) { \
+            auto it = component_map.find(entity_id); \
+            return it != component_map.end() ? it->second : nullptr; \
+        } \
         static void RegisterOwner(const std::string& entity_id, Name* component) { \
             if (component) { \
                 component_map[entity_id] = component; \
+                entities::EntitySignatures::Add(entity_id, TypeId()); \
             } \
         } \
         static void UnregisterOwner(const std::string& entity_id) { \
-            component_map.erase(entity_id); \
+            if (component_map.erase(entity_id) > 0) { \
+                entities::EntitySignatures::Remove(entity_id, TypeId()); \
+            } \
         }
 
+#define DEFINE_COMPONENT(Name, PoolSize) \
+    struct Name : public Component<Name> { \
+        COMPONENT_STORAGE(Name, PoolSize)
+
 #define END_COMPONENT };
 
+// POD components: no base class, no vtable, trivially copyable.
+// Instances can be memcpy'd, packed densely in their pool and processed with SIMD.
+// Members are declared with POD_MEMBER and must satisfy detail::is_valid_pod_member.
+#define POD_MEMBER(Type, Name) \
+    static_assert(detail::is_valid_pod_member_v<Type>, \
+        "POD component members must be trivially copyable and not raw pointers"); \
+    Type Name
+
+#define POD_MEMBER_DEFAULT(Type, Name, Default) POD_MEMBER(Type, Name) = Default
+
+#define DEFINE_POD_COMPONENT(Name, PoolSize) \
+    struct Name { \
+        COMPONENT_STORAGE(Name, PoolSize) \
+        static void AssertPodLayout() { \
+            static_assert(detail::is_pod_component_v<Name>, \
+                #Name " must be trivially copyable, standard layout and non-polymorphic"); \
+        }
+
+#define END_POD_COMPONENT };
+
 /*
  * Example usage:
  * 
@@ -152,4 +208,11 @@ public:
  *     COMPONENT_MEMBER_DEFAULT(float, health, 100.0f);
  *     COMPONENT_MEMBER_DEFAULT(bool, isActive, true);
  * END_COMPONENT
+ *
+ * DEFINE_POD_COMPONENT(SpriteComponent, 100000)
+ *     POD_MEMBER(glm::vec2, position);
+ *     POD_MEMBER_DEFAULT(glm::vec2, scale, glm::vec2(1.0f));
+ *     POD_MEMBER(utils::FixedString<15>, label);
+ *     POD_MEMBER(utils::NameHandle, atlas);
+ * END_POD_COMPONENT
  */ 
\ No newline at end of file
@@ -0,0 +1,150 @@
+#pragma once
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+// Upper bound on distinct component types; sizes every signature bitset
+#ifndef ENTITIES_MAX_COMPONENT_TYPES
+#define ENTITIES_MAX_COMPONENT_TYPES 64
+#endif
+
+namespace entities {
+
+using ComponentTypeId = uint32_t;
+constexpr size_t MAX_COMPONENT_TYPES = ENTITIES_MAX_COMPONENT_TYPES;
+constexpr ComponentTypeId INVALID_COMPONENT_TYPE = UINT32_MAX;
+
+// One bit per component type; an entity's signature has the bit of every component it owns
+using ComponentSignature = std::bitset<MAX_COMPONENT_TYPES>;
+
+// Hands out component type ids in registration order
+class ComponentTypeRegistry {
+public:
+    // Running out of ids aborts in every build: a wrapped or out-of-range id would
+    // alias another type's signature bit and store. Most ids are handed out during
+    // static initialization, before the logger exists, so this reports to stderr.
+    static ComponentTypeId Next() {
+        ComponentTypeId id = next_id.fetch_add(1, std::memory_order_relaxed);
+        if (id >= MAX_COMPONENT_TYPES) {
+            std::fprintf(stderr, "Too many component types (limit %zu), raise ENTITIES_MAX_COMPONENT_TYPES\n", MAX_COMPONENT_TYPES);
+            std::abort();
+        }
+        return id;
+    }
+
+    static size_t Count() {
+        return next_id.load(std::memory_order_relaxed);
+    }
+
+private:
+    static inline std::atomic<ComponentTypeId> next_id{ 0 };
+};
+
+/**
+ * @brief Dense id of a component type, assigned on first use
+ *
+ * Components declared with DEFINE_COMPONENT / DEFINE_POD_COMPONENT register
+ * during static initialization, so ids are contiguous from 0. Ids depend on
+ * registration order and are not stable across builds.
+ */
+template<typename T>
+ComponentTypeId GetComponentTypeId() {
+    static const ComponentTypeId id = ComponentTypeRegistry::Next();
+    return id;
+}
+
+template<typename T, typename = void>
+struct has_type_name : std::false_type {};
+
+template<typename T>
+struct has_type_name<T, std::void_t<decltype(T::TypeName())>> : std::true_type {};
+
+// Stable name of a component type; DEFINE_COMPONENT types provide TypeName(), others fall back to RTTI
+template<typename T>
+const char* ComponentTypeName() {
+    if constexpr (has_type_name<T>::value) {
+        return T::TypeName();
+    } else {
+        return typeid(T).name();
+    }
+}
+
+// Layout version of a component, recorded in snapshots. Specialize and bump it when a component's members change.
+template<typename T>
+struct ComponentSchemaVersion {
+    static constexpr uint32_t value = 1;
+};
+
+// Build the signature for a set of component types
+template<typename... Components>
+ComponentSignature MakeSignature() {
+    ComponentSignature signature;
+    (signature.set(GetComponentTypeId<Components>()), ...);
+    return signature;
+}
+
+// True when `signature` contains every component in `query`
+inline bool SignatureMatches(const ComponentSignature& signature, const ComponentSignature& query) {
+    return (signature & query) == query;
+}
+
+/**
+ * @brief Per-entity component signatures
+ *
+ * Kept up to date by the component owner registration (RegisterOwner/UnregisterOwner),
+ * so matching an entity against a query is one lookup plus an AND/compare instead
+ * of one map lookup per component type.
+ */
+class EntitySignatures {
+public:
+    static void Add(const std::string& entity_id, ComponentTypeId type) {
+        signatures[entity_id].set(type);
+    }
+
+    static void Remove(const std::string& entity_id, ComponentTypeId type) {
+        auto it = signatures.find(entity_id);
+        if (it == signatures.end()) return;
+        it->second.reset(type);
+        if (it->second.none()) {
+            signatures.erase(it);
+        }
+    }
+
+    static ComponentSignature Get(const std::string& entity_id) {
+        auto it = signatures.find(entity_id);
+        return it != signatures.end() ? it->second : ComponentSignature{};
+    }
+
+    static bool Matches(const std::string& entity_id, const ComponentSignature& query) {
+        auto it = signatures.find(entity_id);
+        if (it == signatures.end()) return query.none();
+        return SignatureMatches(it->second, query);
+    }
+
+    // Linear scan over all signatures; each entity costs a single AND/compare
+    static std::vector<std::string> Query(const ComponentSignature& query) {
+        std::vector<std::string> result;
+        for (const auto& [entity_id, signature] : signatures) {
+            if (SignatureMatches(signature, query)) {
+                result.push_back(entity_id);
+            }
+        }
+        return result;
+    }
+
+    static void Clear() {
+        signatures.clear();
+    }
+
+private:
+    static inline std::unordered_map<std::string, ComponentSignature> signatures;
+};
+
+} // namespace entities
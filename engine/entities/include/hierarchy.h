@@ -0,0 +1,377 @@
+#pragma once
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "job_scheduler.h"
+#include "utils/LogMacros.h"
+
+namespace entities {
+
+// 2D transform used by the hierarchy; kept trivially copyable so it can live in POD components
+struct Transform2D {
+    float x = 0.0f;
+    float y = 0.0f;
+    float rotation = 0.0f; // radians
+    float scaleX = 1.0f;
+    float scaleY = 1.0f;
+};
+
+// Compose a child's local transform with its parent's world transform
+inline Transform2D CombineTransforms(const Transform2D& parent, const Transform2D& local) {
+    const float c = std::cos(parent.rotation);
+    const float s = std::sin(parent.rotation);
+    const float lx = local.x * parent.scaleX;
+    const float ly = local.y * parent.scaleY;
+
+    Transform2D world;
+    world.x = parent.x + lx * c - ly * s;
+    world.y = parent.y + lx * s + ly * c;
+    world.rotation = parent.rotation + local.rotation;
+    world.scaleX = parent.scaleX * local.scaleX;
+    world.scaleY = parent.scaleY * local.scaleY;
+    return world;
+}
+
+class TransformHierarchy;
+
+// Propagates world transforms for one contiguous range of a hierarchy level
+class TransformPropagationJob : public JobSystem::JobBase {
+public:
+    TransformPropagationJob(TransformHierarchy& hierarchy, uint32_t begin, uint32_t end, std::atomic<uint32_t>& pending)
+        : JobBase("TransformPropagationJob"), m_hierarchy(hierarchy), m_begin(begin), m_end(end), m_pending(pending) {}
+
+    void Execute(float dt) override;
+    void RefreshCache() override {}
+
+private:
+    TransformHierarchy& m_hierarchy;
+    uint32_t m_begin;
+    uint32_t m_end;
+    std::atomic<uint32_t>& m_pending;
+};
+
+/**
+ * @brief Parent/child relationships between entities with breadth-first transform storage
+ *
+ * Relationships are authored by entity id (Attach/Detach). Before traversal the
+ * hierarchy is flattened breadth-first into contiguous arrays: all nodes of a
+ * level are adjacent, the children of a node occupy one contiguous range
+ * [FirstChild, FirstChild + ChildCount), and every parent sits in an earlier
+ * level than its children. Propagation is therefore a linear sweep per level
+ * that only reads world transforms written by the previous level, which is what
+ * lets the parallel path split each level into independent jobs.
+ *
+ * The flattened layout is rebuilt lazily after structural changes; SetLocal
+ * writes straight into it.
+ */
+class TransformHierarchy {
+public:
+    static constexpr uint32_t INVALID_NODE = UINT32_MAX;
+    // Levels smaller than this are propagated on the calling thread
+    static constexpr uint32_t DEFAULT_GRAIN = 256;
+
+    // Add an entity as a root; returns false if it is already in the hierarchy
+    bool Add(const std::string& entity_id, const Transform2D& local = {}) {
+        if (m_slots.find(entity_id) != m_slots.end()) {
+            return false;
+        }
+        uint32_t slot;
+        if (!m_freeSlots.empty()) {
+            slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        } else {
+            slot = static_cast<uint32_t>(m_ids.size());
+            m_ids.emplace_back();
+            m_parents.push_back(INVALID_NODE);
+            m_locals.emplace_back();
+            m_alive.push_back(false);
+            m_flatIndexOfSlot.push_back(INVALID_NODE);
+        }
+        m_ids[slot] = entity_id;
+        m_parents[slot] = INVALID_NODE;
+        m_locals[slot] = local;
+        m_alive[slot] = true;
+        m_flatIndexOfSlot[slot] = INVALID_NODE;
+        m_slots.emplace(entity_id, slot);
+        m_dirty = true;
+        return true;
+    }
+
+    // Remove an entity; its children become roots and keep their local transforms
+    void Remove(const std::string& entity_id) {
+        auto it = m_slots.find(entity_id);
+        if (it == m_slots.end()) return;
+        const uint32_t slot = it->second;
+        for (uint32_t i = 0; i < m_parents.size(); ++i) {
+            if (m_alive[i] && m_parents[i] == slot) {
+                m_parents[i] = INVALID_NODE;
+            }
+        }
+        m_alive[slot] = false;
+        m_parents[slot] = INVALID_NODE;
+        m_ids[slot].clear();
+        m_flatIndexOfSlot[slot] = INVALID_NODE;
+        m_freeSlots.push_back(slot);
+        m_slots.erase(it);
+        m_dirty = true;
+    }
+
+    bool Contains(const std::string& entity_id) const {
+        return m_slots.find(entity_id) != m_slots.end();
+    }
+
+    // Make `child` a child of `parent`; rejects unknown ids and cycles
+    bool Attach(const std::string& child_id, const std::string& parent_id) {
+        auto child = m_slots.find(child_id);
+        auto parent = m_slots.find(parent_id);
+        if (child == m_slots.end() || parent == m_slots.end()) {
+            LOG_WARNING << "Attach failed, entity not in hierarchy: " << child_id << " -> " << parent_id << LOG_END;
+            return false;
+        }
+        // Walk up from the new parent; meeting the child means the link would close a cycle
+        for (uint32_t node = parent->second; node != INVALID_NODE; node = m_parents[node]) {
+            if (node == child->second) {
+                LOG_WARNING << "Attach failed, " << parent_id << " is a descendant of " << child_id << LOG_END;
+                return false;
+            }
+        }
+        if (m_parents[child->second] != parent->second) {
+            m_parents[child->second] = parent->second;
+            m_dirty = true;
+        }
+        return true;
+    }
+
+    // Turn an entity back into a root
+    void Detach(const std::string& child_id) {
+        auto it = m_slots.find(child_id);
+        if (it == m_slots.end() || m_parents[it->second] == INVALID_NODE) return;
+        m_parents[it->second] = INVALID_NODE;
+        m_dirty = true;
+    }
+
+    // Parent entity id, or an empty string for roots and unknown entities
+    std::string GetParent(const std::string& entity_id) const {
+        auto it = m_slots.find(entity_id);
+        if (it == m_slots.end() || m_parents[it->second] == INVALID_NODE) return {};
+        return m_ids[m_parents[it->second]];
+    }
+
+    // Direct children in flattened order
+    std::vector<std::string> GetChildren(const std::string& entity_id) {
+        std::vector<std::string> children;
+        auto it = m_slots.find(entity_id);
+        if (it == m_slots.end()) return children;
+        Flatten();
+        const uint32_t node = m_flatIndexOfSlot[it->second];
+        for (uint32_t i = m_firstChild[node]; i < m_firstChild[node] + m_childCount[node]; ++i) {
+            children.push_back(m_ids[m_order[i]]);
+        }
+        return children;
+    }
+
+    bool SetLocal(const std::string& entity_id, const Transform2D& local) {
+        auto it = m_slots.find(entity_id);
+        if (it == m_slots.end()) return false;
+        m_locals[it->second] = local;
+        if (!m_dirty) {
+            m_flatLocals[m_flatIndexOfSlot[it->second]] = local;
+        }
+        return true;
+    }
+
+    const Transform2D* GetLocal(const std::string& entity_id) const {
+        auto it = m_slots.find(entity_id);
+        return it != m_slots.end() ? &m_locals[it->second] : nullptr;
+    }
+
+    // World transform as of the last Propagate()
+    const Transform2D* GetWorld(const std::string& entity_id) {
+        auto it = m_slots.find(entity_id);
+        if (it == m_slots.end()) return nullptr;
+        Flatten();
+        return &m_flatWorlds[m_flatIndexOfSlot[it->second]];
+    }
+
+    // Update every world transform on the calling thread
+    void Propagate() {
+        Flatten();
+        for (size_t level = 0; level + 1 < m_levelOffsets.size(); ++level) {
+            PropagateRange(m_levelOffsets[level], m_levelOffsets[level + 1]);
+        }
+    }
+
+    /**
+     * @brief Update every world transform using the job scheduler
+     *
+     * Each level is split into chunks of `grain` nodes, one TransformPropagationJob
+     * per chunk. The calling thread waits for a level to finish before scheduling
+     * the next, since children read their parents' results.
+     */
+    void Propagate(JobSystem::JobScheduler& scheduler, uint32_t grain = DEFAULT_GRAIN) {
+        Flatten();
+        if (grain == 0) grain = 1;
+        for (size_t level = 0; level + 1 < m_levelOffsets.size(); ++level) {
+            const uint32_t begin = m_levelOffsets[level];
+            const uint32_t end = m_levelOffsets[level + 1];
+            if (end - begin <= grain || scheduler.GetThreadCount() == 0) {
+                PropagateRange(begin, end);
+                continue;
+            }
+
+            std::atomic<uint32_t> pending{ (end - begin + grain - 1) / grain };
+            for (uint32_t chunk = begin; chunk < end; chunk += grain) {
+                const uint32_t chunk_end = chunk + grain < end ? chunk + grain : end;
+                scheduler.ScheduleJob(new TransformPropagationJob(*this, chunk, chunk_end, pending));
+            }
+            while (pending.load(std::memory_order_acquire) != 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // World transforms for the flattened range [begin, end); all parents must already be up to date
+    void PropagateRange(uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            const uint32_t parent = m_flatParents[i];
+            m_flatWorlds[i] = parent == INVALID_NODE
+                ? m_flatLocals[i]
+                : CombineTransforms(m_flatWorlds[parent], m_flatLocals[i]);
+        }
+    }
+
+    size_t Size() const { return m_slots.size(); }
+
+    // Number of levels in the flattened layout (roots are level 0)
+    size_t GetLevelCount() {
+        Flatten();
+        return m_levelOffsets.empty() ? 0 : m_levelOffsets.size() - 1;
+    }
+
+    // Flattened range of one level
+    std::pair<uint32_t, uint32_t> GetLevelRange(size_t level) {
+        Flatten();
+        return { m_levelOffsets[level], m_levelOffsets[level + 1] };
+    }
+
+    // Flattened index of an entity, INVALID_NODE if unknown
+    uint32_t GetNodeIndex(const std::string& entity_id) {
+        auto it = m_slots.find(entity_id);
+        if (it == m_slots.end()) return INVALID_NODE;
+        Flatten();
+        return m_flatIndexOfSlot[it->second];
+    }
+
+    uint32_t GetFirstChild(uint32_t node) const { return m_firstChild[node]; }
+    uint32_t GetChildCount(uint32_t node) const { return m_childCount[node]; }
+    uint32_t GetParentNode(uint32_t node) const { return m_flatParents[node]; }
+
+private:
+    // Rebuild the breadth-first arrays if the structure changed since the last rebuild
+    void Flatten() {
+        if (!m_dirty) return;
+
+        const uint32_t slot_count = static_cast<uint32_t>(m_ids.size());
+
+        // Bucket children by parent slot (counting sort keeps slot order within a bucket)
+        std::vector<uint32_t> child_start(slot_count + 1, 0);
+        for (uint32_t slot = 0; slot < slot_count; ++slot) {
+            if (m_alive[slot] && m_parents[slot] != INVALID_NODE) {
+                ++child_start[m_parents[slot] + 1];
+            }
+        }
+        for (uint32_t slot = 0; slot < slot_count; ++slot) {
+            child_start[slot + 1] += child_start[slot];
+        }
+        std::vector<uint32_t> children(child_start[slot_count]);
+        std::vector<uint32_t> cursor(child_start.begin(), child_start.end() - 1);
+        for (uint32_t slot = 0; slot < slot_count; ++slot) {
+            if (m_alive[slot] && m_parents[slot] != INVALID_NODE) {
+                children[cursor[m_parents[slot]]++] = slot;
+            }
+        }
+
+        // Breadth-first walk from the roots
+        std::vector<uint32_t> order;
+        order.reserve(m_slots.size());
+        for (uint32_t slot = 0; slot < slot_count; ++slot) {
+            if (m_alive[slot] && m_parents[slot] == INVALID_NODE) {
+                order.push_back(slot);
+            }
+        }
+
+        const size_t node_count = m_slots.size();
+        std::vector<uint32_t> first_child(node_count, 0);
+        std::vector<uint32_t> child_count(node_count, 0);
+        m_levelOffsets.clear();
+        size_t level_begin = 0;
+        size_t level_end = order.size();
+        while (level_begin < level_end) {
+            m_levelOffsets.push_back(static_cast<uint32_t>(level_begin));
+            for (size_t i = level_begin; i < level_end; ++i) {
+                const uint32_t slot = order[i];
+                first_child[i] = static_cast<uint32_t>(order.size());
+                child_count[i] = child_start[slot + 1] - child_start[slot];
+                order.insert(order.end(), children.begin() + child_start[slot], children.begin() + child_start[slot + 1]);
+            }
+            level_begin = level_end;
+            level_end = order.size();
+        }
+        m_levelOffsets.push_back(static_cast<uint32_t>(order.size()));
+
+        // Carry over the previous world transforms so GetWorld stays meaningful until the next Propagate
+        std::vector<Transform2D> worlds(order.size());
+        std::vector<uint32_t> flat_index_of_slot(slot_count, INVALID_NODE);
+        for (uint32_t i = 0; i < order.size(); ++i) {
+            const uint32_t slot = order[i];
+            const uint32_t previous = m_flatIndexOfSlot[slot];
+            worlds[i] = previous != INVALID_NODE ? m_flatWorlds[previous] : m_locals[slot];
+            flat_index_of_slot[slot] = i;
+        }
+
+        m_flatParents.resize(order.size());
+        m_flatLocals.resize(order.size());
+        for (uint32_t i = 0; i < order.size(); ++i) {
+            const uint32_t parent = m_parents[order[i]];
+            m_flatParents[i] = parent == INVALID_NODE ? INVALID_NODE : flat_index_of_slot[parent];
+            m_flatLocals[i] = m_locals[order[i]];
+        }
+
+        m_order = std::move(order);
+        m_flatWorlds = std::move(worlds);
+        m_flatIndexOfSlot = std::move(flat_index_of_slot);
+        m_firstChild = std::move(first_child);
+        m_childCount = std::move(child_count);
+        m_dirty = false;
+    }
+
+    // Authoring data, indexed by slot
+    std::unordered_map<std::string, uint32_t> m_slots;
+    std::vector<std::string> m_ids;
+    std::vector<uint32_t> m_parents;
+    std::vector<Transform2D> m_locals;
+    std::vector<bool> m_alive;
+    std::vector<uint32_t> m_freeSlots;
+
+    // Breadth-first layout, indexed by flattened node index
+    std::vector<uint32_t> m_order;          // node -> slot
+    std::vector<uint32_t> m_flatIndexOfSlot; // slot -> node
+    std::vector<uint32_t> m_flatParents;
+    std::vector<uint32_t> m_firstChild;
+    std::vector<uint32_t> m_childCount;
+    std::vector<uint32_t> m_levelOffsets;
+    std::vector<Transform2D> m_flatLocals;
+    std::vector<Transform2D> m_flatWorlds;
+    bool m_dirty = false;
+};
+
+inline void TransformPropagationJob::Execute(float) {
+    m_hierarchy.PropagateRange(m_begin, m_end);
+    m_pending.fetch_sub(1, std::memory_order_release);
+}
+
+} // namespace entities
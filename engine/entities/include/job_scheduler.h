@@ -3,12 +3,15 @@
 #include <queue>
 #include <vector>
 #include <memory>
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
 #include <thread>
 #include <functional>
 #include "job.h"
 #include "utils/signal.h"
+#include "utils/BinaryLog.h"
+#include "utils/profiler.h"
 #include <iostream>
 
 namespace JobSystem {
@@ -74,7 +77,7 @@ public:
         : m_running(true) {
         // Start worker threads
         for (size_t i = 0; i < numThreads; ++i) {
-            m_threads.emplace_back(&JobScheduler::WorkerThread, this);
+            m_threads.emplace_back(&JobScheduler::WorkerThread, this, i);
         }
     }
 
@@ -117,9 +120,10 @@ public:
         m_condition.notify_one();
     }
 
-    // Run all scheduled jobs with the given delta time
+    // Set the delta time of jobs that start from now on and process completed jobs.
+    // Completion callbacks run on the calling thread, so call this from one thread only
     void Update(float dt) {
-        m_deltaTime = dt;
+        m_deltaTime.store(dt, std::memory_order_relaxed);
         
         // Process any completed jobs
         std::lock_guard<std::mutex> lock(m_completedMutex);
@@ -130,6 +134,8 @@ public:
         OnJobsCompleted.emit();
     }
 
+    size_t GetThreadCount() const { return m_threads.size(); }
+
     // Signal that will be emitted when all jobs are completed
     Signal<> OnJobsCompleted;
 
@@ -174,7 +180,8 @@ public:
     }
 
 private:
-    void WorkerThread() {
+    void WorkerThread(size_t index) {
+        PROFILE_THREAD_NAME("Job worker " + std::to_string(index));
         while (true) {
             std::unique_ptr<JobBase> job;
             
@@ -199,7 +206,12 @@ private:
             }
             
             // Execute the job
-            job->Execute(m_deltaTime);
+            LOG_TRACE("job begin {}", job->GetName());
+            {
+                PROFILE_ZONE_DYNAMIC(job->GetName());
+                job->Execute(m_deltaTime.load(std::memory_order_relaxed));
+            }
+            LOG_TRACE("job end {}", job->GetName());
             
             // Store completed job
             {
@@ -216,7 +228,7 @@ private:
     std::mutex m_completedMutex;
     std::condition_variable m_condition;
     bool m_running;
-    float m_deltaTime = 0.0f;
+    std::atomic<float> m_deltaTime{ 0.0f };
 
     std::vector<JobBase*> m_jobs;                     // Raw pointers for quick access
     std::vector<std::shared_ptr<JobBase>> m_ownedJobs; // Shared pointers for ownership
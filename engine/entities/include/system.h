@@ -1,3 +1,5 @@
+#include "utils/profiler.h"
+
 namespace JobSystem {
     template<typename... Components>
     class System {
@@ -29,6 +31,7 @@ namespace JobSystem {
             void Run()
             {
                 if (!CanBeRun()) return;
+                PROFILE_ZONE("System::Run");
                 m_isRunning = true;
                 CreateJobs();
                 
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "LogLevel.h"
+
+namespace Logging {
+
+// What a producer does when its ring is full
+enum class LogOverflowPolicy {
+    Drop,  // discard the message and count it
+    Block  // wait for the background thread to make room
+};
+
+struct AsyncLogConfig {
+    size_t ringCapacity = 1024;                          // records per thread, rounded up to a power of two
+    LogOverflowPolicy overflowPolicy = LogOverflowPolicy::Drop;
+    std::chrono::milliseconds flushInterval{ 10 };       // idle wake-up period of the background thread
+};
+
+// Fixed-size log record; messages longer than MAX_TEXT are truncated
+struct LogRecord {
+    static constexpr size_t MAX_TEXT = 240;
+
+    uint64_t sequence;
+    LogLevel level;
+    uint32_t length;
+    char text[MAX_TEXT];
+
+    std::string_view view() const { return std::string_view(text, length); }
+};
+
+/**
+ * @brief Single-producer/single-consumer ring of log records
+ *
+ * Written only by the owning thread, read only by the background thread.
+ */
+class LogRing {
+public:
+    explicit LogRing(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        m_records.resize(size);
+        m_mask = size - 1;
+    }
+
+    bool tryPush(uint64_t sequence, LogLevel level, std::string_view message) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) > m_mask) {
+            return false;
+        }
+        LogRecord& record = m_records[head & m_mask];
+        record.sequence = sequence;
+        record.level = level;
+        record.length = static_cast<uint32_t>(std::min(message.size(), LogRecord::MAX_TEXT));
+        std::memcpy(record.text, message.data(), record.length);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Copy out up to `max` records; returns the number copied
+    size_t pop(std::vector<LogRecord>& out, size_t max) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t head = m_head.load(std::memory_order_acquire);
+        const size_t count = std::min(head - tail, max);
+        for (size_t i = 0; i < count; ++i) {
+            out.push_back(m_records[(tail + i) & m_mask]);
+        }
+        m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    bool empty() const {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+    // Set when the owning thread exits; the ring is released once drained
+    std::atomic<bool> orphaned{ false };
+
+private:
+    std::vector<LogRecord> m_records;
+    size_t m_mask = 0;
+    alignas(64) std::atomic<size_t> m_head{ 0 };
+    alignas(64) std::atomic<size_t> m_tail{ 0 };
+};
+
+/**
+ * @brief Asynchronous logging backend used by Logger in async mode
+ *
+ * Each producer thread gets its own LogRing on first use (registration is the
+ * only step that takes a lock). A background thread drains all rings,
+ * restores global order by sequence number, hands the batch to the write
+ * callback and then flushes, so sinks see one flush per batch instead of one
+ * per line.
+ */
+class AsyncLogBackend {
+public:
+    using WriteBatchFunc = std::function<void(const std::vector<LogRecord>& records, uint64_t dropped)>;
+
+    AsyncLogBackend(const AsyncLogConfig& config, WriteBatchFunc writeBatch)
+        : m_config(config), m_writeBatch(std::move(writeBatch)), m_id(nextBackendId()) {
+        m_thread = std::thread(&AsyncLogBackend::run, this);
+    }
+
+    ~AsyncLogBackend() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_running = false;
+        }
+        m_wake.notify_all();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    AsyncLogBackend(const AsyncLogBackend&) = delete;
+    AsyncLogBackend& operator=(const AsyncLogBackend&) = delete;
+
+    // Queue a message from the calling thread; returns false if it was dropped.
+    // Block falls back to dropping during shutdown and on the background thread (a sink that logs)
+    bool push(LogLevel level, std::string_view message) {
+        LogRing& ring = threadRing();
+        const uint64_t sequence = m_sequence.fetch_add(1, std::memory_order_relaxed);
+        if (ring.tryPush(sequence, level, message)) {
+            return true;
+        }
+        if (m_config.overflowPolicy == LogOverflowPolicy::Drop) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        while (!ring.tryPush(sequence, level, message)) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                // Nothing drains once shutdown starts, and the background thread only drains its own ring between batches
+                if (!m_running || std::this_thread::get_id() == m_threadId) {
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                m_flushRequested = true;
+            }
+            m_wake.notify_one();
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    // Block until every message pushed before this call has been written and flushed
+    void flush() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        // A pass that starts after this point sees everything queued so far
+        const uint64_t target = m_passes + 2;
+        m_flushRequested = true;
+        m_wake.notify_all();
+        m_passDone.wait(lock, [this, target] { return m_passes >= target || !m_running; });
+    }
+
+    uint64_t droppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct ThreadRing {
+        std::shared_ptr<LogRing> ring;
+        uint64_t backendId = 0;
+
+        ~ThreadRing() {
+            if (ring) ring->orphaned.store(true, std::memory_order_release);
+        }
+    };
+
+    static uint64_t nextBackendId() {
+        static std::atomic<uint64_t> next{ 1 };
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    LogRing& threadRing() {
+        thread_local ThreadRing local;
+        if (local.backendId != m_id) {
+            if (local.ring) local.ring->orphaned.store(true, std::memory_order_release);
+            local.ring = std::make_shared<LogRing>(m_config.ringCapacity);
+            local.backendId = m_id;
+            std::lock_guard<std::mutex> lock(m_ringsMutex);
+            m_rings.push_back(local.ring);
+        }
+        return *local.ring;
+    }
+
+    // Drain every ring once; returns true if anything was written
+    bool drain(std::vector<LogRecord>& batch) {
+        std::vector<std::shared_ptr<LogRing>> rings;
+        {
+            std::lock_guard<std::mutex> lock(m_ringsMutex);
+            // Release rings whose thread has exited and which have nothing left to read
+            m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(), [](const std::shared_ptr<LogRing>& ring) {
+                return ring->orphaned.load(std::memory_order_acquire) && ring->empty();
+            }), m_rings.end());
+            rings = m_rings;
+        }
+
+        batch.clear();
+        for (auto& ring : rings) {
+            while (ring->pop(batch, BATCH_PER_RING) == BATCH_PER_RING) {}
+        }
+        const uint64_t dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+        if (batch.empty() && dropped == 0) {
+            return false;
+        }
+        std::sort(batch.begin(), batch.end(), [](const LogRecord& a, const LogRecord& b) {
+            return a.sequence < b.sequence;
+        });
+        m_writeBatch(batch, dropped);
+        return true;
+    }
+
+    void run() {
+        std::vector<LogRecord> batch;
+        batch.reserve(m_config.ringCapacity);
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_threadId = std::this_thread::get_id();
+        while (true) {
+            const bool running = m_running;
+            m_flushRequested = false;
+            lock.unlock();
+            while (drain(batch)) {}
+            lock.lock();
+
+            ++m_passes;
+            m_passDone.notify_all();
+            if (!running) {
+                break;
+            }
+            m_wake.wait_for(lock, m_config.flushInterval, [this] { return !m_running || m_flushRequested; });
+        }
+    }
+
+    static constexpr size_t BATCH_PER_RING = 256;
+
+    AsyncLogConfig m_config;
+    WriteBatchFunc m_writeBatch;
+    const uint64_t m_id;
+
+    std::mutex m_ringsMutex;
+    std::vector<std::shared_ptr<LogRing>> m_rings;
+
+    std::atomic<uint64_t> m_sequence{ 0 };
+    std::atomic<uint64_t> m_dropped{ 0 };
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_passDone;
+    uint64_t m_passes = 0;
+    bool m_flushRequested = false;
+    bool m_running = true;
+    std::thread::id m_threadId;
+    std::thread m_thread;
+};
+
+} // namespace Logging
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "LogLevel.h"
+#include "LogSink.h"
+#include "mapped_file.h"
+
+namespace Logging {
+
+constexpr char BINARY_LOG_MAGIC[8] = { 'E', 'C', 'S', 'B', 'L', 'O', 'G', '\0' };
+constexpr uint32_t BINARY_LOG_VERSION = 1;
+constexpr size_t BINARY_LOG_DATA_OFFSET = 64;
+constexpr size_t BINARY_LOG_MAX_RECORD = 1024;
+constexpr size_t BINARY_LOG_MAX_FORMATS = 4096;
+
+/*
+ * Binary log file layout (host endianness):
+ *
+ *   BinaryLogHeader, padded to BINARY_LOG_DATA_OFFSET
+ *   records, each starting with BinaryLogRecord and padded to 8 bytes
+ *
+ * A Format record defines a format id: payload is uint32 line, uint16 file
+ * length, uint16 format length, file bytes, format bytes. It is written the
+ * first time an id is used in a file, possibly after the first events that use
+ * it, so readers collect formats before rendering events.
+ *
+ * An Event record carries a format id and `arg_count` tagged arguments: one
+ * BinaryArgType byte followed by 8 bytes (Int/UInt/Float/Pointer), 1 byte
+ * (Bool) or a uint16 length and the bytes (String). "{}" in the format is
+ * replaced by the next argument. scripts/decode_binary_log.py renders a file
+ * to text.
+ */
+struct BinaryLogHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t capacity;       // file size
+    uint64_t used;           // end of the last record, written on close
+    int64_t start_wall_ns;   // system clock at open; record timestamps are relative to it
+    uint64_t dropped;        // records that did not fit
+};
+
+enum class BinaryRecordKind : uint16_t {
+    End = 0,
+    Format = 1,
+    Event = 2
+};
+
+struct BinaryLogRecord {
+    uint16_t kind;
+    uint16_t size;           // whole record including padding
+    uint32_t format_id;
+    uint64_t timestamp_ns;   // steady clock since open
+    uint32_t thread;
+    uint8_t level;
+    uint8_t arg_count;
+    uint16_t reserved;
+};
+
+enum class BinaryArgType : uint8_t {
+    Int = 1,
+    UInt = 2,
+    Float = 3,
+    String = 4,
+    Pointer = 5,
+    Bool = 6
+};
+
+/**
+ * @brief Memory-mapped binary log
+ *
+ * write() copies a format id, a timestamp and the raw argument bytes into the
+ * mapping; nothing is formatted at runtime. Space is reserved with one atomic
+ * add, so any number of threads can write concurrently. When the file is full
+ * further records are counted as dropped.
+ *
+ * The LOG_TRACE / LOG_BINARY macros register their format string once per call
+ * site and write to the log installed with setGlobal(). They count themselves
+ * as in-flight writers while they use it, so close() can uninstall the log and
+ * wait for them before unmapping. Code that calls write() directly (such as
+ * BinaryLogSink) must be stopped before close().
+ */
+class BinaryLog {
+public:
+    BinaryLog();
+    ~BinaryLog() { close(); }
+
+    BinaryLog(const BinaryLog&) = delete;
+    BinaryLog& operator=(const BinaryLog&) = delete;
+
+    bool open(const std::string& path, size_t capacity = 64 * 1024 * 1024);
+    // Uninstall the log if it is global, wait for LOG_BINARY writers still using it,
+    // then record the final size in the header and flush to disk
+    void close();
+    bool isOpen() const { return m_file.IsOpen(); }
+
+    template <typename... Args>
+    bool write(uint32_t formatId, LogLevel level, const Args&... args) {
+        uint8_t buffer[BINARY_LOG_MAX_RECORD];
+        size_t size = sizeof(BinaryLogRecord);
+        (encode(buffer, size, args), ...);
+        return commit(buffer, size, BinaryRecordKind::Event, formatId, level, static_cast<uint8_t>(sizeof...(Args)));
+    }
+
+    size_t bytesUsed() const;
+    uint64_t droppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    // Process-wide format table shared by all logs; returns the format id
+    static uint32_t registerFormat(LogLevel level, const char* format, const char* file, int line);
+
+    // Log used by LOG_TRACE / LOG_BINARY; nullptr disables them
+    static void setGlobal(BinaryLog* log) { globalSlot().store(log); }
+    static BinaryLog* global() { return globalSlot().load(std::memory_order_acquire); }
+
+    /**
+     * @brief Use of the global log by one LOG_BINARY call
+     *
+     * The writer is counted before the global pointer is loaded (both sequentially
+     * consistent), so once close() has cleared the pointer and seen the count drop
+     * to zero, no writer can still hold it.
+     */
+    class GlobalWriter {
+    public:
+        GlobalWriter() {
+            inFlightWriters().fetch_add(1);
+            m_log = globalSlot().load();
+        }
+        ~GlobalWriter() { inFlightWriters().fetch_sub(1, std::memory_order_release); }
+
+        GlobalWriter(const GlobalWriter&) = delete;
+        GlobalWriter& operator=(const GlobalWriter&) = delete;
+
+        BinaryLog* log() const { return m_log; }
+
+    private:
+        BinaryLog* m_log = nullptr;
+    };
+
+    // Render a log to text, one line per event
+    static bool decode(const uint8_t* data, size_t size, std::vector<std::string>& lines);
+    static bool decodeFile(const std::string& path, std::vector<std::string>& lines);
+
+private:
+    static std::atomic<BinaryLog*>& globalSlot() {
+        static std::atomic<BinaryLog*> slot{ nullptr };
+        return slot;
+    }
+
+    static std::atomic<uint32_t>& inFlightWriters() {
+        static std::atomic<uint32_t> count{ 0 };
+        return count;
+    }
+
+    template <typename T>
+    static void encode(uint8_t* buffer, size_t& size, const T& value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            encodeValue(buffer, size, BinaryArgType::Bool, static_cast<uint8_t>(value));
+        } else if constexpr (std::is_enum_v<T>) {
+            encodeValue(buffer, size, BinaryArgType::Int, static_cast<int64_t>(value));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            encodeValue(buffer, size, BinaryArgType::Float, static_cast<double>(value));
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            encodeValue(buffer, size, BinaryArgType::Int, static_cast<int64_t>(value));
+        } else if constexpr (std::is_integral_v<T>) {
+            encodeValue(buffer, size, BinaryArgType::UInt, static_cast<uint64_t>(value));
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            encodeString(buffer, size, std::string_view(value));
+        } else if constexpr (std::is_pointer_v<T>) {
+            encodeValue(buffer, size, BinaryArgType::Pointer, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+        } else {
+            static_assert(std::is_pointer_v<T>, "Unsupported binary log argument type");
+        }
+    }
+
+    template <typename V>
+    static void encodeValue(uint8_t* buffer, size_t& size, BinaryArgType type, V value) {
+        if (size + 1 + sizeof(V) > BINARY_LOG_MAX_RECORD) return;
+        buffer[size++] = static_cast<uint8_t>(type);
+        std::memcpy(buffer + size, &value, sizeof(V));
+        size += sizeof(V);
+    }
+
+    static void encodeString(uint8_t* buffer, size_t& size, std::string_view value) {
+        if (size + 3 > BINARY_LOG_MAX_RECORD) return;
+        const uint16_t length = static_cast<uint16_t>(std::min(value.size(), BINARY_LOG_MAX_RECORD - size - 3));
+        buffer[size++] = static_cast<uint8_t>(BinaryArgType::String);
+        std::memcpy(buffer + size, &length, sizeof(length));
+        size += sizeof(length);
+        std::memcpy(buffer + size, value.data(), length);
+        size += length;
+    }
+
+    bool commit(uint8_t* buffer, size_t size, BinaryRecordKind kind, uint32_t formatId, LogLevel level, uint8_t argCount);
+    void writeFormat(uint32_t formatId);
+    static uint32_t threadIndex();
+
+    utils::MappedFile m_file;
+    std::chrono::steady_clock::time_point m_start;
+    std::atomic<size_t> m_cursor{ 0 };
+    std::atomic<uint64_t> m_dropped{ 0 };
+    // Which format ids already have a Format record in this file
+    std::unique_ptr<std::atomic<bool>[]> m_formatWritten;
+};
+
+/**
+ * @brief LogSink that stores regular LOG_* messages in a BinaryLog
+ *
+ * Messages arrive already formatted, so each is written as a single string
+ * argument; this still avoids per-line text formatting and stream flushes.
+ */
+class BinaryLogSink : public LogSink {
+public:
+    explicit BinaryLogSink(BinaryLog& log)
+        : m_log(log), m_formatId(BinaryLog::registerFormat(LogLevel::Info, "{}", __FILE__, __LINE__)) {}
+
+    void write(LogLevel level, std::string_view message) override {
+        m_log.write(m_formatId, level, message);
+    }
+
+private:
+    BinaryLog& m_log;
+    uint32_t m_formatId;
+};
+
+} // namespace Logging
+
+// Write a structured record to the global BinaryLog, if one is installed.
+// The format is stored once per call site; arguments are copied raw.
+// Levels below LOGGING_MIN_LEVEL are compiled out, and without a global log
+// the cost is one atomic load.
+#define LOG_BINARY(level, format, ...) \
+    do { \
+        if constexpr (static_cast<int>(level) >= LOGGING_MIN_LEVEL) { \
+            if (Logging::BinaryLog::global()) { \
+                const Logging::BinaryLog::GlobalWriter binaryWriter_; \
+                if (Logging::BinaryLog* binaryLog_ = binaryWriter_.log()) { \
+                    static const uint32_t formatId_ = Logging::BinaryLog::registerFormat(level, format, __FILE__, __LINE__); \
+                    binaryLog_->write(formatId_, level, ##__VA_ARGS__); \
+                } \
+            } \
+        } \
+    } while (0)
+
+// High-volume trace logging (jobs, sprites, ...)
+#define LOG_TRACE(format, ...) LOG_BINARY(Logging::LogLevel::Debug, format, ##__VA_ARGS__)
@@ -1,5 +1,11 @@
 #pragma once
 
+// Messages below this level are compiled out of the LOG_* macros entirely:
+// 0 = Debug, 1 = Info, 2 = Warning, 3 = Error, 4 = Fatal
+#ifndef LOGGING_MIN_LEVEL
+#define LOGGING_MIN_LEVEL 0
+#endif
+
 namespace Logging {
 
 enum class LogLevel {
@@ -10,4 +16,4 @@ enum class LogLevel {
     Fatal
 };
 
-} // namespace Logging 
\ No newline at end of file
+} // namespace Logging
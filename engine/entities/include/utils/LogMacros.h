@@ -11,14 +11,23 @@ namespace Logging {
     }
 }
 
+// The level is checked before the stream is built, so a filtered message costs
+// one comparison and its arguments are never evaluated. Levels below
+// LOGGING_MIN_LEVEL are discarded at compile time. The if/else form keeps the
+// macro safe inside an unbraced if statement.
+#define LOG_AT(level) \
+    if constexpr (static_cast<int>(level) < LOGGING_MIN_LEVEL) {} \
+    else if (!Logging::Logger::getInstance().isEnabled(level)) {} \
+    else Logging::GetLogStream(level)
+
 //global namespace
 // Global convenience macros without parentheses
-#define LOG Logging::GetLogStream(Logging::LogLevel::Debug)
-#define LOG_DEBUG Logging::GetLogStream(Logging::LogLevel::Debug)
-#define LOG_INFO Logging::GetLogStream(Logging::LogLevel::Info)
-#define LOG_WARNING Logging::GetLogStream(Logging::LogLevel::Warning)
-#define LOG_ERROR Logging::GetLogStream(Logging::LogLevel::Error)
-#define LOG_FATAL Logging::GetLogStream(Logging::LogLevel::Fatal)
+#define LOG LOG_AT(Logging::LogLevel::Debug)
+#define LOG_DEBUG LOG_AT(Logging::LogLevel::Debug)
+#define LOG_INFO LOG_AT(Logging::LogLevel::Info)
+#define LOG_WARNING LOG_AT(Logging::LogLevel::Warning)
+#define LOG_ERROR LOG_AT(Logging::LogLevel::Error)
+#define LOG_FATAL LOG_AT(Logging::LogLevel::Fatal)
 
 // End marker
-#define LOG_END Logging::LogEnd() 
\ No newline at end of file
+#define LOG_END Logging::LogEnd()
@@ -1,9 +1,10 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <fstream>
-#include "logger.h" // For LogLevel enum
+#include "LogLevel.h"
 
 namespace Logging {
 
@@ -11,10 +12,12 @@ namespace Logging {
 class LogSink {
 public:
     virtual ~LogSink() = default;
-    virtual void write(LogLevel level, const std::string& message) = 0;
+    virtual void write(LogLevel level, std::string_view message) = 0;
+    // Push buffered output to its destination; called once per batch in async mode
+    virtual void flush() {}
     
 protected:
-    std::string levelToString(LogLevel level) {
+    const char* levelToString(LogLevel level) {
         switch (level) {
             case LogLevel::Debug:   return "DEBUG";
             case LogLevel::Info:    return "INFO";
@@ -29,9 +32,14 @@ protected:
 // Console sink implementation
 class ConsoleSink : public LogSink {
 public:
-    void write(LogLevel level, const std::string& message) override {
+    void write(LogLevel level, std::string_view message) override {
         std::ostream& out = (level >= LogLevel::Error) ? std::cerr : std::cout;
-        out << "[" << levelToString(level) << "] " << message << std::endl;
+        out << "[" << levelToString(level) << "] " << message << '\n';
+    }
+
+    void flush() override {
+        std::cout.flush();
+        std::cerr.flush();
     }
 };
 
@@ -50,9 +58,15 @@ public:
         }
     }
     
-    void write(LogLevel level, const std::string& message) override {
+    void write(LogLevel level, std::string_view message) override {
+        if (m_file.is_open()) {
+            m_file << "[" << levelToString(level) << "] " << message << '\n';
+        }
+    }
+
+    void flush() override {
         if (m_file.is_open()) {
-            m_file << "[" << levelToString(level) << "] " << message << std::endl;
+            m_file.flush();
         }
     }
     
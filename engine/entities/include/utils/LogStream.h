@@ -1,26 +1,43 @@
 #pragma once
 
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include "LogLevel.h"
 
 namespace Logging {
 // Forward declaration
 class Logger;
 
+// Messages longer than this are truncated
+constexpr size_t LOG_STREAM_CAPACITY = 512;
+
+/**
+ * @brief Builds one log message in a stack buffer
+ *
+ * Strings, characters, booleans, integers, floating point values and pointers
+ * are formatted in place without touching the heap. Other types fall back to
+ * their std::ostream operator<<, which does allocate.
+ */
 class LogStream
 {
 public:
     LogStream(LogLevel level, Logger &logger)
-        : m_level(level), m_logger(logger), m_active(true) {}
+        : m_level(level), m_logger(logger), m_length(0), m_active(true) {}
 
     // Move constructor
     LogStream(LogStream &&other) noexcept
         : m_level(other.m_level),
             m_logger(other.m_logger),
-            m_buffer(std::move(other.m_buffer)),
+            m_length(other.m_length),
             m_active(other.m_active)
     {
+        std::memcpy(m_buffer, other.m_buffer, m_length);
         other.m_active = false; // Prevent the moved-from object from flushing
     }
 
@@ -33,23 +50,76 @@ public:
         }
     }
 
-    // Stream operator for any type that can be streamed
-    template <typename T>
+    LogStream &operator<<(std::string_view value)
+    {
+        append(value.data(), value.size());
+        return *this;
+    }
+
+    LogStream &operator<<(const std::string &value) { return *this << std::string_view(value); }
+    LogStream &operator<<(const char *value) { return *this << std::string_view(value ? value : "(null)"); }
+    LogStream &operator<<(char *value) { return *this << static_cast<const char *>(value); }
+
+    LogStream &operator<<(char value)
+    {
+        append(&value, 1);
+        return *this;
+    }
+
+    LogStream &operator<<(bool value) { return *this << std::string_view(value ? "true" : "false"); }
+
+    LogStream &operator<<(const void *value)
+    {
+        char digits[2 + 2 * sizeof(void *)] = { '0', 'x' };
+        auto result = std::to_chars(digits + 2, digits + sizeof(digits), reinterpret_cast<uintptr_t>(value), 16);
+        append(digits, static_cast<size_t>(result.ptr - digits));
+        return *this;
+    }
+
+    // Integers and floating point values
+    template <typename T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+    LogStream &operator<<(T value)
+    {
+        char digits[32];
+        std::to_chars_result result;
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::general, 6);
+        }
+        else
+        {
+            result = std::to_chars(digits, digits + sizeof(digits), value);
+        }
+        append(digits, static_cast<size_t>(result.ptr - digits));
+        return *this;
+    }
+
+    template <typename T, std::enable_if_t<std::is_enum_v<T>, int> = 0>
+    LogStream &operator<<(T value)
+    {
+        return *this << static_cast<std::underlying_type_t<T>>(value);
+    }
+
+    // Fallback for any other type that can be streamed; this path allocates
+    template <typename T, std::enable_if_t<!std::is_arithmetic_v<T> && !std::is_enum_v<T> && !std::is_pointer_v<T> &&
+                                           !std::is_convertible_v<const T &, std::string_view>, int> = 0>
     LogStream &operator<<(const T &value)
     {
         if (m_active)
         {
-            m_buffer << value;
+            std::ostringstream stream;
+            stream << value;
+            *this << stream.str();
         }
         return *this;
     }
 
-    // Special handling for std::endl and other manipulators
+    // std::endl becomes a newline; other manipulators are ignored
     LogStream &operator<<(std::ostream &(*manip)(std::ostream &))
     {
-        if (m_active)
+        if (manip == static_cast<std::ostream &(*)(std::ostream &)>(std::endl))
         {
-            manip(m_buffer);
+            append("\n", 1);
         }
         return *this;
     }
@@ -65,20 +135,27 @@ public:
     }
 
     // Flush the stream
-    void flush()
+    void flush();
+
+    std::string_view view() const { return std::string_view(m_buffer, m_length); }
+
+private:
+    void append(const char *data, size_t size)
     {
-        if (m_active && !m_buffer.str().empty())
+        if (!m_active)
         {
-            m_logger.log(m_level, m_buffer.str());
-            m_buffer.str(""); // Clear the buffer
+            return;
         }
+        const size_t count = size < LOG_STREAM_CAPACITY - m_length ? size : LOG_STREAM_CAPACITY - m_length;
+        std::memcpy(m_buffer + m_length, data, count);
+        m_length += count;
     }
 
-private:
     LogLevel m_level;
     Logger &m_logger;
-    std::stringstream m_buffer;
+    size_t m_length;
     bool m_active; // Flag to prevent double-flushing
+    char m_buffer[LOG_STREAM_CAPACITY];
 };
 
 // End marker for log messages
@@ -99,4 +176,4 @@ inline LogStream &operator<<(LogStream &stream, const LogEnd &)
 
 
 
-} // namespace Logging 
\ No newline at end of file
+} // namespace Logging
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace utils {
+
+/**
+ * @brief Inline, fixed-capacity string that stays trivially copyable
+ *
+ * Intended for POD components, where std::string would make the component
+ * non-trivially-copyable. Input longer than Capacity is truncated.
+ * sizeof(FixedString<N>) == N + 1, so FixedString<15> packs into 16 bytes.
+ *
+ * @tparam Capacity Maximum number of characters stored (excluding the terminator)
+ */
+template<size_t Capacity>
+struct FixedString {
+    static_assert(Capacity > 0, "FixedString capacity must be at least 1");
+
+    char m_data[Capacity + 1]{};
+
+    FixedString() = default;
+    FixedString(const char* str) { assign(std::string_view(str ? str : "")); }
+    FixedString(std::string_view str) { assign(str); }
+    FixedString(const std::string& str) { assign(std::string_view(str)); }
+
+    void assign(std::string_view str) {
+        size_t length = str.size() < Capacity ? str.size() : Capacity;
+        std::memcpy(m_data, str.data(), length);
+        // Zero the tail so equal strings are also bytewise equal (memcmp, hashing, snapshots)
+        std::memset(m_data + length, 0, Capacity + 1 - length);
+    }
+
+    const char* c_str() const { return m_data; }
+    std::string_view view() const { return std::string_view(m_data, size()); }
+    std::string str() const { return std::string(view()); }
+    size_t size() const { return std::char_traits<char>::length(m_data); }
+    bool empty() const { return m_data[0] == '\0'; }
+    static constexpr size_t capacity() { return Capacity; }
+
+    bool operator==(const FixedString& other) const { return std::memcmp(m_data, other.m_data, Capacity + 1) == 0; }
+    bool operator!=(const FixedString& other) const { return !(*this == other); }
+    bool operator==(std::string_view other) const { return view() == other; }
+    bool operator!=(std::string_view other) const { return !(*this == other); }
+};
+
+} // namespace utils
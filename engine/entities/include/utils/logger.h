@@ -1,11 +1,14 @@
 #pragma once
 
 #include "LogLevel.h"
+#include <atomic>
 #include <string>
+#include <string_view>
 #include <mutex>
 #include <vector>
 #include <memory>
 #include "LogSink.h"
+#include "AsyncLogBackend.h"
 #include "singleton.h"
 
 namespace Logging {
@@ -24,8 +27,12 @@ public:
     
     // Set the minimum log level to display
     void setLogLevel(LogLevel level) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_minLevel = level;
+        m_minLevel.store(level, std::memory_order_relaxed);
+    }
+
+    // Cheap check used by the LOG_* macros before any formatting happens
+    bool isEnabled(LogLevel level) const {
+        return level >= m_minLevel.load(std::memory_order_relaxed);
     }
     
     // Add a log sink (console, file, etc.)
@@ -35,27 +42,96 @@ public:
     }
     
     // Log a message with a specific level
-    void log(LogLevel level, const std::string& message) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        
-        if (level < m_minLevel) {
+    void log(LogLevel level, std::string_view message) {
+        if (!isEnabled(level)) {
             return;  // Skip messages below the minimum level
         }
-        
+        if (m_async) {
+            m_async->push(level, message);
+            // Make sure a fatal message reaches the sinks before the caller goes down
+            if (level == LogLevel::Fatal) {
+                m_async->flush();
+            }
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
         for (auto& sink : m_sinks) {
             sink->write(level, message);
+            sink->flush();
         }
     }
 
+    /**
+     * @brief Switch to asynchronous logging
+     *
+     * Messages are queued in per-thread lock-free rings and written by a
+     * background thread in batches, so logging threads never wait on sink I/O
+     * (unless the Block overflow policy is selected and their ring is full).
+     * Call before spawning threads that log; switching modes is not thread-safe.
+     */
+    void enableAsync(const AsyncLogConfig& config = AsyncLogConfig{}) {
+        disableAsync();
+        m_async = std::make_unique<AsyncLogBackend>(config,
+            [this](const std::vector<LogRecord>& records, uint64_t dropped) { writeBatch(records, dropped); });
+    }
+
+    // Drain pending messages and return to synchronous logging
+    void disableAsync() {
+        m_async.reset();
+    }
+
+    bool isAsync() const { return m_async != nullptr; }
+
+    // Messages discarded so far because a thread's async ring was full
+    uint64_t droppedCount() const { return m_async ? m_async->droppedCount() : 0; }
+
+    // Wait until every queued message has been written and sinks are flushed
+    void flush() {
+        if (m_async) {
+            m_async->flush();
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& sink : m_sinks) {
+            sink->flush();
+        }
+    }
+
+    ~Logger() {
+        disableAsync();
+    }
+
 private:
     // Private constructor that will be called by getInstance()
     Logger() : m_minLevel(LogLevel::Info) {
         // Add console sink by default
         addSink(std::make_shared<ConsoleSink>());
     }
-    LogLevel m_minLevel;
+
+    // Background thread: write a drained batch, then flush once
+    void writeBatch(const std::vector<LogRecord>& records, uint64_t dropped) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const LogRecord& record : records) {
+            for (auto& sink : m_sinks) {
+                sink->write(record.level, record.view());
+            }
+        }
+        if (dropped > 0) {
+            const std::string message = std::to_string(dropped) + " log messages dropped (async ring full)";
+            for (auto& sink : m_sinks) {
+                sink->write(LogLevel::Warning, message);
+            }
+        }
+        for (auto& sink : m_sinks) {
+            sink->flush();
+        }
+    }
+
+    std::atomic<LogLevel> m_minLevel;
     std::mutex m_mutex;
     std::vector<std::shared_ptr<LogSink>> m_sinks;
+    std::unique_ptr<AsyncLogBackend> m_async;
 };
 
 } // namespace Logging
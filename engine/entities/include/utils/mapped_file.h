@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace utils {
+
+/**
+ * @brief Memory-mapped file (POSIX mmap / Win32 file mapping)
+ *
+ * OpenRead maps an existing file read-only; Create sizes a new file and maps
+ * it read-write. The mapping is released on Close() or destruction.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool OpenRead(const std::string& path);
+    bool Create(const std::string& path, size_t size);
+    // Write dirty pages back to disk (read-write mappings only)
+    bool Flush();
+    void Close();
+
+    bool IsOpen() const { return m_data != nullptr; }
+    bool IsWritable() const { return m_writable; }
+    uint8_t* Data() { return m_data; }
+    const uint8_t* Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+
+private:
+    uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_writable = false;
+#if defined(_WIN32)
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#else
+    int m_fd = -1;
+#endif
+};
+
+} // namespace utils
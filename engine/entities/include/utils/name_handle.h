@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "singleton.h"
+
+namespace utils {
+
+/**
+ * @brief 32-bit handle to an interned name
+ *
+ * Trivially copyable replacement for std::string members in POD components.
+ * Handles compare by id; resolve back to text through NameTable.
+ * Id 0 is reserved for the empty name.
+ */
+struct NameHandle {
+    uint32_t id = 0;
+
+    bool IsValid() const { return id != 0; }
+    bool operator==(const NameHandle& other) const { return id == other.id; }
+    bool operator!=(const NameHandle& other) const { return id != other.id; }
+};
+
+// Process-wide intern table backing NameHandle
+class NameTable : public Singleton<NameTable> {
+    DECLARE_SINGLETON(NameTable)
+public:
+    NameHandle Intern(std::string_view name) {
+        if (name.empty()) return NameHandle{};
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_ids.find(name);
+        if (it != m_ids.end()) {
+            return NameHandle{ it->second };
+        }
+        // std::deque keeps element addresses stable, so the string_view keys stay valid
+        m_names.emplace_back(name);
+        uint32_t id = static_cast<uint32_t>(m_names.size());
+        m_ids.emplace(std::string_view(m_names.back()), id);
+        return NameHandle{ id };
+    }
+
+    const std::string& Resolve(NameHandle handle) const {
+        static const std::string empty;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (handle.id == 0 || handle.id > m_names.size()) return empty;
+        return m_names[handle.id - 1];
+    }
+
+private:
+    NameTable() = default;
+    mutable std::mutex m_mutex;
+    std::deque<std::string> m_names;
+    std::unordered_map<std::string_view, uint32_t> m_ids;
+};
+
+inline NameHandle MakeName(std::string_view name) {
+    return NameTable::getInstance().Intern(name);
+}
+
+} // namespace utils
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+#include "singleton.h"
+
+// Set to 0 to compile every PROFILE_* macro out
+#ifndef PROFILING_ENABLED
+#define PROFILING_ENABLED 1
+#endif
+
+namespace Profiling {
+
+// One completed zone; `name` must outlive the profiler (literals, __func__, intern())
+struct ProfileEvent {
+    const char* name;
+    uint64_t start;     // ns since the profiler was created
+    uint64_t duration;  // ns
+};
+
+/**
+ * @brief Event buffer of one thread
+ *
+ * Only the owning thread appends; readers see events [0, count). Storage is
+ * allocated on the first event, so naming a thread that never records costs
+ * nothing; it is published through an atomic pointer because readers on
+ * other threads may look at it at any time. Recording stops when the buffer
+ * is full, so published events are never overwritten.
+ */
+struct ThreadProfile {
+    ThreadProfile(uint32_t id, size_t capacity)
+        : id(id), capacity(capacity) {}
+
+    void record(const char* name, uint64_t start, uint64_t duration) {
+        const size_t index = count.load(std::memory_order_relaxed);
+        ProfileEvent* buffer = events.load(std::memory_order_relaxed);
+        if (!buffer) {
+            storage.reset(new ProfileEvent[capacity]);
+            buffer = storage.get();
+            events.store(buffer, std::memory_order_release);
+        }
+        if (index >= capacity) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        buffer[index] = ProfileEvent{ name, start, duration };
+        count.store(index + 1, std::memory_order_release);
+    }
+
+    const uint32_t id;
+    const size_t capacity;
+    std::unique_ptr<ProfileEvent[]> storage;       // owned by the recording thread
+    std::atomic<ProfileEvent*> events{ nullptr };  // storage, once allocated; null while count is 0
+    std::atomic<size_t> count{ 0 };
+    std::atomic<uint64_t> dropped{ 0 };
+    std::string name;
+    bool gpu = false;   // holds GPU timestamps rather than CPU zones
+};
+
+/**
+ * @brief Instrumented CPU profiler
+ *
+ * PROFILE_ZONE / PROFILE_FUNCTION record scoped zones into per-thread buffers
+ * without locking (a thread takes a lock once, when it records its first
+ * zone). Recording is off until setEnabled(true); a disabled zone costs one
+ * atomic load. exportChromeTrace() writes the zones as Chrome trace JSON,
+ * which chrome://tracing and Perfetto (ui.perfetto.dev) open directly.
+ */
+class Profiler : public Singleton<Profiler> {
+    DECLARE_SINGLETON(Profiler)
+public:
+    void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    // Events kept per thread; applies to threads that have not recorded yet
+    void setEventCapacity(size_t capacity) { m_eventCapacity.store(capacity, std::memory_order_relaxed); }
+
+    // Label the calling thread in exported traces
+    void setThreadName(const std::string& name);
+
+    // Nanoseconds since the profiler was created
+    uint64_t now() const {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - m_epoch).count());
+    }
+
+    void record(const char* name, uint64_t start, uint64_t end) {
+        threadProfile().record(name, start, end - start);
+    }
+
+    // Record a zone measured with GPU timestamps, already converted to the
+    // profiler's clock. All GPU zones share one "GPU" track and must be
+    // recorded from a single thread (the one that collects the queries).
+    void recordGpuZone(const char* name, uint64_t start, uint64_t duration);
+
+    // Stable copy of a runtime string, for zone names that are not literals.
+    // Each thread caches what it interned, so only a thread's first use of a name locks
+    const char* intern(std::string_view name);
+
+    // Discard recorded events; only call while no thread is inside a zone
+    void clear();
+
+    size_t eventCount() const;
+    uint64_t droppedCount() const;
+    // Snapshot of every thread's events, for tools and tests
+    std::vector<ProfileEvent> events() const;
+
+    std::string toChromeTrace() const;
+    bool exportChromeTrace(const std::string& path) const;
+
+private:
+    Profiler() : m_epoch(std::chrono::steady_clock::now()) {}
+
+    ThreadProfile& threadProfile() {
+        thread_local ThreadProfile* profile = nullptr;
+        if (!profile) {
+            profile = &registerThread();
+        }
+        return *profile;
+    }
+
+    ThreadProfile& registerThread();
+
+    std::chrono::steady_clock::time_point m_epoch;
+    std::atomic<bool> m_enabled{ false };
+    std::atomic<size_t> m_eventCapacity{ 1 << 14 };
+
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<ThreadProfile>> m_threads;
+    std::atomic<ThreadProfile*> m_gpuTrack{ nullptr };
+    std::unordered_set<std::string> m_names;
+};
+
+// Records the time between construction and destruction
+class ProfileZone {
+public:
+    // Tag for zone names that are runtime strings and must be interned
+    struct Dynamic {};
+
+    explicit ProfileZone(const char* name) {
+        Profiler& profiler = Profiler::getInstance();
+        if (profiler.isEnabled()) {
+            m_name = name;
+            m_start = profiler.now();
+        }
+    }
+
+    ProfileZone(Dynamic, std::string_view name) {
+        Profiler& profiler = Profiler::getInstance();
+        if (profiler.isEnabled()) {
+            m_name = profiler.intern(name);
+            m_start = profiler.now();
+        }
+    }
+
+    ~ProfileZone() {
+        if (m_name) {
+            Profiler& profiler = Profiler::getInstance();
+            profiler.record(m_name, m_start, profiler.now());
+        }
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* m_name = nullptr;
+    uint64_t m_start = 0;
+};
+
+} // namespace Profiling
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if PROFILING_ENABLED
+// Profile the rest of the enclosing scope under a literal name
+#define PROFILE_ZONE(name) Profiling::ProfileZone PROFILE_CONCAT(profileZone_, __LINE__)(name)
+// Same, for names built at runtime (interned when recording is enabled)
+#define PROFILE_ZONE_DYNAMIC(name) \
+    Profiling::ProfileZone PROFILE_CONCAT(profileZone_, __LINE__)(Profiling::ProfileZone::Dynamic{}, name)
+#define PROFILE_FUNCTION() PROFILE_ZONE(__func__)
+#define PROFILE_THREAD_NAME(name) Profiling::Profiler::getInstance().setThreadName(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_ZONE_DYNAMIC(name) ((void)0)
+#define PROFILE_FUNCTION() ((void)0)
+#define PROFILE_THREAD_NAME(name) ((void)0)
+#endif
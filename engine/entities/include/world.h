@@ -0,0 +1,393 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "component_type.h"
+
+namespace entities {
+
+// Generational entity handle; a stale handle (destroyed entity, reused index) never matches
+struct EntityId {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool IsValid() const { return index != UINT32_MAX; }
+    bool operator==(const EntityId& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const EntityId& other) const { return !(*this == other); }
+};
+
+constexpr EntityId INVALID_ENTITY{};
+
+// Type-erased view of a component store so a World can manage stores of any component type
+class ComponentStoreBase {
+public:
+    static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+
+    virtual ~ComponentStoreBase() = default;
+    virtual void Remove(uint32_t entity_index) = 0;
+    virtual bool Has(uint32_t entity_index) const = 0;
+    virtual size_t Size() const = 0;
+    virtual void Clear() = 0;
+    // Entity index owning each dense slot
+    virtual const std::vector<uint32_t>& Owners() const = 0;
+    // Entity index -> dense slot (INVALID_SLOT when absent)
+    virtual const std::vector<uint32_t>& Sparse() const = 0;
+
+    // Raw layout, used by snapshots
+    virtual const char* TypeName() const = 0;
+    virtual uint32_t SchemaVersion() const = 0;
+    virtual size_t ElementSize() const = 0;
+    virtual bool IsTriviallyCopyable() const = 0;
+    virtual const void* RawData() const = 0;
+    // Replace the whole store with raw arrays; only supported for trivially copyable components
+    virtual bool LoadRaw(const void* dense, const uint32_t* owners, size_t count, const uint32_t* sparse, size_t sparse_count) = 0;
+    // Component bytes of an entity, nullptr when absent
+    virtual void* RawGet(uint32_t entity_index) = 0;
+    // Add (or overwrite) a component from raw bytes; only supported for trivially copyable components
+    virtual bool RawEmplace(uint32_t entity_index, const void* bytes) = 0;
+
+    // Change tracking: the world tick at which a component was last written
+    virtual void MarkChanged(uint32_t entity_index, uint32_t tick) = 0;
+    virtual uint32_t ChangeVersion(uint32_t entity_index) const = 0;
+    // Newest tick any component was marked with, so untouched stores can be skipped without a scan
+    virtual uint32_t MaxChangeVersion() const = 0;
+    // Bumped whenever a component is added or removed (including Clear and LoadRaw)
+    virtual uint64_t StructureVersion() const = 0;
+};
+
+/**
+ * @brief Sparse-set storage for one component type inside a World
+ *
+ * Components are packed densely in insertion order; removal swaps the last
+ * element into the hole. The sparse array maps entity index -> dense slot.
+ */
+template<typename T>
+class ComponentStore : public ComponentStoreBase {
+public:
+    template<typename... Args>
+    T& Emplace(uint32_t entity_index, Args&&... args) {
+        if (entity_index >= m_sparse.size()) {
+            m_sparse.resize(entity_index + 1, INVALID_SLOT);
+        }
+        uint32_t slot = m_sparse[entity_index];
+        if (slot != INVALID_SLOT) {
+            m_dense[slot] = T{ std::forward<Args>(args)... };
+            return m_dense[slot];
+        }
+        m_sparse[entity_index] = static_cast<uint32_t>(m_dense.size());
+        ++m_structureVersion;
+        m_owners.push_back(entity_index);
+        m_versions.push_back(0);
+        m_dense.push_back(T{ std::forward<Args>(args)... });
+        return m_dense.back();
+    }
+
+    T* Get(uint32_t entity_index) {
+        if (entity_index >= m_sparse.size() || m_sparse[entity_index] == INVALID_SLOT) return nullptr;
+        return &m_dense[m_sparse[entity_index]];
+    }
+
+    const T* Get(uint32_t entity_index) const {
+        return const_cast<ComponentStore*>(this)->Get(entity_index);
+    }
+
+    void Remove(uint32_t entity_index) override {
+        if (!Has(entity_index)) return;
+        const uint32_t slot = m_sparse[entity_index];
+        const uint32_t last = static_cast<uint32_t>(m_dense.size() - 1);
+        if (slot != last) {
+            m_dense[slot] = std::move(m_dense[last]);
+            m_owners[slot] = m_owners[last];
+            m_versions[slot] = m_versions[last];
+            m_sparse[m_owners[slot]] = slot;
+        }
+        m_dense.pop_back();
+        m_owners.pop_back();
+        m_versions.pop_back();
+        m_sparse[entity_index] = INVALID_SLOT;
+        ++m_structureVersion;
+    }
+
+    bool Has(uint32_t entity_index) const override {
+        return entity_index < m_sparse.size() && m_sparse[entity_index] != INVALID_SLOT;
+    }
+
+    size_t Size() const override { return m_dense.size(); }
+
+    void Clear() override {
+        m_dense.clear();
+        m_owners.clear();
+        m_versions.clear();
+        m_sparse.clear();
+        ++m_structureVersion;
+    }
+
+    const std::vector<uint32_t>& Owners() const override { return m_owners; }
+    const std::vector<uint32_t>& Sparse() const override { return m_sparse; }
+
+    // Dense component array, parallel to Owners()
+    std::vector<T>& Data() { return m_dense; }
+    const std::vector<T>& Data() const { return m_dense; }
+
+    const char* TypeName() const override { return ComponentTypeName<T>(); }
+    uint32_t SchemaVersion() const override { return ComponentSchemaVersion<T>::value; }
+    size_t ElementSize() const override { return sizeof(T); }
+    bool IsTriviallyCopyable() const override { return std::is_trivially_copyable_v<T>; }
+    const void* RawData() const override { return m_dense.data(); }
+
+    bool LoadRaw(const void* dense, const uint32_t* owners, size_t count, const uint32_t* sparse, size_t sparse_count) override {
+        if constexpr (std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>) {
+            m_dense.resize(count);
+            if (count > 0) {
+                std::memcpy(static_cast<void*>(m_dense.data()), dense, count * sizeof(T));
+            }
+            m_owners.assign(owners, owners + count);
+            m_versions.assign(count, 0);
+            m_sparse.assign(sparse, sparse + sparse_count);
+            ++m_structureVersion;
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    void* RawGet(uint32_t entity_index) override {
+        return Get(entity_index);
+    }
+
+    bool RawEmplace(uint32_t entity_index, const void* bytes) override {
+        if constexpr (std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>) {
+            T& component = Emplace(entity_index);
+            std::memcpy(static_cast<void*>(&component), bytes, sizeof(T));
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    void MarkChanged(uint32_t entity_index, uint32_t tick) override {
+        if (!Has(entity_index)) return;
+        m_versions[m_sparse[entity_index]] = tick;
+        m_maxVersion = std::max(m_maxVersion, tick);
+    }
+
+    uint32_t ChangeVersion(uint32_t entity_index) const override {
+        return Has(entity_index) ? m_versions[m_sparse[entity_index]] : 0;
+    }
+
+    uint32_t MaxChangeVersion() const override { return m_maxVersion; }
+    uint64_t StructureVersion() const override { return m_structureVersion; }
+
+private:
+    std::vector<T> m_dense;
+    std::vector<uint32_t> m_owners;
+    std::vector<uint32_t> m_versions; // parallel to m_dense
+    std::vector<uint32_t> m_sparse;
+    uint32_t m_maxVersion = 0;
+    uint64_t m_structureVersion = 0;
+};
+
+/**
+ * @brief Self-contained ECS world
+ *
+ * Owns its entities and component storage, so several worlds can live in one
+ * process (parallel simulations, rollouts, isolated tests) without sharing
+ * state. A World is not internally synchronized: use one thread per world, or
+ * guard it externally. Component type ids are process-wide (GetComponentTypeId),
+ * which keeps signatures comparable between worlds.
+ *
+ * Components are plain structs; POD components (DEFINE_POD_COMPONENT) are the
+ * intended fit, since the World ignores the static pools of DEFINE_COMPONENT.
+ */
+class World {
+public:
+    World() = default;
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+    World(World&&) = default;
+    World& operator=(World&&) = default;
+
+    EntityId CreateEntity() {
+        uint32_t index;
+        if (!m_freeList.empty()) {
+            index = m_freeList.back();
+            m_freeList.pop_back();
+        } else {
+            index = static_cast<uint32_t>(m_generations.size());
+            m_generations.push_back(0);
+            m_signatures.emplace_back();
+            m_alive.push_back(false);
+        }
+        m_alive[index] = true;
+        ++m_entityCount;
+        return EntityId{ index, m_generations[index] };
+    }
+
+    // Destroys the entity and all its components; the index is recycled with a new generation
+    void DestroyEntity(EntityId entity) {
+        if (!IsAlive(entity)) return;
+        for (auto& store : m_stores) {
+            if (store) store->Remove(entity.index);
+        }
+        m_signatures[entity.index].reset();
+        m_alive[entity.index] = false;
+        ++m_generations[entity.index];
+        m_freeList.push_back(entity.index);
+        --m_entityCount;
+    }
+
+    bool IsAlive(EntityId entity) const {
+        return entity.index < m_generations.size() &&
+               m_alive[entity.index] &&
+               m_generations[entity.index] == entity.generation;
+    }
+
+    // Adds (or replaces) a component on a live entity
+    template<typename T, typename... Args>
+    T* AddComponent(EntityId entity, Args&&... args) {
+        if (!IsAlive(entity)) return nullptr;
+        ComponentStore<T>& store = Storage<T>();
+        T& component = store.Emplace(entity.index, std::forward<Args>(args)...);
+        store.MarkChanged(entity.index, m_changeTick);
+        m_signatures[entity.index].set(GetComponentTypeId<T>());
+        return &component;
+    }
+
+    // Mutable access; marks the component as changed in the current tick
+    template<typename T>
+    T* GetComponent(EntityId entity) {
+        if (!IsAlive(entity)) return nullptr;
+        ComponentStore<T>* store = FindStorage<T>();
+        if (!store) return nullptr;
+        store->MarkChanged(entity.index, m_changeTick);
+        return store->Get(entity.index);
+    }
+
+    // Read-only access; does not affect change tracking
+    template<typename T>
+    const T* ReadComponent(EntityId entity) const {
+        if (!IsAlive(entity)) return nullptr;
+        const ComponentStore<T>* store = FindStorage<T>();
+        return store ? store->Get(entity.index) : nullptr;
+    }
+
+    template<typename T>
+    bool HasComponent(EntityId entity) const {
+        return IsAlive(entity) && m_signatures[entity.index].test(GetComponentTypeId<T>());
+    }
+
+    template<typename T>
+    void RemoveComponent(EntityId entity) {
+        if (!IsAlive(entity)) return;
+        ComponentStore<T>* store = FindStorage<T>();
+        if (!store) return;
+        store->Remove(entity.index);
+        m_signatures[entity.index].reset(GetComponentTypeId<T>());
+    }
+
+    // Create the store for T up front (optional; stores are also created on first AddComponent)
+    template<typename T>
+    void RegisterComponent() {
+        Storage<T>();
+    }
+
+    template<typename T>
+    ComponentStore<T>& Storage() {
+        const ComponentTypeId type = GetComponentTypeId<T>();
+        if (type >= m_stores.size()) {
+            m_stores.resize(type + 1);
+        }
+        if (!m_stores[type]) {
+            m_stores[type] = std::make_unique<ComponentStore<T>>();
+        }
+        return static_cast<ComponentStore<T>&>(*m_stores[type]);
+    }
+
+    // Store for T, or nullptr if no T was ever added to this world
+    template<typename T>
+    ComponentStore<T>* FindStorage() const {
+        const ComponentTypeId type = GetComponentTypeId<T>();
+        if (type >= m_stores.size() || !m_stores[type]) return nullptr;
+        return static_cast<ComponentStore<T>*>(m_stores[type].get());
+    }
+
+    /**
+     * @brief Invoke `func(EntityId, Ts&...)` for every entity that has all of Ts
+     *
+     * Iterates the smallest of the involved stores and filters by signature.
+     * Every visited component is marked as changed in the current tick.
+     * Do not add or remove components of Ts from inside `func`.
+     */
+    template<typename... Ts, typename Func>
+    void Each(Func&& func) {
+        static_assert(sizeof...(Ts) > 0, "Each needs at least one component type");
+        const ComponentStoreBase* stores[] = { FindStorage<Ts>()... };
+        const ComponentStoreBase* smallest = nullptr;
+        for (const ComponentStoreBase* store : stores) {
+            if (!store) return;
+            if (!smallest || store->Size() < smallest->Size()) smallest = store;
+        }
+
+        const ComponentSignature query = MakeSignature<Ts...>();
+        const std::vector<uint32_t>& owners = smallest->Owners();
+        for (size_t i = 0; i < owners.size(); ++i) {
+            const uint32_t index = owners[i];
+            if (!SignatureMatches(m_signatures[index], query)) continue;
+            (FindStorage<Ts>()->MarkChanged(index, m_changeTick), ...);
+            func(EntityId{ index, m_generations[index] }, *FindStorage<Ts>()->Get(index)...);
+        }
+    }
+
+    // All entities that have every component in Ts
+    template<typename... Ts>
+    std::vector<EntityId> Query() const {
+        return Query(MakeSignature<Ts...>());
+    }
+
+    std::vector<EntityId> Query(const ComponentSignature& query) const {
+        std::vector<EntityId> result;
+        for (uint32_t index = 0; index < m_signatures.size(); ++index) {
+            if (m_alive[index] && SignatureMatches(m_signatures[index], query)) {
+                result.push_back(EntityId{ index, m_generations[index] });
+            }
+        }
+        return result;
+    }
+
+    ComponentSignature GetSignature(EntityId entity) const {
+        return IsAlive(entity) ? m_signatures[entity.index] : ComponentSignature{};
+    }
+
+    size_t GetEntityCount() const { return m_entityCount; }
+
+    // Writes through GetComponent/AddComponent/Each are stamped with this tick
+    uint32_t GetChangeTick() const { return m_changeTick; }
+    uint32_t AdvanceChangeTick() { return ++m_changeTick; }
+
+    // Destroy every entity and component; generations are kept so old handles stay invalid
+    void Clear() {
+        for (uint32_t index = 0; index < m_alive.size(); ++index) {
+            if (m_alive[index]) {
+                DestroyEntity(EntityId{ index, m_generations[index] });
+            }
+        }
+    }
+
+private:
+    friend class WorldSnapshot;
+    friend class DeltaRecorder;
+
+    std::vector<uint32_t> m_generations;
+    std::vector<ComponentSignature> m_signatures;
+    std::vector<bool> m_alive;
+    std::vector<uint32_t> m_freeList;
+    std::vector<std::unique_ptr<ComponentStoreBase>> m_stores; // indexed by ComponentTypeId
+    size_t m_entityCount = 0;
+    uint32_t m_changeTick = 1;
+};
+
+} // namespace entities
@@ -0,0 +1,440 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "world.h"
+#include "utils/LogMacros.h"
+
+namespace entities {
+
+// One recorded frame: the XOR difference between two consecutive world states
+struct WorldDelta {
+    uint64_t frame = 0;        // frame the delta leads to
+    std::vector<uint8_t> data; // encoded records, see DeltaRecorder
+};
+
+/**
+ * @brief Per-frame delta history of a World for rollback and replay
+ *
+ * Keeps a baseline copy of every trivially copyable component store (indexed
+ * by entity index, like the store's sparse array) and, on Record(), encodes
+ * only the components whose change version is newer than the previous record.
+ * Each change is stored as (baseline XOR current), zero-run/varint encoded,
+ * plus a presence toggle; an absent component counts as all-zero bytes. The
+ * encoding is symmetric, so the same delta steps the world forward or back.
+ *
+ * Deltas live in a fixed-size ring; the oldest frame is dropped when it is
+ * full. Recording after StepBack() discards the frames ahead of the cursor.
+ *
+ * Writes must go through World::GetComponent/AddComponent/Each (or be followed
+ * by ComponentStoreBase::MarkChanged) to be picked up; ReadComponent and raw
+ * Storage<T>().Data() access are not tracked. Stores with no writes and no
+ * adds/removes since the previous record are skipped without a scan, and a
+ * store whose components were only written visits just its live components.
+ *
+ * Encoding of WorldDelta::data:
+ *   varint slots_before, varint slots_after
+ *   varint entity_count, per entity: varint index_gap, varint generation_xor, u8 alive_xor
+ *   u8 free_list_changed [, varint n, n * varint (before), varint n, n * varint (after)]
+ *   varint column_count, per column: varint type_id, varint element_size, varint record_count,
+ *     per record: varint index_gap, u8 presence_toggle, zero-run encoded XOR bytes
+ */
+class DeltaRecorder {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 256;
+
+    explicit DeltaRecorder(size_t capacity = DEFAULT_CAPACITY)
+        : m_ring(capacity > 0 ? capacity : 1) {}
+
+    // Take the current world state as the baseline and clear the history
+    void Begin(World& world) {
+        m_head = 0;
+        m_count = 0;
+        m_cursor = 0;
+        m_frame = 0;
+        m_generations = world.m_generations;
+        m_alive.assign(world.m_alive.begin(), world.m_alive.end());
+        m_freeList = world.m_freeList;
+        m_columns.clear();
+        for (ComponentTypeId type = 0; type < world.m_stores.size(); ++type) {
+            ComponentStoreBase* store = world.m_stores[type].get();
+            if (!store) continue;
+            if (!store->IsTriviallyCopyable()) {
+                LOG_WARNING << "Component " << store->TypeName() << " is not trivially copyable, not recorded" << LOG_END;
+                continue;
+            }
+            ColumnBaseline& column = GetColumn(type, store->ElementSize());
+            const size_t slots = std::max(world.m_generations.size(), store->Sparse().size());
+            Reserve(column, slots);
+            for (uint32_t owner : store->Owners()) {
+                std::memcpy(&column.bytes[owner * column.element_size], store->RawGet(owner), column.element_size);
+                column.present[owner] = 1;
+            }
+            column.store = store;
+            column.structure_version = store->StructureVersion();
+        }
+        m_lastTick = world.GetChangeTick();
+        world.AdvanceChangeTick();
+    }
+
+    // Encode everything that changed since the previous Record/Begin; returns the encoded size
+    size_t Record(World& world) {
+        // Recording from an earlier frame forks the history
+        m_count = m_cursor;
+        if (m_count == m_ring.size()) {
+            m_head = (m_head + 1) % m_ring.size();
+            --m_count;
+        }
+
+        WorldDelta& delta = m_ring[(m_head + m_count) % m_ring.size()];
+        delta.frame = ++m_frame;
+        delta.data.clear();
+        EncodeEntities(world, delta.data);
+        EncodeColumns(world, delta.data);
+
+        ++m_count;
+        m_cursor = m_count;
+        m_lastTick = world.GetChangeTick();
+        world.AdvanceChangeTick();
+        return delta.data.size();
+    }
+
+    // Undo the most recent frame at the cursor
+    bool StepBack(World& world) {
+        if (!CanStepBack()) return false;
+        const WorldDelta& delta = m_ring[(m_head + m_cursor - 1) % m_ring.size()];
+        Apply(world, delta, false);
+        --m_cursor;
+        --m_frame;
+        return true;
+    }
+
+    // Redo the frame after the cursor
+    bool StepForward(World& world) {
+        if (!CanStepForward()) return false;
+        const WorldDelta& delta = m_ring[(m_head + m_cursor) % m_ring.size()];
+        Apply(world, delta, true);
+        ++m_cursor;
+        ++m_frame;
+        return true;
+    }
+
+    bool CanStepBack() const { return m_cursor > 0; }
+    bool CanStepForward() const { return m_cursor < m_count; }
+
+    // Frame the world is currently at (0 = Begin)
+    uint64_t GetFrame() const { return m_frame; }
+    // Number of deltas retained in the ring
+    size_t GetHistorySize() const { return m_count; }
+    size_t GetCapacity() const { return m_ring.size(); }
+
+    // Total encoded bytes of all retained deltas
+    size_t GetHistoryBytes() const {
+        size_t bytes = 0;
+        for (size_t i = 0; i < m_count; ++i) {
+            bytes += m_ring[(m_head + i) % m_ring.size()].data.size();
+        }
+        return bytes;
+    }
+
+private:
+    // Baseline copy of one component store, indexed by entity index
+    struct ColumnBaseline {
+        size_t element_size = 0;
+        std::vector<uint8_t> bytes;
+        std::vector<uint8_t> present;
+        // Store and structure version the presence flags were last synced with
+        const ComponentStoreBase* store = nullptr;
+        uint64_t structure_version = 0;
+    };
+
+    class Reader {
+    public:
+        explicit Reader(const std::vector<uint8_t>& data) : m_data(data) {}
+
+        uint8_t Byte() { return m_pos < m_data.size() ? m_data[m_pos++] : 0; }
+
+        uint64_t Varint() {
+            uint64_t value = 0;
+            for (int shift = 0; shift < 64 && m_pos < m_data.size(); shift += 7) {
+                const uint8_t byte = m_data[m_pos++];
+                value |= uint64_t(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) break;
+            }
+            return value;
+        }
+
+        // Decode `size` zero-run encoded bytes into `out`
+        void XorBytes(uint8_t* out, size_t size) {
+            size_t written = 0;
+            while (written < size && m_pos < m_data.size()) {
+                const size_t zeros = std::min<size_t>(Varint(), size - written);
+                std::memset(out + written, 0, zeros);
+                written += zeros;
+                const size_t literal = std::min<size_t>(Varint(), size - written);
+                std::memcpy(out + written, m_data.data() + m_pos, std::min(literal, m_data.size() - m_pos));
+                m_pos += literal;
+                written += literal;
+            }
+            std::memset(out + written, 0, size - written);
+        }
+
+    private:
+        const std::vector<uint8_t>& m_data;
+        size_t m_pos = 0;
+    };
+
+    static void WriteVarint(std::vector<uint8_t>& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    // Alternating (zero run, literal run) pairs; an unchanged float costs two bytes
+    static void WriteXorBytes(std::vector<uint8_t>& out, const uint8_t* bytes, size_t size) {
+        size_t i = 0;
+        while (i < size) {
+            size_t zeros = 0;
+            while (i + zeros < size && bytes[i + zeros] == 0) ++zeros;
+            i += zeros;
+            size_t literal = 0;
+            while (i + literal < size && bytes[i + literal] != 0) ++literal;
+            WriteVarint(out, zeros);
+            WriteVarint(out, literal);
+            out.insert(out.end(), bytes + i, bytes + i + literal);
+            i += literal;
+        }
+    }
+
+    ColumnBaseline& GetColumn(ComponentTypeId type, size_t element_size) {
+        if (type >= m_columns.size()) {
+            m_columns.resize(type + 1);
+        }
+        ColumnBaseline& column = m_columns[type];
+        if (column.element_size == 0) {
+            column.element_size = element_size;
+        }
+        return column;
+    }
+
+    static void Reserve(ColumnBaseline& column, size_t slots) {
+        if (column.present.size() < slots) {
+            column.present.resize(slots, 0);
+            column.bytes.resize(slots * column.element_size, 0);
+        }
+    }
+
+    void EncodeEntities(const World& world, std::vector<uint8_t>& out) {
+        const size_t before = m_generations.size();
+        const size_t after = world.m_generations.size();
+        const size_t slots = std::max(before, after);
+        WriteVarint(out, before);
+        WriteVarint(out, after);
+
+        std::vector<uint8_t> records;
+        size_t record_count = 0;
+        uint32_t previous = 0;
+        m_generations.resize(slots, 0);
+        m_alive.resize(slots, 0);
+        for (uint32_t index = 0; index < slots; ++index) {
+            const uint32_t generation = index < after ? world.m_generations[index] : 0;
+            const uint8_t alive = index < after && world.m_alive[index] ? 1 : 0;
+            if (generation == m_generations[index] && alive == m_alive[index]) continue;
+            WriteVarint(records, index - previous);
+            WriteVarint(records, generation ^ m_generations[index]);
+            records.push_back(alive ^ m_alive[index]);
+            m_generations[index] = generation;
+            m_alive[index] = alive;
+            previous = index;
+            ++record_count;
+        }
+        m_generations.resize(after);
+        m_alive.resize(after);
+        WriteVarint(out, record_count);
+        out.insert(out.end(), records.begin(), records.end());
+
+        const bool free_list_changed = world.m_freeList != m_freeList;
+        out.push_back(free_list_changed ? 1 : 0);
+        if (free_list_changed) {
+            WriteVarint(out, m_freeList.size());
+            for (uint32_t index : m_freeList) WriteVarint(out, index);
+            WriteVarint(out, world.m_freeList.size());
+            for (uint32_t index : world.m_freeList) WriteVarint(out, index);
+            m_freeList = world.m_freeList;
+        }
+    }
+
+    void EncodeColumns(World& world, std::vector<uint8_t>& out) {
+        std::vector<uint8_t> columns;
+        size_t column_count = 0;
+        std::vector<uint8_t> scratch;
+        std::vector<uint32_t> candidates;
+
+        for (ComponentTypeId type = 0; type < world.m_stores.size(); ++type) {
+            ComponentStoreBase* store = world.m_stores[type].get();
+            if (!store || !store->IsTriviallyCopyable()) continue;
+            ColumnBaseline& column = GetColumn(type, store->ElementSize());
+            const bool structure_changed = column.store != store || column.structure_version != store->StructureVersion();
+            if (!structure_changed && store->MaxChangeVersion() <= m_lastTick) continue;
+
+            const size_t size = column.element_size;
+            const size_t slots = std::max(column.present.size(), store->Sparse().size());
+            Reserve(column, slots);
+            scratch.resize(size);
+
+            // Without adds or removes the baseline has the same components as the store,
+            // so only the ones written since the last record can differ
+            candidates.clear();
+            if (structure_changed) {
+                for (uint32_t index = 0; index < slots; ++index) {
+                    if (store->Has(index) || column.present[index]) candidates.push_back(index);
+                }
+            } else {
+                for (uint32_t owner : store->Owners()) {
+                    if (store->ChangeVersion(owner) > m_lastTick) candidates.push_back(owner);
+                }
+                std::sort(candidates.begin(), candidates.end());
+            }
+
+            std::vector<uint8_t> records;
+            size_t record_count = 0;
+            uint32_t previous = 0;
+            for (uint32_t index : candidates) {
+                const bool now = store->Has(index);
+                const bool before = column.present[index] != 0;
+                if (now && before && store->ChangeVersion(index) <= m_lastTick) continue;
+
+                uint8_t* baseline = &column.bytes[index * size];
+                const uint8_t* current = now ? static_cast<const uint8_t*>(store->RawGet(index)) : nullptr;
+                bool differs = now != before;
+                for (size_t b = 0; b < size; ++b) {
+                    scratch[b] = baseline[b] ^ (current ? current[b] : 0);
+                    differs |= scratch[b] != 0;
+                }
+                if (!differs) continue;
+
+                WriteVarint(records, index - previous);
+                records.push_back(now != before ? 1 : 0);
+                WriteXorBytes(records, scratch.data(), size);
+                if (current) {
+                    std::memcpy(baseline, current, size);
+                } else {
+                    std::memset(baseline, 0, size);
+                }
+                column.present[index] = now ? 1 : 0;
+                previous = index;
+                ++record_count;
+            }
+            column.store = store;
+            column.structure_version = store->StructureVersion();
+            if (record_count == 0) continue;
+
+            WriteVarint(columns, type);
+            WriteVarint(columns, size);
+            WriteVarint(columns, record_count);
+            columns.insert(columns.end(), records.begin(), records.end());
+            ++column_count;
+        }
+
+        WriteVarint(out, column_count);
+        out.insert(out.end(), columns.begin(), columns.end());
+    }
+
+    // Apply a delta to the world (and the baseline, which mirrors the world at the cursor)
+    void Apply(World& world, const WorldDelta& delta, bool forward) {
+        Reader reader(delta.data);
+        const size_t before = static_cast<size_t>(reader.Varint());
+        const size_t after = static_cast<size_t>(reader.Varint());
+        const size_t target = forward ? after : before;
+        const size_t slots = std::max(before, after);
+
+        world.m_generations.resize(slots, 0);
+        world.m_alive.resize(slots, false);
+        world.m_signatures.resize(slots);
+        const size_t entity_records = static_cast<size_t>(reader.Varint());
+        uint32_t index = 0;
+        for (size_t i = 0; i < entity_records; ++i) {
+            index += static_cast<uint32_t>(reader.Varint());
+            world.m_generations[index] ^= static_cast<uint32_t>(reader.Varint());
+            world.m_alive[index] = world.m_alive[index] != (reader.Byte() != 0);
+        }
+
+        if (reader.Byte() != 0) {
+            std::vector<uint32_t> lists[2];
+            for (auto& list : lists) {
+                list.resize(static_cast<size_t>(reader.Varint()));
+                for (auto& value : list) value = static_cast<uint32_t>(reader.Varint());
+            }
+            world.m_freeList = forward ? lists[1] : lists[0];
+        }
+
+        std::vector<uint8_t> scratch;
+        std::vector<uint8_t> value;
+        const size_t column_count = static_cast<size_t>(reader.Varint());
+        for (size_t c = 0; c < column_count; ++c) {
+            const ComponentTypeId type = static_cast<ComponentTypeId>(reader.Varint());
+            const size_t size = static_cast<size_t>(reader.Varint());
+            const size_t record_count = static_cast<size_t>(reader.Varint());
+            ComponentStoreBase* store = type < world.m_stores.size() ? world.m_stores[type].get() : nullptr;
+            ColumnBaseline& column = GetColumn(type, size);
+            scratch.resize(size);
+            value.resize(size);
+
+            index = 0;
+            for (size_t r = 0; r < record_count; ++r) {
+                index += static_cast<uint32_t>(reader.Varint());
+                const bool toggle = reader.Byte() != 0;
+                reader.XorBytes(scratch.data(), size);
+                if (!store || store->ElementSize() != size) continue;
+
+                const bool present = store->Has(index);
+                const uint8_t* current = present ? static_cast<const uint8_t*>(store->RawGet(index)) : nullptr;
+                for (size_t b = 0; b < size; ++b) {
+                    value[b] = scratch[b] ^ (current ? current[b] : 0);
+                }
+                const bool now = present != toggle;
+                if (now) {
+                    store->RawEmplace(index, value.data());
+                    world.m_signatures[index].set(type);
+                } else {
+                    store->Remove(index);
+                    world.m_signatures[index].reset(type);
+                }
+
+                Reserve(column, index + 1);
+                if (now) {
+                    std::memcpy(&column.bytes[index * size], value.data(), size);
+                } else {
+                    std::memset(&column.bytes[index * size], 0, size);
+                }
+                column.present[index] = now ? 1 : 0;
+            }
+        }
+
+        world.m_generations.resize(target);
+        world.m_alive.resize(target);
+        world.m_signatures.resize(target);
+        world.m_entityCount = static_cast<size_t>(std::count(world.m_alive.begin(), world.m_alive.end(), true));
+
+        m_generations = world.m_generations;
+        m_alive.assign(world.m_alive.begin(), world.m_alive.end());
+        m_freeList = world.m_freeList;
+    }
+
+    std::vector<WorldDelta> m_ring;
+    size_t m_head = 0;   // oldest delta
+    size_t m_count = 0;  // deltas retained
+    size_t m_cursor = 0; // deltas currently applied, in [0, m_count]
+    uint64_t m_frame = 0;
+    uint32_t m_lastTick = 0;
+
+    std::vector<ColumnBaseline> m_columns; // indexed by ComponentTypeId
+    std::vector<uint32_t> m_generations;
+    std::vector<uint8_t> m_alive;
+    std::vector<uint32_t> m_freeList;
+};
+
+} // namespace entities
@@ -0,0 +1,355 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "world.h"
+#include "utils/fixed_string.h"
+#include "utils/mapped_file.h"
+#include "utils/LogMacros.h"
+
+namespace entities {
+
+constexpr char SNAPSHOT_MAGIC[8] = { 'E', 'C', 'S', 'S', 'N', 'A', 'P', '\0' };
+constexpr uint32_t SNAPSHOT_VERSION = 1;
+// Every section starts on this boundary so columns can be read in place from a mapping
+constexpr uint64_t SNAPSHOT_ALIGNMENT = 16;
+
+/*
+ * Snapshot file layout (host endianness, all offsets from the start of the file):
+ *
+ *   SnapshotHeader
+ *   SnapshotColumn[column_count]
+ *   uint32_t generations[entity_slots]
+ *   uint8_t  alive[entity_slots]
+ *   uint32_t free_list[free_count]
+ *   per column: T dense[count], uint32_t owners[count], uint32_t sparse[sparse_count]
+ *
+ * Columns are the raw sparse-set arrays of each component store, so restoring
+ * a column is three memcpys. Signatures are not stored; they are rebuilt from
+ * the owner arrays because component type ids are only stable within a build.
+ */
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t column_count;
+    uint64_t entity_slots;
+    uint64_t live_count;
+    uint64_t free_count;
+    uint64_t columns_offset;
+    uint64_t generations_offset;
+    uint64_t alive_offset;
+    uint64_t free_list_offset;
+    uint64_t file_size;
+};
+
+struct SnapshotColumn {
+    utils::FixedString<63> name;
+    uint32_t schema_version;
+    uint32_t element_size;
+    uint64_t count;
+    uint64_t sparse_count;
+    uint64_t data_offset;
+    uint64_t owners_offset;
+    uint64_t sparse_offset;
+};
+
+/**
+ * @brief Binary snapshots of a World
+ *
+ * Only trivially copyable component stores are written; other stores are
+ * skipped with a warning. On restore, columns are matched by component type
+ * name against the stores already registered in the destination world
+ * (World::RegisterComponent<T>()); element size and schema version must match.
+ */
+class WorldSnapshot {
+public:
+    // Bytes needed to snapshot `world`
+    static size_t ComputeSize(const World& world) {
+        return BuildLayout(world, nullptr).file_size;
+    }
+
+    // Serialize into `dst`; returns the number of bytes written, 0 if `capacity` is too small
+    static size_t Write(const World& world, uint8_t* dst, size_t capacity) {
+        std::vector<SnapshotColumn> columns;
+        std::vector<const ComponentStoreBase*> stores;
+        SnapshotHeader header = BuildLayout(world, &columns, &stores);
+        if (capacity < header.file_size) {
+            LOG_ERROR << "Snapshot buffer too small: " << capacity << " < " << header.file_size << LOG_END;
+            return 0;
+        }
+
+        std::memset(dst, 0, header.file_size);
+        std::memcpy(dst, &header, sizeof(header));
+        std::memcpy(dst + header.columns_offset, columns.data(), columns.size() * sizeof(SnapshotColumn));
+        CopyOut(dst + header.generations_offset, world.m_generations.data(), header.entity_slots * sizeof(uint32_t));
+        for (size_t i = 0; i < world.m_alive.size(); ++i) {
+            dst[header.alive_offset + i] = world.m_alive[i] ? 1 : 0;
+        }
+        CopyOut(dst + header.free_list_offset, world.m_freeList.data(), header.free_count * sizeof(uint32_t));
+
+        for (size_t i = 0; i < columns.size(); ++i) {
+            const SnapshotColumn& column = columns[i];
+            CopyOut(dst + column.data_offset, stores[i]->RawData(), column.count * column.element_size);
+            CopyOut(dst + column.owners_offset, stores[i]->Owners().data(), column.count * sizeof(uint32_t));
+            CopyOut(dst + column.sparse_offset, stores[i]->Sparse().data(), column.sparse_count * sizeof(uint32_t));
+        }
+        return header.file_size;
+    }
+
+    // In-memory checkpoint
+    static std::vector<uint8_t> Capture(const World& world) {
+        std::vector<uint8_t> buffer(ComputeSize(world));
+        Write(world, buffer.data(), buffer.size());
+        return buffer;
+    }
+
+    // Replace the contents of `world` with a snapshot; on failure `world` is left untouched
+    static bool Restore(World& world, const uint8_t* data, size_t size) {
+        if (size < sizeof(SnapshotHeader)) {
+            LOG_ERROR << "Snapshot too small" << LOG_END;
+            return false;
+        }
+        SnapshotHeader header;
+        std::memcpy(&header, data, sizeof(header));
+        if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+            LOG_ERROR << "Not a world snapshot" << LOG_END;
+            return false;
+        }
+        if (header.version != SNAPSHOT_VERSION) {
+            LOG_ERROR << "Unsupported snapshot version " << header.version << LOG_END;
+            return false;
+        }
+        uint64_t columns_bytes = 0;
+        uint64_t generations_bytes = 0;
+        uint64_t free_list_bytes = 0;
+        if (header.file_size > size ||
+            !CheckedMul(header.column_count, sizeof(SnapshotColumn), columns_bytes) ||
+            !CheckedMul(header.entity_slots, sizeof(uint32_t), generations_bytes) ||
+            !CheckedMul(header.free_count, sizeof(uint32_t), free_list_bytes) ||
+            !InBounds(header.columns_offset, columns_bytes, size) ||
+            !InBounds(header.generations_offset, generations_bytes, size) ||
+            !InBounds(header.alive_offset, header.entity_slots, size) ||
+            !InBounds(header.free_list_offset, free_list_bytes, size) ||
+            header.entity_slots >= UINT32_MAX || header.live_count > header.entity_slots ||
+            header.free_count > header.entity_slots) {
+            LOG_ERROR << "Snapshot is truncated or corrupt" << LOG_END;
+            return false;
+        }
+        const size_t slots = static_cast<size_t>(header.entity_slots);
+
+        std::vector<uint32_t> free_list(static_cast<size_t>(header.free_count));
+        CopyIn(free_list.data(), data + header.free_list_offset, free_list.size() * sizeof(uint32_t));
+        for (uint32_t index : free_list) {
+            if (index >= slots) {
+                LOG_ERROR << "Snapshot free list entry " << index << " is out of range" << LOG_END;
+                return false;
+            }
+        }
+
+        // Validate every column before the world is touched
+        std::vector<ColumnLoad> loads;
+        for (uint32_t i = 0; i < header.column_count; ++i) {
+            SnapshotColumn column;
+            std::memcpy(static_cast<void*>(&column), data + header.columns_offset + i * sizeof(SnapshotColumn), sizeof(column));
+            column.name.m_data[column.name.capacity()] = '\0';
+            uint64_t data_bytes = 0;
+            uint64_t owners_bytes = 0;
+            uint64_t sparse_bytes = 0;
+            if (!CheckedMul(column.count, column.element_size, data_bytes) ||
+                !CheckedMul(column.count, sizeof(uint32_t), owners_bytes) ||
+                !CheckedMul(column.sparse_count, sizeof(uint32_t), sparse_bytes) ||
+                !InBounds(column.data_offset, data_bytes, size) ||
+                !InBounds(column.owners_offset, owners_bytes, size) ||
+                !InBounds(column.sparse_offset, sparse_bytes, size) ||
+                column.count > header.entity_slots || column.sparse_count > header.entity_slots) {
+                LOG_ERROR << "Snapshot column " << column.name.c_str() << " is out of bounds" << LOG_END;
+                return false;
+            }
+
+            ComponentTypeId type = FindStore(world, column.name.view());
+            if (type == INVALID_COMPONENT_TYPE) {
+                LOG_WARNING << "Snapshot column " << column.name.c_str() << " has no registered component, skipped" << LOG_END;
+                continue;
+            }
+            const ComponentStoreBase& store = *world.m_stores[type];
+            if (!store.IsTriviallyCopyable() || store.ElementSize() != column.element_size || store.SchemaVersion() != column.schema_version) {
+                LOG_WARNING << "Snapshot column " << column.name.c_str() << " layout does not match (schema "
+                            << column.schema_version << ", expected " << store.SchemaVersion() << "), skipped" << LOG_END;
+                continue;
+            }
+
+            // Owners/sparse may be unaligned in a caller-provided buffer, so stage them through vectors
+            ColumnLoad load;
+            load.type = type;
+            load.dense = data + column.data_offset;
+            load.owners.resize(static_cast<size_t>(column.count));
+            load.sparse.resize(static_cast<size_t>(column.sparse_count));
+            CopyIn(load.owners.data(), data + column.owners_offset, load.owners.size() * sizeof(uint32_t));
+            CopyIn(load.sparse.data(), data + column.sparse_offset, load.sparse.size() * sizeof(uint32_t));
+            // The store indexes these arrays without bounds checks, so they must describe a consistent sparse set
+            bool consistent = true;
+            for (size_t entity = 0; entity < load.sparse.size() && consistent; ++entity) {
+                const uint32_t slot = load.sparse[entity];
+                consistent = slot == ComponentStoreBase::INVALID_SLOT || (slot < load.owners.size() && load.owners[slot] == entity);
+            }
+            for (size_t slot = 0; slot < load.owners.size() && consistent; ++slot) {
+                const uint32_t owner = load.owners[slot];
+                consistent = owner < load.sparse.size() && load.sparse[owner] == slot;
+            }
+            if (!consistent) {
+                LOG_ERROR << "Snapshot column " << column.name.c_str() << " has inconsistent owner/sparse arrays" << LOG_END;
+                return false;
+            }
+            loads.push_back(std::move(load));
+        }
+
+        world.m_generations.resize(slots);
+        CopyIn(world.m_generations.data(), data + header.generations_offset, slots * sizeof(uint32_t));
+        world.m_alive.assign(slots, false);
+        for (size_t i = 0; i < slots; ++i) {
+            world.m_alive[i] = data[header.alive_offset + i] != 0;
+        }
+        world.m_freeList = std::move(free_list);
+        world.m_signatures.assign(slots, ComponentSignature{});
+        world.m_entityCount = static_cast<size_t>(header.live_count);
+        for (auto& store : world.m_stores) {
+            if (store) store->Clear();
+        }
+
+        for (const ColumnLoad& load : loads) {
+            ComponentStoreBase& store = *world.m_stores[load.type];
+            if (!store.LoadRaw(load.dense, load.owners.data(), load.owners.size(), load.sparse.data(), load.sparse.size())) {
+                LOG_WARNING << "Component " << store.TypeName() << " cannot be loaded from raw bytes, skipped" << LOG_END;
+                store.Clear();
+                continue;
+            }
+            for (uint32_t owner : load.owners) {
+                world.m_signatures[owner].set(load.type);
+            }
+        }
+        return true;
+    }
+
+    static bool Save(const World& world, const std::string& path) {
+        const size_t size = ComputeSize(world);
+        utils::MappedFile file;
+        if (!file.Create(path, size)) {
+            return false;
+        }
+        if (Write(world, file.Data(), file.Size()) == 0) {
+            return false;
+        }
+        return file.Flush();
+    }
+
+    static bool Load(World& world, const std::string& path) {
+        utils::MappedFile file;
+        if (!file.OpenRead(path)) {
+            return false;
+        }
+        return Restore(world, file.Data(), file.Size());
+    }
+
+private:
+    // A validated column, ready to be loaded into its store
+    struct ColumnLoad {
+        ComponentTypeId type;
+        const uint8_t* dense;
+        std::vector<uint32_t> owners;
+        std::vector<uint32_t> sparse;
+    };
+
+    static uint64_t Align(uint64_t offset) {
+        return (offset + SNAPSHOT_ALIGNMENT - 1) & ~(SNAPSHOT_ALIGNMENT - 1);
+    }
+
+    static bool InBounds(uint64_t offset, uint64_t length, size_t size) {
+        return offset <= size && length <= size - offset;
+    }
+
+    // Sizes read from a file must not wrap around before they are bounds-checked
+    static bool CheckedMul(uint64_t a, uint64_t b, uint64_t& out) {
+        if (b != 0 && a > UINT64_MAX / b) return false;
+        out = a * b;
+        return true;
+    }
+
+    static void CopyOut(uint8_t* dst, const void* src, size_t bytes) {
+        if (bytes > 0) std::memcpy(dst, src, bytes);
+    }
+
+    static void CopyIn(void* dst, const uint8_t* src, size_t bytes) {
+        if (bytes > 0) std::memcpy(dst, src, bytes);
+    }
+
+    static ComponentTypeId FindStore(const World& world, std::string_view name) {
+        for (ComponentTypeId type = 0; type < world.m_stores.size(); ++type) {
+            const auto& store = world.m_stores[type];
+            if (store && name == store->TypeName()) {
+                return type;
+            }
+        }
+        return INVALID_COMPONENT_TYPE;
+    }
+
+    // Compute section offsets; optionally collect the column descriptors and their stores
+    static SnapshotHeader BuildLayout(const World& world,
+                                      std::vector<SnapshotColumn>* columns,
+                                      std::vector<const ComponentStoreBase*>* stores = nullptr) {
+        std::vector<const ComponentStoreBase*> written;
+        for (const auto& store : world.m_stores) {
+            if (!store) continue;
+            if (!store->IsTriviallyCopyable()) {
+                if (columns) {
+                    LOG_WARNING << "Component " << store->TypeName() << " is not trivially copyable, not included in snapshot" << LOG_END;
+                }
+                continue;
+            }
+            written.push_back(store.get());
+        }
+
+        SnapshotHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+        header.version = SNAPSHOT_VERSION;
+        header.column_count = static_cast<uint32_t>(written.size());
+        header.entity_slots = world.m_generations.size();
+        header.live_count = world.m_entityCount;
+        header.free_count = world.m_freeList.size();
+
+        uint64_t offset = Align(sizeof(SnapshotHeader));
+        header.columns_offset = offset;
+        offset = Align(offset + written.size() * sizeof(SnapshotColumn));
+        header.generations_offset = offset;
+        offset = Align(offset + header.entity_slots * sizeof(uint32_t));
+        header.alive_offset = offset;
+        offset = Align(offset + header.entity_slots);
+        header.free_list_offset = offset;
+        offset = Align(offset + header.free_count * sizeof(uint32_t));
+
+        for (const ComponentStoreBase* store : written) {
+            SnapshotColumn column;
+            std::memset(static_cast<void*>(&column), 0, sizeof(column));
+            column.name = store->TypeName();
+            column.schema_version = store->SchemaVersion();
+            column.element_size = static_cast<uint32_t>(store->ElementSize());
+            column.count = store->Size();
+            column.sparse_count = store->Sparse().size();
+            column.data_offset = offset;
+            offset = Align(offset + column.count * column.element_size);
+            column.owners_offset = offset;
+            offset = Align(offset + column.count * sizeof(uint32_t));
+            column.sparse_offset = offset;
+            offset = Align(offset + column.sparse_count * sizeof(uint32_t));
+            if (columns) columns->push_back(column);
+        }
+        if (stores) *stores = written;
+
+        header.file_size = offset;
+        return header;
+    }
+};
+
+} // namespace entities
@@ -8,4 +8,11 @@ namespace Logging {
     LogStream Logger::warning() { return LogStream(LogLevel::Warning, *this); }
     LogStream Logger::error() { return LogStream(LogLevel::Error, *this); }
     LogStream Logger::fatal() { return LogStream(LogLevel::Fatal, *this); }
+
+    void LogStream::flush() {
+        if (m_active && m_length > 0) {
+            m_logger.log(m_level, view());
+            m_length = 0; // Clear the buffer
+        }
+    }
 } 
\ No newline at end of file
@@ -0,0 +1,319 @@
+#include "utils/BinaryLog.h"
+#include "LogMacros.h"
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace Logging {
+
+namespace {
+
+struct BinaryFormat {
+    LogLevel level;
+    std::string format;
+    std::string file;
+    int line;
+};
+
+// Process-wide table of format strings indexed by format id
+class BinaryFormatTable {
+public:
+    uint32_t add(LogLevel level, const char* format, const char* file, int line) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_formats.push_back({ level, format ? format : "", file ? file : "", line });
+        return static_cast<uint32_t>(m_formats.size() - 1);
+    }
+
+    BinaryFormat get(uint32_t id) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return id < m_formats.size() ? m_formats[id] : BinaryFormat{ LogLevel::Info, "", "", 0 };
+    }
+
+private:
+    std::mutex m_mutex;
+    std::vector<BinaryFormat> m_formats;
+};
+
+BinaryFormatTable& formatTable() {
+    static BinaryFormatTable table;
+    return table;
+}
+
+const char* levelName(uint8_t level) {
+    switch (static_cast<LogLevel>(level)) {
+        case LogLevel::Debug:   return "DEBUG";
+        case LogLevel::Info:    return "INFO";
+        case LogLevel::Warning: return "WARNING";
+        case LogLevel::Error:   return "ERROR";
+        case LogLevel::Fatal:   return "FATAL";
+        default:                return "UNKNOWN";
+    }
+}
+
+constexpr size_t alignRecord(size_t size) {
+    return (size + 7) & ~size_t(7);
+}
+
+// Render one tagged argument; returns false if the record is malformed
+bool readArg(const uint8_t*& cursor, const uint8_t* end, std::string& out) {
+    if (cursor >= end) return false;
+    const auto type = static_cast<BinaryArgType>(*cursor++);
+    if (type == BinaryArgType::String) {
+        uint16_t length;
+        if (end - cursor < 2) return false;
+        std::memcpy(&length, cursor, sizeof(length));
+        cursor += sizeof(length);
+        if (end - cursor < length) return false;
+        out.append(reinterpret_cast<const char*>(cursor), length);
+        cursor += length;
+        return true;
+    }
+    if (type == BinaryArgType::Bool) {
+        out += *cursor++ ? "true" : "false";
+        return true;
+    }
+    if (end - cursor < 8) return false;
+    char text[32];
+    switch (type) {
+        case BinaryArgType::Int: {
+            int64_t value;
+            std::memcpy(&value, cursor, 8);
+            std::snprintf(text, sizeof(text), "%lld", static_cast<long long>(value));
+            break;
+        }
+        case BinaryArgType::UInt: {
+            uint64_t value;
+            std::memcpy(&value, cursor, 8);
+            std::snprintf(text, sizeof(text), "%llu", static_cast<unsigned long long>(value));
+            break;
+        }
+        case BinaryArgType::Float: {
+            double value;
+            std::memcpy(&value, cursor, 8);
+            std::snprintf(text, sizeof(text), "%g", value);
+            break;
+        }
+        case BinaryArgType::Pointer: {
+            uint64_t value;
+            std::memcpy(&value, cursor, 8);
+            std::snprintf(text, sizeof(text), "0x%llx", static_cast<unsigned long long>(value));
+            break;
+        }
+        default:
+            return false;
+    }
+    cursor += 8;
+    out += text;
+    return true;
+}
+
+} // namespace
+
+BinaryLog::BinaryLog()
+    : m_formatWritten(new std::atomic<bool>[BINARY_LOG_MAX_FORMATS]) {
+    for (size_t i = 0; i < BINARY_LOG_MAX_FORMATS; ++i) {
+        m_formatWritten[i].store(false, std::memory_order_relaxed);
+    }
+}
+
+bool BinaryLog::open(const std::string& path, size_t capacity) {
+    close();
+    capacity = std::max(capacity, BINARY_LOG_DATA_OFFSET + BINARY_LOG_MAX_RECORD);
+    if (!m_file.Create(path, capacity)) {
+        return false;
+    }
+
+    BinaryLogHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, BINARY_LOG_MAGIC, sizeof(BINARY_LOG_MAGIC));
+    header.version = BINARY_LOG_VERSION;
+    header.capacity = capacity;
+    header.start_wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    std::memcpy(m_file.Data(), &header, sizeof(header));
+
+    m_start = std::chrono::steady_clock::now();
+    m_cursor.store(BINARY_LOG_DATA_OFFSET, std::memory_order_relaxed);
+    m_dropped.store(0, std::memory_order_relaxed);
+    for (size_t i = 0; i < BINARY_LOG_MAX_FORMATS; ++i) {
+        m_formatWritten[i].store(false, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+void BinaryLog::close() {
+    if (!m_file.IsOpen()) {
+        return;
+    }
+    BinaryLog* self = this;
+    globalSlot().compare_exchange_strong(self, nullptr);
+    // A writer may have loaded this log while it was (or before another log became) global
+    while (inFlightWriters().load() != 0) {
+        std::this_thread::yield();
+    }
+    BinaryLogHeader header;
+    std::memcpy(&header, m_file.Data(), sizeof(header));
+    header.used = bytesUsed();
+    header.dropped = droppedCount();
+    std::memcpy(m_file.Data(), &header, sizeof(header));
+    m_file.Flush();
+    m_file.Close();
+}
+
+size_t BinaryLog::bytesUsed() const {
+    return std::min(m_cursor.load(std::memory_order_relaxed), m_file.Size());
+}
+
+uint32_t BinaryLog::registerFormat(LogLevel level, const char* format, const char* file, int line) {
+    return formatTable().add(level, format, file, line);
+}
+
+uint32_t BinaryLog::threadIndex() {
+    static std::atomic<uint32_t> next{ 0 };
+    thread_local const uint32_t index = next.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+bool BinaryLog::commit(uint8_t* buffer, size_t size, BinaryRecordKind kind, uint32_t formatId, LogLevel level, uint8_t argCount) {
+    if (!m_file.IsOpen()) {
+        return false;
+    }
+    // Formats above the table size are re-emitted every time rather than tracked
+    if (kind == BinaryRecordKind::Event &&
+        (formatId >= BINARY_LOG_MAX_FORMATS || !m_formatWritten[formatId].exchange(true, std::memory_order_acq_rel))) {
+        writeFormat(formatId);
+    }
+
+    const size_t recordSize = alignRecord(size);
+    std::memset(buffer + size, 0, recordSize - size);
+    BinaryLogRecord record;
+    record.kind = static_cast<uint16_t>(kind);
+    record.size = static_cast<uint16_t>(recordSize);
+    record.format_id = formatId;
+    record.timestamp_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - m_start).count());
+    record.thread = threadIndex();
+    record.level = static_cast<uint8_t>(level);
+    record.arg_count = argCount;
+    record.reserved = 0;
+    std::memcpy(buffer, &record, sizeof(record));
+
+    const size_t offset = m_cursor.fetch_add(recordSize, std::memory_order_relaxed);
+    if (offset + recordSize > m_file.Size()) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    std::memcpy(m_file.Data() + offset, buffer, recordSize);
+    return true;
+}
+
+void BinaryLog::writeFormat(uint32_t formatId) {
+    const BinaryFormat format = formatTable().get(formatId);
+    uint8_t buffer[BINARY_LOG_MAX_RECORD + 8];
+    const uint32_t line = static_cast<uint32_t>(format.line);
+    const size_t room = BINARY_LOG_MAX_RECORD - sizeof(BinaryLogRecord) - 8;
+    const uint16_t fileLength = static_cast<uint16_t>(std::min(format.file.size(), room / 2));
+    const uint16_t formatLength = static_cast<uint16_t>(std::min(format.format.size(), room - fileLength));
+
+    size_t size = sizeof(BinaryLogRecord);
+    std::memcpy(buffer + size, &line, sizeof(line));
+    size += sizeof(line);
+    std::memcpy(buffer + size, &fileLength, sizeof(fileLength));
+    size += sizeof(fileLength);
+    std::memcpy(buffer + size, &formatLength, sizeof(formatLength));
+    size += sizeof(formatLength);
+    std::memcpy(buffer + size, format.file.data(), fileLength);
+    size += fileLength;
+    std::memcpy(buffer + size, format.format.data(), formatLength);
+    size += formatLength;
+    commit(buffer, size, BinaryRecordKind::Format, formatId, format.level, 0);
+}
+
+bool BinaryLog::decode(const uint8_t* data, size_t size, std::vector<std::string>& lines) {
+    BinaryLogHeader header;
+    if (size < BINARY_LOG_DATA_OFFSET) {
+        LOG_ERROR << "Binary log too small" << LOG_END;
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, BINARY_LOG_MAGIC, sizeof(BINARY_LOG_MAGIC)) != 0 || header.version != BINARY_LOG_VERSION) {
+        LOG_ERROR << "Not a binary log, or unsupported version" << LOG_END;
+        return false;
+    }
+    // A log that was not closed has no size; scan until the first empty record
+    const size_t end = header.used != 0 ? std::min<size_t>(header.used, size) : size;
+
+    // Pass 1: format definitions
+    std::unordered_map<uint32_t, std::string> formats;
+    for (size_t offset = BINARY_LOG_DATA_OFFSET; offset + sizeof(BinaryLogRecord) <= end;) {
+        BinaryLogRecord record;
+        std::memcpy(&record, data + offset, sizeof(record));
+        if (record.kind == static_cast<uint16_t>(BinaryRecordKind::End) || record.size < sizeof(record) || offset + record.size > end) {
+            break;
+        }
+        if (record.kind == static_cast<uint16_t>(BinaryRecordKind::Format) && record.size >= sizeof(record) + 8) {
+            const uint8_t* payload = data + offset + sizeof(record);
+            uint16_t fileLength;
+            uint16_t formatLength;
+            std::memcpy(&fileLength, payload + 4, sizeof(fileLength));
+            std::memcpy(&formatLength, payload + 6, sizeof(formatLength));
+            if (sizeof(record) + 8 + fileLength + formatLength <= record.size) {
+                formats[record.format_id].assign(reinterpret_cast<const char*>(payload + 8 + fileLength), formatLength);
+            }
+        }
+        offset += record.size;
+    }
+
+    // Pass 2: events
+    for (size_t offset = BINARY_LOG_DATA_OFFSET; offset + sizeof(BinaryLogRecord) <= end;) {
+        BinaryLogRecord record;
+        std::memcpy(&record, data + offset, sizeof(record));
+        if (record.kind == static_cast<uint16_t>(BinaryRecordKind::End) || record.size < sizeof(record) || offset + record.size > end) {
+            break;
+        }
+        if (record.kind == static_cast<uint16_t>(BinaryRecordKind::Event)) {
+            char prefix[64];
+            std::snprintf(prefix, sizeof(prefix), "[%14.6f] [T%u] [%s] ",
+                          static_cast<double>(record.timestamp_ns) * 1e-9, record.thread, levelName(record.level));
+            std::string line = prefix;
+
+            auto found = formats.find(record.format_id);
+            const std::string format = found != formats.end() ? found->second : "<unknown format " + std::to_string(record.format_id) + ">";
+            const uint8_t* cursor = data + offset + sizeof(record);
+            const uint8_t* recordEnd = data + offset + record.size;
+            size_t args = record.arg_count;
+            size_t pos = 0;
+            while (pos < format.size()) {
+                if (args > 0 && format.compare(pos, 2, "{}") == 0) {
+                    if (!readArg(cursor, recordEnd, line)) break;
+                    --args;
+                    pos += 2;
+                } else {
+                    line += format[pos++];
+                }
+            }
+            // Arguments without a placeholder are appended
+            while (args-- > 0) {
+                line += ' ';
+                if (!readArg(cursor, recordEnd, line)) break;
+            }
+            lines.push_back(std::move(line));
+        }
+        offset += record.size;
+    }
+
+    if (header.dropped > 0) {
+        lines.push_back(std::to_string(header.dropped) + " records dropped (log full)");
+    }
+    return true;
+}
+
+bool BinaryLog::decodeFile(const std::string& path, std::vector<std::string>& lines) {
+    utils::MappedFile file;
+    if (!file.OpenRead(path)) {
+        return false;
+    }
+    return decode(file.Data(), file.Size(), lines);
+}
+
+} // namespace Logging
@@ -0,0 +1,180 @@
+#include "utils/mapped_file.h"
+#include "LogMacros.h"
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace Logging;
+
+namespace utils {
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_writable = std::exchange(other.m_writable, false);
+#if defined(_WIN32)
+        m_file = std::exchange(other.m_file, nullptr);
+        m_mapping = std::exchange(other.m_mapping, nullptr);
+#else
+        m_fd = std::exchange(other.m_fd, -1);
+#endif
+    }
+    return *this;
+}
+
+#if defined(_WIN32)
+
+bool MappedFile::OpenRead(const std::string& path) {
+    Close();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        LOG_ERROR << "Failed to open file for mapping: " << path << LOG_END;
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        LOG_ERROR << "Cannot map empty file: " << path << LOG_END;
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        LOG_ERROR << "Failed to map file: " << path << LOG_END;
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    m_file = file;
+    m_mapping = mapping;
+    m_data = static_cast<uint8_t*>(view);
+    m_size = static_cast<size_t>(size.QuadPart);
+    m_writable = false;
+    return true;
+}
+
+bool MappedFile::Create(const std::string& path, size_t size) {
+    Close();
+    if (size == 0) return false;
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        LOG_ERROR << "Failed to create file for mapping: " << path << LOG_END;
+        return false;
+    }
+    const DWORD high = static_cast<DWORD>(static_cast<uint64_t>(size) >> 32);
+    const DWORD low = static_cast<DWORD>(static_cast<uint64_t>(size) & 0xFFFFFFFFu);
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, high, low, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size) : nullptr;
+    if (!view) {
+        LOG_ERROR << "Failed to map file: " << path << LOG_END;
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    m_file = file;
+    m_mapping = mapping;
+    m_data = static_cast<uint8_t*>(view);
+    m_size = size;
+    m_writable = true;
+    return true;
+}
+
+bool MappedFile::Flush() {
+    if (!m_data || !m_writable) return false;
+    return FlushViewOfFile(m_data, m_size) && FlushFileBuffers(static_cast<HANDLE>(m_file));
+}
+
+void MappedFile::Close() {
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle(static_cast<HANDLE>(m_mapping));
+    if (m_file) CloseHandle(static_cast<HANDLE>(m_file));
+    m_data = nullptr;
+    m_mapping = nullptr;
+    m_file = nullptr;
+    m_size = 0;
+    m_writable = false;
+}
+
+#else
+
+bool MappedFile::OpenRead(const std::string& path) {
+    Close();
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOG_ERROR << "Failed to open file for mapping: " << path << LOG_END;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        LOG_ERROR << "Cannot map empty file: " << path << LOG_END;
+        close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED) {
+        LOG_ERROR << "Failed to map file: " << path << LOG_END;
+        close(fd);
+        return false;
+    }
+    m_fd = fd;
+    m_data = static_cast<uint8_t*>(view);
+    m_size = static_cast<size_t>(info.st_size);
+    m_writable = false;
+    return true;
+}
+
+bool MappedFile::Create(const std::string& path, size_t size) {
+    Close();
+    if (size == 0) return false;
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        LOG_ERROR << "Failed to create file for mapping: " << path << LOG_END;
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        LOG_ERROR << "Failed to resize file: " << path << LOG_END;
+        close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED) {
+        LOG_ERROR << "Failed to map file: " << path << LOG_END;
+        close(fd);
+        return false;
+    }
+    m_fd = fd;
+    m_data = static_cast<uint8_t*>(view);
+    m_size = size;
+    m_writable = true;
+    return true;
+}
+
+bool MappedFile::Flush() {
+    if (!m_data || !m_writable) return false;
+    return msync(m_data, m_size, MS_SYNC) == 0;
+}
+
+void MappedFile::Close() {
+    if (m_data) munmap(m_data, m_size);
+    if (m_fd >= 0) close(m_fd);
+    m_data = nullptr;
+    m_fd = -1;
+    m_size = 0;
+    m_writable = false;
+}
+
+#endif
+
+} // namespace utils
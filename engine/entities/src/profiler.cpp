@@ -0,0 +1,160 @@
+#include "utils/profiler.h"
+#include "LogMacros.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <unordered_map>
+
+namespace Profiling {
+
+namespace {
+
+void appendEscaped(std::string& out, const char* text) {
+    for (const char* c = text; *c; ++c) {
+        switch (*c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20) {
+                    char code[8];
+                    std::snprintf(code, sizeof(code), "\\u%04x", *c);
+                    out += code;
+                } else {
+                    out += *c;
+                }
+        }
+    }
+}
+
+} // namespace
+
+ThreadProfile& Profiler::registerThread() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const uint32_t id = static_cast<uint32_t>(m_threads.size());
+    m_threads.push_back(std::make_unique<ThreadProfile>(id, m_eventCapacity.load(std::memory_order_relaxed)));
+    m_threads.back()->name = "Thread " + std::to_string(id);
+    return *m_threads.back();
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    ThreadProfile& profile = threadProfile();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    profile.name = name;
+}
+
+void Profiler::recordGpuZone(const char* name, uint64_t start, uint64_t duration) {
+    ThreadProfile* track = m_gpuTrack.load(std::memory_order_acquire);
+    if (!track) {
+        ThreadProfile& profile = registerThread();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        profile.name = "GPU";
+        profile.gpu = true;
+        track = &profile;
+        m_gpuTrack.store(track, std::memory_order_release);
+    }
+    track->record(name, start, duration);
+}
+
+const char* Profiler::intern(std::string_view name) {
+    // Interned names are never released, so the cache keys can point at them
+    thread_local std::unordered_map<std::string_view, const char*> cache;
+    const auto cached = cache.find(name);
+    if (cached != cache.end()) {
+        return cached->second;
+    }
+    const char* interned;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        interned = m_names.emplace(name).first->c_str();
+    }
+    cache.emplace(std::string_view(interned, name.size()), interned);
+    return interned;
+}
+
+void Profiler::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& thread : m_threads) {
+        thread->count.store(0, std::memory_order_relaxed);
+        thread->dropped.store(0, std::memory_order_relaxed);
+    }
+}
+
+size_t Profiler::eventCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t count = 0;
+    for (const auto& thread : m_threads) {
+        count += thread->count.load(std::memory_order_acquire);
+    }
+    return count;
+}
+
+uint64_t Profiler::droppedCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint64_t dropped = 0;
+    for (const auto& thread : m_threads) {
+        dropped += thread->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+std::vector<ProfileEvent> Profiler::events() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<ProfileEvent> events;
+    for (const auto& thread : m_threads) {
+        const size_t count = thread->count.load(std::memory_order_acquire);
+        if (count == 0) continue;
+        const ProfileEvent* recorded = thread->events.load(std::memory_order_acquire);
+        events.insert(events.end(), recorded, recorded + count);
+    }
+    return events;
+}
+
+std::string Profiler::toChromeTrace() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t total = 0;
+    for (const auto& thread : m_threads) {
+        total += thread->count.load(std::memory_order_acquire);
+    }
+    std::string json;
+    json.reserve(1024 + total * 96);
+    json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    char buffer[160];
+    for (const auto& thread : m_threads) {
+        std::snprintf(buffer, sizeof(buffer), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"",
+                      first ? "" : ",", thread->id);
+        json += buffer;
+        appendEscaped(json, thread->name.c_str());
+        json += "\"}}";
+        first = false;
+
+        const size_t count = thread->count.load(std::memory_order_acquire);
+        const ProfileEvent* recorded = thread->events.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; ++i) {
+            const ProfileEvent& event = recorded[i];
+            json += ",{\"name\":\"";
+            appendEscaped(json, event.name);
+            // Chrome trace timestamps are microseconds
+            std::snprintf(buffer, sizeof(buffer), "\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                          thread->gpu ? "gpu" : "cpu", thread->id, event.start / 1000.0, event.duration / 1000.0);
+            json += buffer;
+        }
+    }
+    json += "]}\n";
+    return json;
+}
+
+bool Profiler::exportChromeTrace(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        LOG_ERROR << "Failed to open trace file: " << path << LOG_END;
+        return false;
+    }
+    const std::string json = toChromeTrace();
+    file.write(json.data(), static_cast<std::streamsize>(json.size()));
+    return file.good();
+}
+
+} // namespace Profiling
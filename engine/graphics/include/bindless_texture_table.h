@@ -0,0 +1,98 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "sprite_packer.h"
+
+namespace engine::graphics
+{
+	/**
+	* Global bindless texture table
+	*
+	* One descriptor set holding an array of combined image samplers that
+	* sprites index directly with SpriteDesc::textureIndex, so sprites with
+	* different textures share one draw. Slot 0 is the default (white)
+	* texture and every unused slot points at it, so any index a sprite
+	* carries is safe to sample.
+	*
+	* With descriptor indexing the array is update-after-bind: textures are
+	* added while frames are in flight. update-unused-while-pending only
+	* covers descriptors no pending command buffer uses, so a removed slot
+	* keeps its texture until the frames that may still sample it have
+	* completed; nextFrame() then resets it to the default texture and
+	* recycles it.
+	*
+	* Without descriptor indexing every slot gets its own single-texture set
+	* instead, bound per texture run by the batched sprite path (see
+	* SpriteBatcher). Freshly handed out slots are never in use, so only
+	* removal has to wait for the device.
+	*/
+	class BindlessTextureTable
+	{
+	public:
+		static constexpr uint32_t MAX_TEXTURES = 4096;
+		static constexpr uint32_t MAX_FALLBACK_TEXTURES = 1024;
+		static constexpr uint32_t DEFAULT_TEXTURE = 0;
+		static constexpr uint32_t INVALID_TEXTURE = UINT32_MAX;
+
+		BindlessTextureTable() = default;
+		~BindlessTextureTable() = default;
+
+		BindlessTextureTable(const BindlessTextureTable&) = delete;
+		BindlessTextureTable& operator=(const BindlessTextureTable&) = delete;
+
+		/** @brief `maxSampledImages` bounds the bindless array; the fallback allocates MAX_FALLBACK_TEXTURES sets */
+		bool initialize(VkDevice device, bool bindless, uint32_t maxSampledImages, uint32_t framesInFlight, VkImageView defaultView, VkSampler defaultSampler);
+		void destroy();
+
+		/** @brief Returns the slot sprites use to sample this texture, or INVALID_TEXTURE when the table is full */
+		uint32_t addTexture(VkImageView view, VkSampler sampler, VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+		/**
+		* @brief Retires the slot; it samples the default texture and is reused after the frames in flight complete
+		*
+		* In bindless mode the descriptor still references `view` until then, so
+		* the caller must keep the view (and sampler) alive for framesInFlight
+		* more nextFrame() calls. DEFAULT_TEXTURE, INVALID_TEXTURE and slots
+		* never handed out are ignored.
+		*/
+		void removeTexture(uint32_t index);
+		/** @brief Call once per frame; resets and recycles the slots removed framesInFlight frames ago */
+		void nextFrame();
+
+		VkDescriptorSetLayout getLayout() const { return m_layout; }
+		/** @brief The bindless set, or in fallback mode the set of one slot (the default texture's if out of range) */
+		VkDescriptorSet getDescriptorSet(uint32_t index = DEFAULT_TEXTURE) const { return m_sets[m_bindless || index >= m_sets.size() ? 0 : index]; }
+		uint32_t getCapacity() const { return m_capacity; }
+		uint32_t getTextureCount() const { return m_slotCount - 1 - static_cast<uint32_t>(m_freeSlots.size() + m_retired.size()); }
+		bool isBindless() const { return m_bindless; }
+
+	private:
+		struct RetiredSlot
+		{
+			uint32_t index;
+			uint64_t frame;   // reusable once this frame begins
+		};
+
+		void writeSlot(uint32_t index, VkImageView view, VkSampler sampler, VkImageLayout layout);
+
+		VkDevice m_device = VK_NULL_HANDLE;
+		bool m_bindless = false;
+		VkDescriptorSetLayout m_layout = VK_NULL_HANDLE;
+		VkDescriptorPool m_pool = VK_NULL_HANDLE;
+		std::vector<VkDescriptorSet> m_sets;    // one bindless set, or one per slot
+		VkImageView m_defaultView = VK_NULL_HANDLE;
+		VkSampler m_defaultSampler = VK_NULL_HANDLE;
+		uint32_t m_capacity = 0;
+		uint32_t m_slotCount = 1;               // slots handed out so far, including the default
+		uint32_t m_framesInFlight = 1;
+		uint64_t m_frame = 0;
+		std::vector<uint32_t> m_freeSlots;
+		std::deque<RetiredSlot> m_retired;
+	};
+
+	// Sprites carry their slot in the packed texture field, which falls back to the default texture
+	static_assert(BindlessTextureTable::MAX_TEXTURES <= sprite_packer::MAX_TEXTURE_INDEX + 1, "Texture slots must fit the packed sprite texture index");
+	static_assert(BindlessTextureTable::DEFAULT_TEXTURE == sprite_packer::DEFAULT_TEXTURE_INDEX, "Packed sprites fall back to the table's default texture");
+}
@@ -6,6 +6,7 @@ namespace engine::graphics {
 #define ENABLE_BINDLESS 1
 #define ENABLE_SPRITE_MULTIPASS 1
 #define ENABLE_SPRITE_PROFILING 1
+#define ENABLE_SPRITE_DEPTH_SORT 1
 
 struct SpriteRenderingCapabilities {
     bool descriptorIndexing;
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <vector>
+
+namespace engine::graphics
+{
+	/** @brief Timing of one named GPU scope, from the most recently completed frame */
+	struct GpuScopeResult
+	{
+		const char* name;
+		uint32_t depth;       // nesting level, 0 for top-level scopes
+		double startMs;       // relative to the first timestamp of the frame
+		double durationMs;
+	};
+
+	/**
+	* GPU timestamp profiler
+	*
+	* Owns one timestamp query pool per frame in flight. Scopes write a
+	* timestamp at their start and end; the results of a frame slot are read
+	* back the next time that slot begins, after its fence has been waited on,
+	* so readback never stalls the CPU. Completed scopes are also forwarded to
+	* the CPU profiler's GPU track, aligned to the CPU time of the submit.
+	*
+	* Everything is a no-op when the graphics queue has no valid timestamp bits.
+	*/
+	class GpuProfiler
+	{
+	public:
+		static constexpr uint32_t MAX_SCOPES = 32;
+
+		GpuProfiler() = default;
+		~GpuProfiler() = default;
+
+		GpuProfiler(const GpuProfiler&) = delete;
+		GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+		bool initialize(VkDevice device, const VkPhysicalDeviceProperties& properties, uint32_t timestampValidBits, uint32_t framesInFlight);
+		void destroy();
+		bool isSupported() const { return m_supported; }
+
+		/** @brief Collect the previous results of this frame slot and reset its queries; call outside a render pass */
+		void beginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+		/** @brief Record the CPU time at which the frame's command buffer was submitted */
+		void endFrame(uint64_t submitCpuNs);
+
+		/** @brief Start a named scope; returns a handle for endScope (UINT32_MAX if out of queries) */
+		uint32_t beginScope(VkCommandBuffer commandBuffer, const char* name);
+		void endScope(VkCommandBuffer commandBuffer, uint32_t scope);
+
+		const std::vector<GpuScopeResult>& getResults() const { return m_results; }
+		/** @brief GPU time between the first and last timestamp of the last completed frame */
+		double getFrameMs() const { return m_frameMs; }
+
+		/** @brief RAII helper for a GPU scope */
+		class Scope
+		{
+		public:
+			Scope(GpuProfiler& profiler, VkCommandBuffer commandBuffer, const char* name)
+				: m_profiler(profiler), m_commandBuffer(commandBuffer), m_scope(profiler.beginScope(commandBuffer, name)) {}
+			~Scope() { m_profiler.endScope(m_commandBuffer, m_scope); }
+
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+
+		private:
+			GpuProfiler& m_profiler;
+			VkCommandBuffer m_commandBuffer;
+			uint32_t m_scope;
+		};
+
+	private:
+		struct ScopeInfo
+		{
+			const char* name;
+			uint32_t depth;
+		};
+
+		struct FrameQueries
+		{
+			VkQueryPool pool = VK_NULL_HANDLE;
+			std::vector<ScopeInfo> scopes;
+			uint64_t submitCpuNs = 0;
+			bool pending = false;
+		};
+
+		void collect(FrameQueries& frame);
+
+		VkDevice m_device = VK_NULL_HANDLE;
+		bool m_supported = false;
+		double m_nsPerTick = 1.0;
+		uint64_t m_timestampMask = ~0ull;
+		std::vector<FrameQueries> m_frames;
+		uint32_t m_currentFrame = 0;
+		uint32_t m_depth = 0;
+		std::vector<uint64_t> m_timestamps;
+		std::vector<GpuScopeResult> m_results;
+		double m_frameMs = 0.0;
+	};
+}
@@ -11,11 +11,11 @@ namespace engine::graphics {
         uint32_t id = 0;
         uint32_t version = 0;
     };
-    constexpr SpriteHandle InvalidSpriteHandle{ -1, -1 };
+    constexpr SpriteHandle InvalidSpriteHandle{ UINT32_MAX, UINT32_MAX };
 
     /// <summary>
     /// Describes the properties and rendering parameters of a 2D sprite.
-	/// Packed to fit into 64 bytes for efficient GPU upload.
+	/// Depth is a layer in [0, 1]; the GPU copy clamps and quantizes it (see GPUSpritePacked).
     /// </summary>
     struct SpriteDesc {
         float posX, posY;
@@ -28,12 +28,44 @@ namespace engine::graphics {
         uint32_t colorRGBA;
     };
 
+    /// <summary>
+    /// Read-only view of sprite fields stored structure-of-arrays, as SpriteManager keeps them.
+    /// Element i of every array belongs to the same sprite.
+    /// </summary>
+    struct SpriteFieldsView {
+        const glm::vec2* position;
+        const glm::vec2* scale;
+        const glm::vec2* uvMin;
+        const glm::vec2* uvMax;
+        const float*     rotation;
+        const float*     depth;
+        const uint32_t*  textureIndex;
+        const uint32_t*  colorRGBA;
+    };
+
+    /// <summary>
+    /// Per-sprite record uploaded to the GPU by SpriteManager::buildFrameBatch,
+    /// packed from SpriteDesc by sprite_packer. Mirrored by PackedSprite in sprite_common.slang.
+    /// Position stays full precision; everything else is quantized to fit 32 bytes.
+    /// </summary>
+    struct GPUSpritePacked {
+        float posX, posY;
+        uint16_t scaleX, scaleY;   // half float
+        uint16_t uvMinX, uvMinY;   // half float
+        uint16_t uvMaxX, uvMaxY;   // half float
+        uint16_t rotation;         // fraction of a turn, 65536 steps
+        uint16_t reserved;
+        uint32_t depthTexture;     // depth as unorm16 in the high half, texture index in the low half
+        uint32_t colorRGBA;
+    };
+    static_assert(sizeof(GPUSpritePacked) == 32, "GPUSpritePacked must match the shader layout");
+
     /// <summary>
     /// Represents a set of changes (delta) to a sprite's properties,
     /// </summary>
     //TODO: consider using std::variant for SpritePatch data to improve type safety.
     struct SpritePatch {
-        enum class Kind : uint8_t {
+        enum class Kind : uint16_t {
             Position= 1 << 0,
             Scale= 1 << 1,
             Rotation= 1 << 2,
@@ -0,0 +1,52 @@
+#pragma once
+#include "sprite_manager.h"
+#include <cstdint>
+#include <vector>
+
+namespace engine::graphics {
+
+    /**
+     * @brief Orders sprites by (textureIndex, depth) for the non-bindless path
+     *
+     * Without descriptor indexing a draw can only sample the texture bound for
+     * it, so live sprites are radix-sorted by texture, then depth, and every
+     * run of one texture becomes a single instanced draw. getOrder() is the
+     * slot list the batched vertex shader reads through its instance index;
+     * runs index into it. Depth is ascending within a run; blending across
+     * runs follows texture order, which is the price of this path.
+     */
+    class SpriteBatcher {
+    public:
+        struct TextureRun {
+            uint32_t textureIndex;
+            uint32_t first;  // offset into getOrder()
+            uint32_t count;
+        };
+
+        // Rebuilds order and runs from the live sprites; only needed when a build reports sortKeysChanged
+        void build(const SpriteManager& sprites);
+
+        const std::vector<uint32_t>&   getOrder() const { return m_order; }
+        const std::vector<TextureRun>& getRuns() const { return m_runs; }
+        // Incremented by every build, so per-frame GPU copies know when they are stale
+        uint64_t getVersion() const { return m_version; }
+
+        // Texture in the high word, depth as an order-preserving integer in the low word
+        static uint64_t sortKey(uint32_t textureIndex, float depth);
+
+    private:
+        struct Entry {
+            uint64_t key;
+            uint32_t slot;
+        };
+
+        // LSD radix sort, 8 bits per pass; passes whose digit is the same for every key are skipped
+        void radixSort();
+
+        std::vector<Entry>      m_entries;
+        std::vector<Entry>      m_scratch;
+        std::vector<uint32_t>   m_order;
+        std::vector<TextureRun> m_runs;
+        uint64_t                m_version = 0;
+    };
+}  // namespace engine::graphics
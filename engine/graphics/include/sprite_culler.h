@@ -0,0 +1,119 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "vulkan_buffer.h"
+#include "vulkan_device.h"
+
+namespace engine::graphics
+{
+	/**
+	* GPU frustum culling and depth sorting for the bindless sprite pass
+	*
+	* A compute pass tests every sprite slot's bounding circle against the
+	* camera frustum and appends the visible slots to a per-frame list with
+	* an atomic counter, which is also the instanceCount of the frame's
+	* VkDrawIndirectCommand. The sprite pass then draws that list indirectly,
+	* so off-screen sprites cost one compute thread instead of six vertices.
+	*
+	* When sorting is enabled, a bitonic sort then orders the visible list back
+	* to front (texture as tiebreak) so translucent sprites blend correctly.
+	* It runs in the same command buffer right after the cull, with no CPU
+	* round trip. A one-thread setup pass rounds the visible count up to a
+	* power of two of at least SORT_BLOCK_SIZE and writes the workgroup count
+	* of the sort passes, which are then dispatched indirectly: the sort costs
+	* O(n log^2 n) in the visible count n, not in the slot count. Passes for
+	* stages past n are still recorded (their count depends on the buffer
+	* capacity) but return straight away.
+	*
+	* The compute passes share the per-frame descriptor set of the graphics
+	* passes: binding 1 holds the sprites, binding 2 the visible list,
+	* binding 3 the indirect commands and binding 4 the sort keys. The
+	* indirect commands live in host-visible memory so the visible count of a
+	* frame slot can be read once its fence has been waited on.
+	*/
+	class SpriteCuller
+	{
+	public:
+		static constexpr uint32_t WORKGROUP_SIZE = 64;
+		// Entries one sort workgroup handles in shared memory; matches BLOCK_SIZE in sprite_sort.slang
+		static constexpr uint32_t SORT_BLOCK_SIZE = 1024;
+
+		enum class PrepareResult
+		{
+			Ready,        // the frame's visible list already fits
+			Reallocated,  // new buffers; the frame's descriptors must be rewritten
+			Failed        // allocation failed and the frame has no buffers; do not record or draw
+		};
+
+		SpriteCuller() = default;
+		~SpriteCuller() = default;
+
+		SpriteCuller(const SpriteCuller&) = delete;
+		SpriteCuller& operator=(const SpriteCuller&) = delete;
+
+		/** @brief Without `sortStage` the visible list is drawn in the order the cull appended it */
+		bool initialize(vulkan_utils::VulkanDevice* device, uint32_t framesInFlight, VkDescriptorSetLayout frameSetLayout,
+			VkPipelineCache pipelineCache, const VkPipelineShaderStageCreateInfo& cullStage, const VkPipelineShaderStageCreateInfo* sortStage);
+		void destroy();
+
+		/** @brief Grow the visible list of `frameIndex` to `spriteCount`; a failed frame retries on the next call */
+		PrepareResult prepare(uint32_t frameIndex, uint32_t spriteCount);
+		/** @brief Record the cull (and sort) dispatches and their barriers; call outside a render pass */
+		void record(VkCommandBuffer commandBuffer, uint32_t frameIndex, VkDescriptorSet frameSet, uint32_t spriteCount, const glm::mat4& viewProjection);
+
+		/** @brief Holds IndirectCommands; the draw command is at offset 0 */
+		VkBuffer getDrawBuffer(uint32_t frameIndex) const { return m_frames[frameIndex].draw.buffer; }
+		const VkDescriptorBufferInfo& getVisibleDescriptor(uint32_t frameIndex) const { return m_frames[frameIndex].visible.descriptor; }
+		const VkDescriptorBufferInfo& getDrawDescriptor(uint32_t frameIndex) const { return m_frames[frameIndex].draw.descriptor; }
+		const VkDescriptorBufferInfo& getSortKeyDescriptor(uint32_t frameIndex) const { return m_frames[frameIndex].keys.descriptor; }
+		bool isSorting() const { return m_sortPipeline != VK_NULL_HANDLE; }
+		/** @brief Sprites drawn by the last completed use of this frame slot; valid after its fence was waited on */
+		uint32_t getVisibleCount(uint32_t frameIndex) const;
+
+		/** @brief Normalized planes (xyz normal, w distance) of a view-projection matrix, pointing inwards */
+		static void extractFrustumPlanes(const glm::mat4& viewProjection, glm::vec4 planes[6]);
+
+	private:
+		// Matches the uint indices sprite_cull.slang and sprite_sort.slang use on binding 3
+		struct IndirectCommands
+		{
+			VkDrawIndirectCommand draw;               // instanceCount is the cull's append counter
+			VkDispatchIndirectCommand sortDispatch;   // workgroups of each sort pass, written by the setup pass
+			uint32_t sortSize;                        // visible count padded to a power of two
+		};
+
+		struct FrameBuffers
+		{
+			vulkan_utils::VulkanBuffer visible;   // visible sprite slots, compacted
+			vulkan_utils::VulkanBuffer draw;      // IndirectCommands
+			vulkan_utils::VulkanBuffer keys;      // sort key per visible entry (uvec2)
+			uint32_t capacity = 0;                // a power of two, so the sort needs no bounds checks
+		};
+
+		// Matches CullConstants in sprite_cull.slang
+		struct PushConstants
+		{
+			glm::vec4 planes[6];
+			uint32_t spriteCount;
+		};
+
+		// Matches SortConstants in sprite_sort.slang
+		struct SortConstants
+		{
+			uint32_t mode;
+			uint32_t k;
+			uint32_t j;
+		};
+
+		void recordSort(VkCommandBuffer commandBuffer, VkBuffer indirectBuffer, uint32_t capacity);
+
+		vulkan_utils::VulkanDevice* m_device = nullptr;
+		VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
+		VkPipeline m_pipeline = VK_NULL_HANDLE;
+		VkPipeline m_sortPipeline = VK_NULL_HANDLE;
+		std::vector<FrameBuffers> m_frames;
+	};
+}
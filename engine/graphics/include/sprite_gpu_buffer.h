@@ -0,0 +1,88 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <vector>
+#include "sprite_manager.h"
+#include "vulkan_buffer.h"
+#include "vulkan_device.h"
+
+namespace engine::graphics
+{
+	/**
+	* GPU mirror of all SpriteManager slots
+	*
+	* Owns one persistently mapped storage buffer per frame in flight, each
+	* holding a GPUSpritePacked for every sprite slot (slot index = instance
+	* index). A frame only copies the dirty ranges of the latest build, plus
+	* the ranges of the builds its buffer missed while the other frames were
+	* in flight, so mostly static scenes cost upload bandwidth proportional to
+	* what moved. Buffers are recreated, with a full copy, when the manager
+	* grows past them.
+	*
+	* Memory is host visible and coherent, and device local where the device
+	* offers such a heap, so no staging copy or flush is needed.
+	*
+	* The non-bindless path also keeps a per-frame copy of the SpriteBatcher
+	* slot order next to the sprites, rewritten only when the order changed.
+	*/
+	class SpriteGpuBuffer
+	{
+	public:
+		struct UploadStats
+		{
+			uint32_t ranges = 0;
+			uint64_t bytes = 0;
+			bool reallocated = false;
+			bool orderReallocated = false;
+		};
+
+		SpriteGpuBuffer() = default;
+		~SpriteGpuBuffer() = default;
+
+		SpriteGpuBuffer(const SpriteGpuBuffer&) = delete;
+		SpriteGpuBuffer& operator=(const SpriteGpuBuffer&) = delete;
+
+		bool initialize(vulkan_utils::VulkanDevice* device, uint32_t framesInFlight);
+		void destroy();
+
+		/**
+		* @brief Bring the buffer of `frameIndex` up to date with `build`; call once per frame, after the slot's fence was waited on
+		*
+		* Returns false if the buffer could not be reallocated. The frame then has no sprite buffer and
+		* must not draw sprites; the next upload for it retries the allocation with a full copy.
+		*/
+		bool upload(uint32_t frameIndex, const SpriteManager& sprites, const SpriteManager::BuildResult& build);
+		/** @brief Copy the batcher's slot order into the buffer of `frameIndex` unless it already holds `version`; call after upload(). False has the same meaning as for upload() */
+		bool uploadOrder(uint32_t frameIndex, const std::vector<uint32_t>& order, uint64_t version);
+
+		VkBuffer getBuffer(uint32_t frameIndex) const { return m_frames[frameIndex].buffer.buffer; }
+		const VkDescriptorBufferInfo& getDescriptor(uint32_t frameIndex) const { return m_frames[frameIndex].buffer.descriptor; }
+		const VkDescriptorBufferInfo& getOrderDescriptor(uint32_t frameIndex) const { return m_frames[frameIndex].order.descriptor; }
+		bool hasOrder(uint32_t frameIndex) const { return m_frames[frameIndex].order.buffer != VK_NULL_HANDLE; }
+		/** @brief Sprite slots valid in the buffers; draw this many instances */
+		uint32_t getSpriteCount() const { return m_spriteCount; }
+		const UploadStats& getLastUploadStats() const { return m_stats; }
+
+	private:
+		struct FrameBuffer
+		{
+			vulkan_utils::VulkanBuffer buffer;
+			uint32_t capacity = 0;                              // sprites that fit
+			std::vector<SpriteManager::DirtyRange> pending;     // ranges this buffer has not received yet
+			vulkan_utils::VulkanBuffer order;                   // batcher slot order (non-bindless path)
+			uint32_t orderCapacity = 0;
+			uint64_t orderVersion = UINT64_MAX;
+		};
+
+		bool createMapped(vulkan_utils::VulkanBuffer& buffer, VkDeviceSize size);
+		void destroyMapped(vulkan_utils::VulkanBuffer& buffer);
+
+		vulkan_utils::VulkanDevice* m_device = nullptr;
+		VkMemoryPropertyFlags m_memoryFlags = 0;
+		std::vector<FrameBuffer> m_frames;
+		std::vector<SpriteManager::DirtyRange> m_merged;
+		uint32_t m_spriteCount = 0;
+		UploadStats m_stats;
+	};
+}
@@ -1,46 +1,127 @@
 #pragma once
-#include <span>
 #include "sprite.h"
+#include <cstddef>
 #include <vector>
 #include <algorithm>
+#include <memory>
 
 namespace engine::graphics {
-	
+
 	class SpriteManager {
     public:
-        //Last element reserved for INVALID_HANDLE (UINT32_MAX)
-        SpriteManager() : m_freeList(UINT32_MAX - 1), 
-                          m_spriteDescriptions(UINT32_MAX - 1),
-                          m_spriteActiveFlags(UINT32_MAX - 1, false),
-			              m_spriteVersions(UINT32_MAX - 1, 0)
+        // Slots are allocated in chunks of this many sprites
+        static constexpr uint32_t CHUNK_SHIFT = 12;
+        static constexpr uint32_t CHUNK_SIZE = 1u << CHUNK_SHIFT;
+        static constexpr uint32_t CHUNK_MASK = CHUNK_SIZE - 1;
+        // Largest id a handle can carry; UINT32_MAX is InvalidSpriteHandle
+        static constexpr uint32_t MAX_SPRITES = UINT32_MAX - 1;
+        // Dirty ranges separated by at most this many clean sprites are merged into one copy
+        static constexpr uint32_t RANGE_MERGE_GAP = 4;
+
+        // Storage grows on demand; `reserveCount` only pre-allocates chunks for that many sprites
+        explicit SpriteManager(uint32_t reserveCount = 0, uint32_t maxSprites = MAX_SPRITES)
+                        : m_maxSprites(maxSprites)
         {
-			uint32_t n = 0;
-			std::generate(m_freeList.begin(), m_freeList.end(), [&]() { return n++; });
+            reserve(reserveCount);
         }
 
+        // Allocates chunks for at least `count` slots; existing handles and descriptions stay put
+        void reserve(uint32_t count);
+
+        // Returns InvalidSpriteHandle once maxSprites are alive
         SpriteHandle createSprite(const SpriteDesc& desc);
         void         destroySprite(SpriteHandle h);
         bool         setSprite(SpriteHandle h, const SpriteDesc& desc);
         bool         applyPatch(const SpritePatch& p);
-        void         applyPatches(std::span<const SpritePatch> patches);
+        // Batched: a single-kind batch is stored in the validating pass, a mixed one bucketed by kind
+        // and applied one loop per bucket; same result as applyPatch in order
+        void         applyPatches(const SpritePatch* patches, size_t count);
+        void         applyPatches(const std::vector<SpritePatch>& patches) { applyPatches(patches.data(), patches.size()); }
         bool         getSprite(SpriteHandle h, SpriteDesc& out) const;
+        // True while the sprite is alive and the handle's version matches its slot
+        bool         isValid(SpriteHandle h) const;
+
+        // Contiguous run of sprite slots [first, first + count)
+        struct DirtyRange {
+            uint32_t first;
+            uint32_t count;
+        };
 
-        // Frame build: produce a contiguous array of GPUSpritePacked in an internal scratch buffer
+        // Frame build: repacks the dirty sprites into the packed mirror of all slots and returns
+        // their slots as sorted, coalesced ranges. Destroyed slots are packed as zero (not drawn).
         // Returned view is valid until next build call.
         struct BuildResult {
-            const GPUSpritePacked* data;
-            uint32_t count;
+            const DirtyRange* ranges;
+            uint32_t rangeCount;
+            uint32_t spriteCount; // dirty sprites, not counting merged clean gaps
+            bool sortKeysChanged; // a sprite was created, destroyed or changed texture or depth
         };
         BuildResult buildFrameBatch();
 
+        // Copies the packed mirror of slots [first, first + count) to `dst`; the range must lie below slotCount()
+        void copyPacked(uint32_t first, uint32_t count, GPUSpritePacked* dst) const;
+
+        // Calls fn(slot, fields, i) for every live sprite in slot order; element i of the field arrays is that sprite,
+        // so a pass reads only the fields it needs
+        template<typename Fn>
+        void forEachLive(Fn&& fn) const
+        {
+            for (uint32_t base = 0; base < m_slotCount; base += CHUNK_SIZE) {
+                const Chunk& chunk = *m_chunks[base >> CHUNK_SHIFT];
+                const SpriteFieldsView fields = chunk.fields();
+                const uint32_t end = std::min(CHUNK_SIZE, m_slotCount - base);
+                for (uint32_t i = 0; i < end; ++i) {
+                    if (chunk.active[i]) fn(base + i, fields, i);
+                }
+            }
+        }
+
         size_t liveCount() const;
+        // Allocated slots, a multiple of CHUNK_SIZE
+        size_t capacity() const { return m_chunks.size() * CHUNK_SIZE; }
+        // Slots handed out so far, live or destroyed: ids are all below this
+        uint32_t slotCount() const { return m_slotCount; }
     private:
-        std::vector<SpriteDesc> m_spriteDescriptions;
-		std::vector<bool>       m_spriteActiveFlags;
-		std::vector<uint32_t>   m_spriteVersions;
+        // A chunk never moves once allocated, so growing only appends chunk pointers.
+        // Sprite fields are stored structure-of-arrays: a position patch or a sort key pass
+        // streams 8 or 4 bytes per sprite instead of the whole SpriteDesc
+        struct Chunk {
+            glm::vec2  position[CHUNK_SIZE];
+            glm::vec2  scale[CHUNK_SIZE];
+            glm::vec2  uvMin[CHUNK_SIZE];
+            glm::vec2  uvMax[CHUNK_SIZE];
+            float      rotation[CHUNK_SIZE];
+            float      depth[CHUNK_SIZE];
+            uint32_t   textureIndex[CHUNK_SIZE];
+            uint32_t   colorRGBA[CHUNK_SIZE];
+            uint32_t   versions[CHUNK_SIZE];
+            uint64_t   dirtyBits[CHUNK_SIZE / 64]; // One bit per slot queued for the next build
+            bool       active[CHUNK_SIZE];
+            GPUSpritePacked packed[CHUNK_SIZE]; // As last built, what the GPU buffers mirror
+
+            SpriteFieldsView fields() const
+            {
+                return SpriteFieldsView{ position, scale, uvMin, uvMax, rotation, depth, textureIndex, colorRGBA };
+            }
+            SpriteDesc load(uint32_t slot) const;
+            void       store(uint32_t slot, const SpriteDesc& desc);
+        };
+
+        Chunk&       chunkOf(uint32_t index) { return *m_chunks[index >> CHUNK_SHIFT]; }
+        const Chunk& chunkOf(uint32_t index) const { return *m_chunks[index >> CHUNK_SHIFT]; }
+        void markDirty(uint32_t index, uint16_t mask);
+        // Writes the patched field; false for a kind the chunk has no array for
+        static bool storePatch(Chunk& chunk, uint32_t slot, const SpritePatch& p);
+
+        std::vector<std::unique_ptr<Chunk>> m_chunks;
+        uint32_t                m_slotCount = 0; // Never-used slots start here, so the free list only holds destroyed ones
+        uint32_t                m_maxSprites;
 
-		std::vector<uint32_t>   m_freeList; // Free list of sprite indices
+		std::vector<uint32_t>   m_freeList; // Destroyed sprite indices, reused before new slots
 		std::vector<uint32_t>   m_dirtiedSprites; // List of indices that need to be rebuilt
-		std::vector<uint8_t>    m_dirtyMask; // Bitmask for dirty properties
+		std::vector<DirtyRange> m_ranges; // Scratch output of buildFrameBatch
+		std::vector<uint8_t>    m_patchBuckets; // Scratch of applyPatches: kind bucket per patch
+		std::vector<uint32_t>   m_patchOrder; // Scratch of applyPatches: patch indices grouped by kind
+		bool                    m_sortKeysChanged = false; // Since the last build, see BuildResult
 	};
-}  // namespace engine::graphics
\ No newline at end of file
+}  // namespace engine::graphics
@@ -0,0 +1,44 @@
+#pragma once
+#include "sprite.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace engine::graphics {
+
+    /**
+     * @brief Converts SpriteDesc into the 32-byte GPUSpritePacked format
+     *
+     * Scale and UVs become half floats, rotation a 16-bit fraction of a turn
+     * and depth a 16-bit unorm next to the texture index. The half conversion
+     * rounds to nearest even and is vectorized at compile time: F16C when the
+     * build enables it (-mf16c, -march=haswell, /arch:AVX2), SSE2 bit
+     * manipulation on other x86-64 builds, and a scalar fallback elsewhere.
+     * All three produce identical bits for every non-NaN input.
+     */
+    namespace sprite_packer {
+        // Rotation steps per turn
+        constexpr float ROTATION_STEPS = 65536.0f;
+        // Largest texture index the packed format can hold
+        constexpr uint32_t MAX_TEXTURE_INDEX = 0xFFFF;
+        // Packed in place of larger indices; matches BindlessTextureTable::DEFAULT_TEXTURE
+        constexpr uint32_t DEFAULT_TEXTURE_INDEX = 0;
+
+        GPUSpritePacked pack(const SpriteDesc& desc);
+        void pack(const SpriteDesc* src, GPUSpritePacked* dst, size_t count);
+        // Structure-of-arrays source: sprite `index`, or sprites [first, first + count) into dst[0, count)
+        GPUSpritePacked pack(const SpriteFieldsView& fields, size_t index);
+        void pack(const SpriteFieldsView& fields, size_t first, size_t count, GPUSpritePacked* dst);
+
+        // Scalar reference conversions, also used to read packed sprites back
+        uint16_t floatToHalf(float value);
+        float    halfToFloat(uint16_t half);
+        // Whole turns wrap; NaN and infinite rotations pack as 0
+        uint16_t quantizeRotation(float radians);
+        float    dequantizeRotation(uint16_t rotation);
+        // Depth is clamped to [0, 1] and NaN packs as 0; a texture index above MAX_TEXTURE_INDEX becomes DEFAULT_TEXTURE_INDEX
+        uint32_t packDepthTexture(float depth, uint32_t textureIndex);
+
+        // "f16c", "sse2" or "scalar", for logs and benchmarks
+        const char* simdPath();
+    }
+}  // namespace engine::graphics
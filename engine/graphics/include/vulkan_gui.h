@@ -12,6 +12,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <array>
 #include <vector>
 #include <sstream>
 #include <iomanip>
@@ -39,10 +40,12 @@ namespace engine::graphics::GUI
 		VkSampleCountFlagBits rasterizationSamples{ VK_SAMPLE_COUNT_1_BIT };
 		uint32_t subpass{ 0 };
 
-		engine::graphics::vulkan_utils::VulkanBuffer vertexBuffer;
-		engine::graphics::vulkan_utils::VulkanBuffer indexBuffer;
-		int32_t vertexCount{ 0 };
-		int32_t indexCount{ 0 };
+		// Geometry is double buffered per frame in flight, so updating it never touches buffers the GPU may still read
+		static constexpr uint32_t maxConcurrentFrames{ 3 };
+		std::array<engine::graphics::vulkan_utils::VulkanBuffer, maxConcurrentFrames> vertexBuffer;
+		std::array<engine::graphics::vulkan_utils::VulkanBuffer, maxConcurrentFrames> indexBuffer;
+		std::array<int32_t, maxConcurrentFrames> vertexCount{};
+		std::array<int32_t, maxConcurrentFrames> indexCount{};
 
 		std::vector<VkPipelineShaderStageCreateInfo> shaders;
 
@@ -73,8 +76,8 @@ namespace engine::graphics::GUI
 		void preparePipeline(const VkPipelineCache pipelineCache, const VkRenderPass renderPass, const VkFormat colorFormat, const VkFormat depthFormat);
 		void prepareResources();
 
-		bool update();
-		void draw(const VkCommandBuffer commandBuffer);
+		bool update(uint32_t currentBuffer);
+		void draw(const VkCommandBuffer commandBuffer, uint32_t currentBuffer);
 		void resize(uint32_t width, uint32_t height);
 
 		void freeResources();
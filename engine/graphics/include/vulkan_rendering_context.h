@@ -7,10 +7,17 @@
 #include "vulkan_swapchain.h"
 #include "vulkan_tools.h"
 #include "vulkan_gui.h"
+#include "gpu_profiler.h"
+#include "sprite_gpu_buffer.h"
+#include "bindless_texture_table.h"
+#include "sprite_manager.h"
+#include "sprite_batcher.h"
+#include "sprite_culler.h"
 #include <vector>
 #include <string>
 #include <memory>
 #include <array>
+#include <chrono>
 #include "vulkan_benchmark.h"
 #include "vulkan_utils.h"
 
@@ -21,6 +28,9 @@ namespace engine::graphics {
     class VulkanRenderingContext : public RenderingContext {
     public:
         VulkanRenderingContext(const glfw_window& window);
+        // Offscreen mode: no surface or swapchain, frames are rendered to device images of the given size
+        // and can be read back with readbackFrame(). Works on software ICDs such as lavapipe.
+        VulkanRenderingContext(uint32_t width, uint32_t height);
         ~VulkanRenderingContext() override;
         
         // RenderingContext implementation
@@ -41,6 +51,7 @@ namespace engine::graphics {
         const vulkan_utils::VulkanDevice& getDevice() const { return *m_device; }
         VkSurfaceKHR getSurface() const { return m_surface; }
         const vulkan_utils::VulkanSwapChain& getSwapchain() const { return *m_swapchain; }
+        VkFormat getColorFormat() const { return m_swapchain ? m_swapchain->colorFormat : OFFSCREEN_COLOR_FORMAT; }
         
         // Frame synchronization
         VkSemaphore getImageAvailableSemaphore() const { return m_imageAvailableSemaphores[m_currentFrame]; }
@@ -50,12 +61,28 @@ namespace engine::graphics {
         // Command buffer access
         VkCommandPool getCommandPool() const { return m_commandPool; }
         VkCommandBuffer getCurrentCommandBuffer() const { return m_commandBuffers[m_currentFrame]; }
+
+        // GPU timestamp scopes; render passes add their own with GpuProfiler::Scope
+        GpuProfiler& getGpuProfiler() { return m_gpuProfiler; }
+        const GpuProfiler& getGpuProfiler() const { return m_gpuProfiler; }
+
+        // Sprites created here are mirrored into the per-frame GPU sprite buffers each frame
+        SpriteManager& getSpriteManager() { return m_sprites; }
+        const SpriteGpuBuffer& getSpriteBuffer() const { return m_spriteBuffer; }
+        // SpriteDesc::textureIndex is a slot of this table; slot 0 is plain white
+        BindlessTextureTable& getTextureTable() { return m_textureTable; }
+        VkSampler getSpriteSampler() const { return m_spriteSampler; }
         
         // State queries
         bool isInitialized() const { return m_initialized; }
         bool isSwapchainValid() const { return m_swapchain != VK_NULL_HANDLE; }
+        bool isOffscreen() const { return m_window == nullptr; }
         uint32_t getCurrentImageIndex() const { return m_currentImageIndex; }
         
+        // Offscreen mode only: copies the last submitted frame to `pixels` as tightly packed RGBA8 rows.
+        // Waits for that frame to finish on the GPU, so it stalls the pipeline; meant for tests and captures.
+        bool readbackFrame(std::vector<uint8_t>& pixels, uint32_t& width, uint32_t& height);
+        
         // Resize handling
         void setFramebufferResized(bool resized) { m_framebufferResized = resized; }
         
@@ -65,10 +92,14 @@ namespace engine::graphics {
     private:
         static const int MAX_FRAMES_IN_FLIGHT = 3;
         static constexpr uint32_t MAX_CONCURRENT_FRAMES = MAX_FRAMES_IN_FLIGHT;
+        static constexpr VkFormat OFFSCREEN_COLOR_FORMAT = VK_FORMAT_R8G8B8A8_UNORM;
         
         // Initialization state
         bool m_initialized = false;
-        const glfw_window& m_window;
+        // Null in offscreen mode
+        const glfw_window* m_window = nullptr;
+        uint32_t m_offscreenWidth = 0;
+        uint32_t m_offscreenHeight = 0;
         
         // Core Vulkan objects
         VkInstance m_instance = VK_NULL_HANDLE;
@@ -80,6 +111,22 @@ namespace engine::graphics {
         VkRenderPass m_renderPass = VK_NULL_HANDLE;
         VkPipelineCache m_pipelineCache = VK_NULL_HANDLE;
         GUI::UIOverlay m_gui;
+        std::chrono::steady_clock::time_point m_lastOverlayTime;
+        GpuProfiler m_gpuProfiler;
+        SpriteManager m_sprites;
+        SpriteGpuBuffer m_spriteBuffer;
+        BindlessTextureTable m_textureTable;
+        // Texture runs for the non-bindless sprite path
+        SpriteBatcher m_spriteBatcher;
+        // Frustum culling and indirect draw for the bindless sprite path
+        SpriteCuller m_spriteCuller;
+        struct DefaultTexture {
+            VkImage image = VK_NULL_HANDLE;
+            VkDeviceMemory memory = VK_NULL_HANDLE;
+            VkImageView view = VK_NULL_HANDLE;
+        };
+        DefaultTexture m_defaultTexture;
+        VkSampler m_spriteSampler = VK_NULL_HANDLE;
         vulkan_utils::Benchmark m_benchmark;
         // List of available frame buffers (same as number of swap chain images)
         std::vector<VkFramebuffer> m_framebuffers;
@@ -93,7 +140,23 @@ namespace engine::graphics {
         VkDescriptorPool m_descriptorPool = VK_NULL_HANDLE;
         VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
         VkPipeline m_pipeline = VK_NULL_HANDLE;
+        // Instanced sprite quads (shares m_pipelineLayout): one draw over every slot when bindless,
+        // otherwise one draw per texture run of the batcher's order
+        VkPipeline m_spritePipeline = VK_NULL_HANDLE;
         std::unique_ptr<vulkan_utils::VulkanSwapChain> m_swapchain;
+
+        // Offscreen color targets, one per frame in flight (they take the place of the swapchain images)
+        struct OffscreenTarget {
+            VkImage image = VK_NULL_HANDLE;
+            VkDeviceMemory memory = VK_NULL_HANDLE;
+            VkImageView view = VK_NULL_HANDLE;
+        };
+        std::array<OffscreenTarget, MAX_CONCURRENT_FRAMES> m_offscreenTargets;
+        uint32_t m_lastSubmittedFrame = UINT32_MAX;
+        // Host-visible copy destination for readbackFrame(), created on first use
+        VkBuffer m_readbackBuffer = VK_NULL_HANDLE;
+        VkDeviceMemory m_readbackMemory = VK_NULL_HANDLE;
+        VkDeviceSize m_readbackSize = 0;
         
         // Frame management
         uint32_t m_currentFrame = 0;
@@ -130,9 +193,15 @@ namespace engine::graphics {
         bool selectPhysicalDevice();
         bool createLogicalDevice();
         bool createSwapchain();
+        bool createOffscreenTargets();
+        void destroyOffscreenTargets();
+        void destroyReadbackBuffer();
+        // Framebuffer size: the window's, or the offscreen target size
+        void getRenderExtent(uint32_t& width, uint32_t& height) const;
         bool createCommandPool();
         bool createCommandBuffers();
         bool createSyncObjects();
+        bool createGpuProfiler();
         bool setupDepthStencil();
         bool setupRenderPass();
         bool createPipelineCache();
@@ -140,10 +209,17 @@ namespace engine::graphics {
         bool setupUIOverlay();
 		bool createVertexBuffer();
 		bool createUniformBuffers();
+		bool createSpriteBuffer();
+		bool createTextureTable();
+		void destroyDefaultTexture();
 		bool createDescriptorSetLayout();
 		bool createDescriptorPool();
 		bool createDescriptorSets();
 		bool createPipelines();
+		bool createSpritePipeline();
+		bool createSpriteCuller();
+		void updateSpriteDescriptor(uint32_t frameIndex);
+		void drawSprites(VkCommandBuffer commandBuffer);
         VkPipelineShaderStageCreateInfo loadShader(std::string fileName, VkShaderStageFlagBits stage);
         
         // Swapchain recreation helpers
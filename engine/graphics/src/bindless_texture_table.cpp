@@ -0,0 +1,168 @@
+#include "bindless_texture_table.h"
+#include <algorithm>
+#include <iostream>
+
+namespace engine::graphics
+{
+	bool BindlessTextureTable::initialize(VkDevice device, bool bindless, uint32_t maxSampledImages, uint32_t framesInFlight, VkImageView defaultView, VkSampler defaultSampler)
+	{
+		m_device = device;
+		m_bindless = bindless;
+		m_framesInFlight = std::max(framesInFlight, 1u);
+		m_defaultView = defaultView;
+		m_defaultSampler = defaultSampler;
+		m_capacity = bindless ? std::max(1u, std::min(MAX_TEXTURES, maxSampledImages)) : MAX_FALLBACK_TEXTURES;
+		const uint32_t setCount = bindless ? 1 : m_capacity;
+		const uint32_t descriptorsPerSet = bindless ? m_capacity : 1;
+
+		VkDescriptorSetLayoutBinding binding{};
+		binding.binding = 0;
+		binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		binding.descriptorCount = descriptorsPerSet;
+		binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+		const VkDescriptorBindingFlags bindingFlags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+			VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+			VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT |
+			VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT;
+		VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsCI{};
+		bindingFlagsCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+		bindingFlagsCI.bindingCount = 1;
+		bindingFlagsCI.pBindingFlags = &bindingFlags;
+
+		VkDescriptorSetLayoutCreateInfo layoutCI{};
+		layoutCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		layoutCI.bindingCount = 1;
+		layoutCI.pBindings = &binding;
+		if (m_bindless) {
+			layoutCI.pNext = &bindingFlagsCI;
+			layoutCI.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+		}
+		if (vkCreateDescriptorSetLayout(m_device, &layoutCI, nullptr, &m_layout) != VK_SUCCESS) {
+			std::cerr << "Failed to create texture table layout" << std::endl;
+			return false;
+		}
+
+		VkDescriptorPoolSize poolSize{};
+		poolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		poolSize.descriptorCount = m_capacity;
+		VkDescriptorPoolCreateInfo poolCI{};
+		poolCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		poolCI.flags = m_bindless ? VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT : 0;
+		poolCI.maxSets = setCount;
+		poolCI.poolSizeCount = 1;
+		poolCI.pPoolSizes = &poolSize;
+		if (vkCreateDescriptorPool(m_device, &poolCI, nullptr, &m_pool) != VK_SUCCESS) {
+			std::cerr << "Failed to create texture table pool" << std::endl;
+			return false;
+		}
+
+		const std::vector<VkDescriptorSetLayout> layouts(setCount, m_layout);
+		VkDescriptorSetVariableDescriptorCountAllocateInfo variableCountAI{};
+		variableCountAI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO;
+		variableCountAI.descriptorSetCount = 1;
+		variableCountAI.pDescriptorCounts = &m_capacity;
+		VkDescriptorSetAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		allocInfo.pNext = m_bindless ? &variableCountAI : nullptr;
+		allocInfo.descriptorPool = m_pool;
+		allocInfo.descriptorSetCount = setCount;
+		allocInfo.pSetLayouts = layouts.data();
+		m_sets.resize(setCount);
+		if (vkAllocateDescriptorSets(m_device, &allocInfo, m_sets.data()) != VK_SUCCESS) {
+			std::cerr << "Failed to allocate texture table sets" << std::endl;
+			return false;
+		}
+
+		// Every slot starts out as the default texture, so no sprite index can hit an empty descriptor
+		const VkDescriptorImageInfo defaultInfo{ m_defaultSampler, m_defaultView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+		std::vector<VkDescriptorImageInfo> imageInfos(descriptorsPerSet, defaultInfo);
+		std::vector<VkWriteDescriptorSet> writes(setCount);
+		for (uint32_t i = 0; i < setCount; ++i) {
+			writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			writes[i].dstSet = m_sets[i];
+			writes[i].dstBinding = 0;
+			writes[i].descriptorCount = descriptorsPerSet;
+			writes[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+			writes[i].pImageInfo = imageInfos.data();
+		}
+		vkUpdateDescriptorSets(m_device, setCount, writes.data(), 0, nullptr);
+
+		std::cout << "Texture table: " << m_capacity << " slots" << (m_bindless ? " (bindless)" : " (one set per texture)") << std::endl;
+		return true;
+	}
+
+	void BindlessTextureTable::destroy()
+	{
+		if (m_pool != VK_NULL_HANDLE) {
+			vkDestroyDescriptorPool(m_device, m_pool, nullptr);
+			m_pool = VK_NULL_HANDLE;
+		}
+		if (m_layout != VK_NULL_HANDLE) {
+			vkDestroyDescriptorSetLayout(m_device, m_layout, nullptr);
+			m_layout = VK_NULL_HANDLE;
+		}
+		m_sets.clear();
+		m_freeSlots.clear();
+		m_retired.clear();
+		m_slotCount = 1;
+	}
+
+	void BindlessTextureTable::writeSlot(uint32_t index, VkImageView view, VkSampler sampler, VkImageLayout layout)
+	{
+		VkDescriptorImageInfo imageInfo{ sampler, view, layout };
+		VkWriteDescriptorSet write{};
+		write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		write.dstSet = m_bindless ? m_sets[0] : m_sets[index];
+		write.dstBinding = 0;
+		write.dstArrayElement = m_bindless ? index : 0;
+		write.descriptorCount = 1;
+		write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		write.pImageInfo = &imageInfo;
+		vkUpdateDescriptorSets(m_device, 1, &write, 0, nullptr);
+	}
+
+	uint32_t BindlessTextureTable::addTexture(VkImageView view, VkSampler sampler, VkImageLayout layout)
+	{
+		uint32_t index;
+		if (!m_freeSlots.empty()) {
+			index = m_freeSlots.back();
+			m_freeSlots.pop_back();
+		} else if (m_slotCount < m_capacity) {
+			index = m_slotCount++;
+		} else {
+			std::cerr << "Texture table is full (" << m_capacity << " slots)" << std::endl;
+			return INVALID_TEXTURE;
+		}
+		// New and recycled slots are not referenced by any frame in flight, so this is safe in both modes
+		writeSlot(index, view, sampler, layout);
+		return index;
+	}
+
+	void BindlessTextureTable::removeTexture(uint32_t index)
+	{
+		if (index == DEFAULT_TEXTURE || index >= m_slotCount) return;
+		if (!m_bindless) {
+			// The slot's set may be bound by a pending frame and is not update-after-bind
+			vkDeviceWaitIdle(m_device);
+			// Sprites still carrying this index sample the default texture instead of a destroyed view
+			writeSlot(index, m_defaultView, m_defaultSampler, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+		}
+		// In bindless mode pending frames may still sample the slot, so nextFrame() rewrites it once they complete
+		m_retired.push_back(RetiredSlot{ index, m_frame + m_framesInFlight });
+	}
+
+	void BindlessTextureTable::nextFrame()
+	{
+		++m_frame;
+		while (!m_retired.empty() && m_retired.front().frame <= m_frame) {
+			const uint32_t index = m_retired.front().index;
+			if (m_bindless) {
+				// No pending frame references the slot any more
+				writeSlot(index, m_defaultView, m_defaultSampler, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+			}
+			m_freeSlots.push_back(index);
+			m_retired.pop_front();
+		}
+	}
+}
@@ -41,11 +41,15 @@ void detectSpriteRenderingCapabilities(VkPhysicalDevice physicalDevice) {
     vkGetPhysicalDeviceFeatures2(physicalDevice, &features2);
     
     // Store descriptor indexing capabilities
+    // Sprites index the texture table per instance, so the array needs non-uniform indexing
     g_spriteCapabilities.descriptorIndexing = descriptorIndexingFeatures.descriptorBindingPartiallyBound && 
-                                              descriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending;
+                                              descriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending &&
+                                              descriptorIndexingFeatures.runtimeDescriptorArray &&
+                                              descriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing;
     g_spriteCapabilities.variableDescriptorCount = descriptorIndexingFeatures.descriptorBindingVariableDescriptorCount;
     g_spriteCapabilities.partiallyBound = descriptorIndexingFeatures.descriptorBindingPartiallyBound;
-    g_spriteCapabilities.updateAfterBind = descriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending;
+    g_spriteCapabilities.updateAfterBind = descriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending &&
+                                           descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind;
     
     // Query device properties for limits
     VkPhysicalDeviceDescriptorIndexingProperties descriptorIndexingProperties{};
@@ -80,6 +84,7 @@ void detectSpriteRenderingCapabilities(VkPhysicalDevice physicalDevice) {
     // Determine derived capabilities
     g_spriteCapabilities.bindlessSupported = g_spriteCapabilities.descriptorIndexing && 
                                               g_spriteCapabilities.variableDescriptorCount &&
+                                              g_spriteCapabilities.updateAfterBind &&
                                               g_spriteCapabilities.maxDescriptorSetSampledImages >= 1024;
     
     g_spriteCapabilities.gpuSpritesSupported = g_spriteCapabilities.bindlessSupported;
@@ -121,6 +126,8 @@ void getSpriteRenderingRequiredFeatures(VkPhysicalDeviceFeatures& features, void
         descriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
         descriptorIndexingFeatures.descriptorBindingVariableDescriptorCount = VK_TRUE;
         descriptorIndexingFeatures.runtimeDescriptorArray = VK_TRUE;
+        descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+        descriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
         
         descriptorIndexingFeatures.pNext = *pNext;
         *pNext = &descriptorIndexingFeatures;
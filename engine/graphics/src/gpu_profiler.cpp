@@ -0,0 +1,131 @@
+#include "gpu_profiler.h"
+#include "utils/profiler.h"
+#include <algorithm>
+
+namespace engine::graphics
+{
+	bool GpuProfiler::initialize(VkDevice device, const VkPhysicalDeviceProperties& properties, uint32_t timestampValidBits, uint32_t framesInFlight)
+	{
+		destroy();
+		m_device = device;
+		m_supported = timestampValidBits > 0 && properties.limits.timestampPeriod > 0.0f;
+		if (!m_supported) {
+			return true;
+		}
+		m_nsPerTick = properties.limits.timestampPeriod;
+		m_timestampMask = timestampValidBits >= 64 ? ~0ull : ((1ull << timestampValidBits) - 1);
+		m_timestamps.resize(MAX_SCOPES * 2);
+
+		m_frames.resize(framesInFlight);
+		for (FrameQueries& frame : m_frames) {
+			VkQueryPoolCreateInfo queryPoolInfo{};
+			queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+			queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+			queryPoolInfo.queryCount = MAX_SCOPES * 2;
+			if (vkCreateQueryPool(m_device, &queryPoolInfo, nullptr, &frame.pool) != VK_SUCCESS) {
+				destroy();
+				return false;
+			}
+			frame.scopes.reserve(MAX_SCOPES);
+		}
+		return true;
+	}
+
+	void GpuProfiler::destroy()
+	{
+		for (FrameQueries& frame : m_frames) {
+			if (frame.pool != VK_NULL_HANDLE) {
+				vkDestroyQueryPool(m_device, frame.pool, nullptr);
+			}
+		}
+		m_frames.clear();
+		m_results.clear();
+		m_supported = false;
+	}
+
+	void GpuProfiler::beginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex)
+	{
+		if (!m_supported) {
+			return;
+		}
+		m_currentFrame = frameIndex % static_cast<uint32_t>(m_frames.size());
+		m_depth = 0;
+		FrameQueries& frame = m_frames[m_currentFrame];
+		// The fence of this slot has been waited on, so its previous results are ready
+		if (frame.pending) {
+			collect(frame);
+		}
+		frame.scopes.clear();
+		frame.pending = false;
+		vkCmdResetQueryPool(commandBuffer, frame.pool, 0, MAX_SCOPES * 2);
+	}
+
+	void GpuProfiler::endFrame(uint64_t submitCpuNs)
+	{
+		if (!m_supported) {
+			return;
+		}
+		FrameQueries& frame = m_frames[m_currentFrame];
+		frame.submitCpuNs = submitCpuNs;
+		frame.pending = !frame.scopes.empty();
+	}
+
+	uint32_t GpuProfiler::beginScope(VkCommandBuffer commandBuffer, const char* name)
+	{
+		if (!m_supported) {
+			return UINT32_MAX;
+		}
+		FrameQueries& frame = m_frames[m_currentFrame];
+		if (frame.scopes.size() >= MAX_SCOPES) {
+			return UINT32_MAX;
+		}
+		const uint32_t scope = static_cast<uint32_t>(frame.scopes.size());
+		frame.scopes.push_back({ name, m_depth++ });
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, frame.pool, scope * 2);
+		return scope;
+	}
+
+	void GpuProfiler::endScope(VkCommandBuffer commandBuffer, uint32_t scope)
+	{
+		if (!m_supported || scope == UINT32_MAX) {
+			return;
+		}
+		--m_depth;
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_frames[m_currentFrame].pool, scope * 2 + 1);
+	}
+
+	void GpuProfiler::collect(FrameQueries& frame)
+	{
+		const uint32_t queryCount = static_cast<uint32_t>(frame.scopes.size() * 2);
+		// No WAIT flag: if the results are somehow not ready, skip this frame instead of stalling
+		VkResult result = vkGetQueryPoolResults(m_device, frame.pool, 0, queryCount,
+			queryCount * sizeof(uint64_t), m_timestamps.data(), sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+		if (result != VK_SUCCESS) {
+			return;
+		}
+
+		uint64_t first = UINT64_MAX;
+		uint64_t last = 0;
+		for (uint32_t i = 0; i < queryCount; ++i) {
+			m_timestamps[i] &= m_timestampMask;
+			first = std::min(first, m_timestamps[i]);
+			last = std::max(last, m_timestamps[i]);
+		}
+
+		// GPU and CPU clocks are not calibrated; the first timestamp is placed at the submit time
+		Profiling::Profiler& profiler = Profiling::Profiler::getInstance();
+		const bool exportToTrace = profiler.isEnabled();
+		m_results.clear();
+		for (uint32_t i = 0; i < frame.scopes.size(); ++i) {
+			const uint64_t begin = m_timestamps[i * 2] - first;
+			const uint64_t end = std::max(m_timestamps[i * 2 + 1] - first, begin);
+			const double beginNs = static_cast<double>(begin) * m_nsPerTick;
+			const double durationNs = static_cast<double>(end - begin) * m_nsPerTick;
+			m_results.push_back({ frame.scopes[i].name, frame.scopes[i].depth, beginNs * 1e-6, durationNs * 1e-6 });
+			if (exportToTrace) {
+				profiler.recordGpuZone(frame.scopes[i].name, frame.submitCpuNs + static_cast<uint64_t>(beginNs), static_cast<uint64_t>(durationNs));
+			}
+		}
+		m_frameMs = static_cast<double>(last - first) * m_nsPerTick * 1e-6;
+	}
+}
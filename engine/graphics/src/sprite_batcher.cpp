@@ -0,0 +1,68 @@
+#include "sprite_batcher.h"
+#include "utils/profiler.h"
+#include <cstring>
+
+uint64_t engine::graphics::SpriteBatcher::sortKey(uint32_t textureIndex, float depth)
+{
+	uint32_t bits;
+	std::memcpy(&bits, &depth, sizeof(bits));
+	// Flip all bits of negatives and the sign of positives so unsigned order matches float order
+	bits ^= (bits & 0x80000000u) ? 0xFFFFFFFFu : 0x80000000u;
+	return (static_cast<uint64_t>(textureIndex) << 32) | bits;
+}
+
+void engine::graphics::SpriteBatcher::build(const SpriteManager& sprites)
+{
+	PROFILE_ZONE("SpriteBatcher::build");
+	m_entries.clear();
+	// reads only the texture and depth arrays
+	sprites.forEachLive([this](uint32_t slot, const SpriteFieldsView& fields, uint32_t i) {
+		m_entries.push_back(Entry{ sortKey(fields.textureIndex[i], fields.depth[i]), slot });
+	});
+	radixSort();
+
+	m_order.resize(m_entries.size());
+	m_runs.clear();
+	for (uint32_t i = 0; i < m_entries.size(); ++i) {
+		m_order[i] = m_entries[i].slot;
+		const uint32_t texture = static_cast<uint32_t>(m_entries[i].key >> 32);
+		if (m_runs.empty() || m_runs.back().textureIndex != texture) {
+			m_runs.push_back(TextureRun{ texture, i, 0 });
+		}
+		++m_runs.back().count;
+	}
+	++m_version;
+}
+
+void engine::graphics::SpriteBatcher::radixSort()
+{
+	constexpr uint32_t PASSES = 8;
+	const size_t count = m_entries.size();
+	if (count < 2) return;
+
+	// All digit histograms in one read of the keys
+	size_t histograms[PASSES][256] = {};
+	for (const Entry& entry : m_entries) {
+		for (uint32_t pass = 0; pass < PASSES; ++pass) {
+			++histograms[pass][(entry.key >> (pass * 8)) & 0xFF];
+		}
+	}
+
+	m_scratch.resize(count);
+	for (uint32_t pass = 0; pass < PASSES; ++pass) {
+		size_t* histogram = histograms[pass];
+		// Usually the high texture bytes: every key lands in one bucket and the pass would be a plain copy
+		if (histogram[(m_entries[0].key >> (pass * 8)) & 0xFF] == count) continue;
+
+		size_t offset = 0;
+		for (uint32_t digit = 0; digit < 256; ++digit) {
+			const size_t n = histogram[digit];
+			histogram[digit] = offset;
+			offset += n;
+		}
+		for (const Entry& entry : m_entries) {
+			m_scratch[histogram[(entry.key >> (pass * 8)) & 0xFF]++] = entry;
+		}
+		m_entries.swap(m_scratch);
+	}
+}
@@ -0,0 +1,214 @@
+#include "sprite_culler.h"
+#include "vulkan_initializers.h"
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+
+namespace engine::graphics
+{
+	bool SpriteCuller::initialize(vulkan_utils::VulkanDevice* device, uint32_t framesInFlight, VkDescriptorSetLayout frameSetLayout,
+		VkPipelineCache pipelineCache, const VkPipelineShaderStageCreateInfo& cullStage, const VkPipelineShaderStageCreateInfo* sortStage)
+	{
+		m_device = device;
+		m_frames.resize(framesInFlight);
+
+		VkPushConstantRange pushConstantRange = vulkan_utils::initializers::pushConstantRange(VK_SHADER_STAGE_COMPUTE_BIT, sizeof(PushConstants), 0);
+		VkPipelineLayoutCreateInfo pipelineLayoutCI = vulkan_utils::initializers::pipelineLayoutCreateInfo(&frameSetLayout, 1);
+		pipelineLayoutCI.pushConstantRangeCount = 1;
+		pipelineLayoutCI.pPushConstantRanges = &pushConstantRange;
+		if (vkCreatePipelineLayout(m_device->logicalDevice, &pipelineLayoutCI, nullptr, &m_pipelineLayout) != VK_SUCCESS) {
+			std::cerr << "Failed to create sprite cull pipeline layout" << std::endl;
+			return false;
+		}
+
+		VkComputePipelineCreateInfo pipelineCI = vulkan_utils::initializers::computePipelineCreateInfo(m_pipelineLayout, 0);
+		pipelineCI.stage = cullStage;
+		if (vkCreateComputePipelines(m_device->logicalDevice, pipelineCache, 1, &pipelineCI, nullptr, &m_pipeline) != VK_SUCCESS) {
+			std::cerr << "Failed to create sprite cull pipeline" << std::endl;
+			return false;
+		}
+
+		// Both pipelines share the layout; the sort only uses the start of the push constant range
+		if (sortStage != nullptr) {
+			pipelineCI.stage = *sortStage;
+			if (vkCreateComputePipelines(m_device->logicalDevice, pipelineCache, 1, &pipelineCI, nullptr, &m_sortPipeline) != VK_SUCCESS) {
+				std::cerr << "Failed to create sprite sort pipeline" << std::endl;
+				return false;
+			}
+		}
+
+		// The draw command is read back for statistics, so the commands stay host visible; they are only 32 bytes
+		static_assert(sizeof(IndirectCommands) == 32, "IndirectCommands must match the shader indices");
+		const VkMemoryPropertyFlags hostFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+		for (FrameBuffers& frame : m_frames) {
+			if (m_device->createBuffer(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+				hostFlags, &frame.draw, sizeof(IndirectCommands)) != VK_SUCCESS || frame.draw.map() != VK_SUCCESS) {
+				std::cerr << "Failed to create sprite draw command buffer" << std::endl;
+				return false;
+			}
+			*static_cast<IndirectCommands*>(frame.draw.mapped) = IndirectCommands{ { 6, 0, 0, 0 }, { 0, 1, 1 }, 0 };
+		}
+		return true;
+	}
+
+	void SpriteCuller::destroy()
+	{
+		for (FrameBuffers& frame : m_frames) {
+			if (frame.draw.buffer != VK_NULL_HANDLE) {
+				frame.draw.unmap();
+				frame.draw.destroy();
+			}
+			if (frame.visible.buffer != VK_NULL_HANDLE) {
+				frame.visible.destroy();
+			}
+			if (frame.keys.buffer != VK_NULL_HANDLE) {
+				frame.keys.destroy();
+			}
+		}
+		m_frames.clear();
+		if (m_sortPipeline != VK_NULL_HANDLE) {
+			vkDestroyPipeline(m_device->logicalDevice, m_sortPipeline, nullptr);
+			m_sortPipeline = VK_NULL_HANDLE;
+		}
+		if (m_pipeline != VK_NULL_HANDLE) {
+			vkDestroyPipeline(m_device->logicalDevice, m_pipeline, nullptr);
+			m_pipeline = VK_NULL_HANDLE;
+		}
+		if (m_pipelineLayout != VK_NULL_HANDLE) {
+			vkDestroyPipelineLayout(m_device->logicalDevice, m_pipelineLayout, nullptr);
+			m_pipelineLayout = VK_NULL_HANDLE;
+		}
+		m_device = nullptr;
+	}
+
+	SpriteCuller::PrepareResult SpriteCuller::prepare(uint32_t frameIndex, uint32_t spriteCount)
+	{
+		FrameBuffers& frame = m_frames[frameIndex];
+		if (frame.visible.buffer != VK_NULL_HANDLE && frame.capacity >= spriteCount) {
+			return PrepareResult::Ready;
+		}
+		if (frame.visible.buffer != VK_NULL_HANDLE) {
+			frame.visible.destroy();
+			frame.visible = vulkan_utils::VulkanBuffer{};
+		}
+		if (frame.keys.buffer != VK_NULL_HANDLE) {
+			frame.keys.destroy();
+			frame.keys = vulkan_utils::VulkanBuffer{};
+		}
+		// Power of two for the bitonic sort, which also makes growth geometric
+		uint32_t capacity = SORT_BLOCK_SIZE;
+		while (capacity < spriteCount) {
+			capacity *= 2;
+		}
+		if (m_device->createBuffer(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			&frame.visible, static_cast<VkDeviceSize>(capacity) * sizeof(uint32_t)) != VK_SUCCESS ||
+			m_device->createBuffer(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			&frame.keys, static_cast<VkDeviceSize>(capacity) * 2 * sizeof(uint32_t)) != VK_SUCCESS) {
+			std::cerr << "Failed to create visible sprite list of " << capacity << " sprites" << std::endl;
+			// Drop whichever buffer was created, so the next call reallocates both
+			if (frame.visible.buffer != VK_NULL_HANDLE) {
+				frame.visible.destroy();
+				frame.visible = vulkan_utils::VulkanBuffer{};
+			}
+			if (frame.keys.buffer != VK_NULL_HANDLE) {
+				frame.keys.destroy();
+				frame.keys = vulkan_utils::VulkanBuffer{};
+			}
+			frame.capacity = 0;
+			return PrepareResult::Failed;
+		}
+		frame.capacity = capacity;
+		return PrepareResult::Reallocated;
+	}
+
+	void SpriteCuller::record(VkCommandBuffer commandBuffer, uint32_t frameIndex, VkDescriptorSet frameSet, uint32_t spriteCount, const glm::mat4& viewProjection)
+	{
+		FrameBuffers& frame = m_frames[frameIndex];
+
+		// Reset the append counter: 6 vertices, no instances yet
+		const VkDrawIndirectCommand reset{ 6, 0, 0, 0 };
+		vkCmdUpdateBuffer(commandBuffer, frame.draw.buffer, 0, sizeof(reset), &reset);
+		VkMemoryBarrier resetBarrier = vulkan_utils::initializers::memoryBarrier();
+		resetBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		resetBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &resetBarrier, 0, nullptr, 0, nullptr);
+
+		if (spriteCount > 0) {
+			PushConstants constants{};
+			extractFrustumPlanes(viewProjection, constants.planes);
+			constants.spriteCount = spriteCount;
+			vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline);
+			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, 0, 1, &frameSet, 0, nullptr);
+			vkCmdPushConstants(commandBuffer, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants), &constants);
+			vkCmdDispatch(commandBuffer, (spriteCount + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+			if (isSorting()) {
+				recordSort(commandBuffer, frame.draw.buffer, frame.capacity);
+			}
+		}
+
+		// The draw reads the command and the vertex shader the visible list
+		VkMemoryBarrier cullBarrier = vulkan_utils::initializers::memoryBarrier();
+		cullBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		cullBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+			0, 1, &cullBarrier, 0, nullptr, 0, nullptr);
+	}
+
+	void SpriteCuller::recordSort(VkCommandBuffer commandBuffer, VkBuffer indirectBuffer, uint32_t capacity)
+	{
+		// Every pass reads what the previous one (or the cull) wrote; the first also reads the setup's dispatch size
+		VkMemoryBarrier barrier = vulkan_utils::initializers::memoryBarrier();
+		barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+		const auto pushConstants = [&](uint32_t mode, uint32_t k, uint32_t j) {
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+				0, 1, &barrier, 0, nullptr, 0, nullptr);
+			const SortConstants constants{ mode, k, j };
+			vkCmdPushConstants(commandBuffer, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants), &constants);
+		};
+		// One thread per compare pair, SORT_BLOCK_SIZE / 2 threads per workgroup, over the padded visible count only
+		const auto dispatch = [&](uint32_t mode, uint32_t k, uint32_t j) {
+			pushConstants(mode, k, j);
+			vkCmdDispatchIndirect(commandBuffer, indirectBuffer, offsetof(IndirectCommands, sortDispatch));
+		};
+
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_sortPipeline);
+		pushConstants(3, 0, 0);
+		vkCmdDispatch(commandBuffer, 1, 1, 1);
+		// Sort each block, then merge blocks: global steps while the distance spans blocks, then one shared-memory pass
+		dispatch(0, 0, 0);
+		for (uint32_t k = 2 * SORT_BLOCK_SIZE; k <= capacity; k *= 2) {
+			for (uint32_t j = k / 2; j >= SORT_BLOCK_SIZE; j /= 2) {
+				dispatch(1, k, j);
+			}
+			dispatch(2, k, 0);
+		}
+	}
+
+	uint32_t SpriteCuller::getVisibleCount(uint32_t frameIndex) const
+	{
+		return static_cast<const VkDrawIndirectCommand*>(m_frames[frameIndex].draw.mapped)->instanceCount;
+	}
+
+	void SpriteCuller::extractFrustumPlanes(const glm::mat4& viewProjection, glm::vec4 planes[6])
+	{
+		// Gribb/Hartmann: each plane is the last row of the matrix plus or minus another row.
+		// glm is column major, so row i is (m[0][i], m[1][i], m[2][i], m[3][i]).
+		const glm::vec4 row0(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]);
+		const glm::vec4 row1(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]);
+		const glm::vec4 row2(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]);
+		const glm::vec4 row3(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+		planes[0] = row3 + row0;   // left
+		planes[1] = row3 - row0;   // right
+		planes[2] = row3 + row1;   // bottom
+		planes[3] = row3 - row1;   // top
+		planes[4] = row3 + row2;   // near; z >= -w, which for a [0, 1] depth range is slightly conservative
+		planes[5] = row3 - row2;   // far
+		for (int i = 0; i < 6; ++i) {
+			const float length = glm::length(glm::vec3(planes[i]));
+			if (length > 0.0f) {
+				planes[i] /= length;
+			}
+		}
+	}
+}
@@ -0,0 +1,137 @@
+#include "sprite_gpu_buffer.h"
+#include "utils/profiler.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace engine::graphics
+{
+	bool SpriteGpuBuffer::initialize(vulkan_utils::VulkanDevice* device, uint32_t framesInFlight)
+	{
+		m_device = device;
+		m_frames.resize(framesInFlight);
+
+		// Prefer memory the GPU reads at full speed (resizable BAR, UMA); any coherent host memory works
+		VkBool32 found = VK_FALSE;
+		const VkMemoryPropertyFlags deviceLocalHost = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+		device->getMemoryType(~0u, deviceLocalHost, &found);
+		m_memoryFlags = found ? deviceLocalHost : VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+		return true;
+	}
+
+	void SpriteGpuBuffer::destroy()
+	{
+		for (FrameBuffer& frame : m_frames) {
+			destroyMapped(frame.buffer);
+			destroyMapped(frame.order);
+		}
+		m_frames.clear();
+		m_spriteCount = 0;
+		m_device = nullptr;
+	}
+
+	void SpriteGpuBuffer::destroyMapped(vulkan_utils::VulkanBuffer& buffer)
+	{
+		if (buffer.buffer != VK_NULL_HANDLE) {
+			buffer.unmap();
+			buffer.destroy();
+			buffer = vulkan_utils::VulkanBuffer{};
+		}
+	}
+
+	bool SpriteGpuBuffer::createMapped(vulkan_utils::VulkanBuffer& buffer, VkDeviceSize size)
+	{
+		destroyMapped(buffer);
+		if (m_device->createBuffer(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, m_memoryFlags, &buffer, size) != VK_SUCCESS) {
+			std::cerr << "Failed to create sprite buffer of " << size << " bytes" << std::endl;
+			return false;
+		}
+		// Mapped for the lifetime of the buffer
+		if (buffer.map() != VK_SUCCESS) {
+			std::cerr << "Failed to map sprite buffer" << std::endl;
+			destroyMapped(buffer);
+			return false;
+		}
+		return true;
+	}
+
+	bool SpriteGpuBuffer::upload(uint32_t frameIndex, const SpriteManager& sprites, const SpriteManager::BuildResult& build)
+	{
+		PROFILE_ZONE("SpriteGpuBuffer::upload");
+		m_stats = UploadStats{};
+		m_spriteCount = sprites.slotCount();
+
+		// Every buffer has to see this build's ranges; the others get them when their frame comes around
+		for (FrameBuffer& frame : m_frames) {
+			frame.pending.insert(frame.pending.end(), build.ranges, build.ranges + build.rangeCount);
+		}
+
+		FrameBuffer& frame = m_frames[frameIndex];
+		GPUSpritePacked* mapped = nullptr;
+		if (frame.capacity < m_spriteCount) {
+			// Grown past this buffer: reallocate at the manager's capacity and copy every slot
+			const uint32_t capacity = static_cast<uint32_t>(sprites.capacity());
+			if (!createMapped(frame.buffer, static_cast<VkDeviceSize>(capacity) * sizeof(GPUSpritePacked))) {
+				// The old buffer is gone; the next upload retries the allocation and full copy
+				frame.capacity = 0;
+				return false;
+			}
+			frame.capacity = capacity;
+			mapped = static_cast<GPUSpritePacked*>(frame.buffer.mapped);
+			sprites.copyPacked(0, m_spriteCount, mapped);
+			frame.pending.clear();
+			m_stats.ranges = 1;
+			m_stats.bytes = static_cast<uint64_t>(m_spriteCount) * sizeof(GPUSpritePacked);
+			m_stats.reallocated = true;
+			return true;
+		}
+		mapped = static_cast<GPUSpritePacked*>(frame.buffer.mapped);
+
+		// Ranges of several builds overlap or touch; merge them into one copy each
+		std::sort(frame.pending.begin(), frame.pending.end(),
+			[](const SpriteManager::DirtyRange& a, const SpriteManager::DirtyRange& b) { return a.first < b.first; });
+		m_merged.clear();
+		for (const SpriteManager::DirtyRange& range : frame.pending) {
+			if (!m_merged.empty() && range.first <= m_merged.back().first + m_merged.back().count) {
+				SpriteManager::DirtyRange& last = m_merged.back();
+				last.count = std::max(last.first + last.count, range.first + range.count) - last.first;
+			} else {
+				m_merged.push_back(range);
+			}
+		}
+		frame.pending.clear();
+
+		for (const SpriteManager::DirtyRange& range : m_merged) {
+			sprites.copyPacked(range.first, range.count, mapped + range.first);
+			m_stats.bytes += static_cast<uint64_t>(range.count) * sizeof(GPUSpritePacked);
+		}
+		m_stats.ranges = static_cast<uint32_t>(m_merged.size());
+		return true;
+	}
+
+	bool SpriteGpuBuffer::uploadOrder(uint32_t frameIndex, const std::vector<uint32_t>& order, uint64_t version)
+	{
+		FrameBuffer& frame = m_frames[frameIndex];
+		if (frame.orderVersion == version) {
+			return true;
+		}
+		const uint32_t count = static_cast<uint32_t>(order.size());
+		if (frame.order.buffer == VK_NULL_HANDLE || frame.orderCapacity < count) {
+			// Sized like the sprite buffer so the order only reallocates when the manager grows
+			const uint32_t capacity = std::max(count, frame.capacity);
+			if (!createMapped(frame.order, static_cast<VkDeviceSize>(std::max(capacity, 1u)) * sizeof(uint32_t))) {
+				frame.orderCapacity = 0;
+				frame.orderVersion = UINT64_MAX;
+				return false;
+			}
+			frame.orderCapacity = capacity;
+			m_stats.orderReallocated = true;
+		}
+		if (count > 0) {
+			std::memcpy(frame.order.mapped, order.data(), static_cast<size_t>(count) * sizeof(uint32_t));
+		}
+		frame.orderVersion = version;
+		m_stats.bytes += static_cast<uint64_t>(count) * sizeof(uint32_t);
+		return true;
+	}
+}
@@ -1,139 +1,352 @@
 #include "sprite_manager.h"
+#include "sprite_packer.h"
+#include "utils/profiler.h"
+#include <cassert>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
-SpriteHandle engine::graphics::SpriteManager::createSprite(const SpriteDesc& desc)
+namespace {
+
+// Index of the lowest set bit; `word` must not be zero
+inline uint32_t lowestBit(uint64_t word)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return static_cast<uint32_t>(index);
+#else
+	return static_cast<uint32_t>(__builtin_ctzll(word));
+#endif
+}
+
+// Patch kinds applyPatches buckets, Position (bit 0) through Color (bit 6)
+constexpr uint32_t PATCH_KIND_COUNT = 7;
+
+constexpr uint16_t SORT_KEY_KINDS = static_cast<uint16_t>(engine::graphics::SpritePatch::Kind::TextureIndex) |
+	static_cast<uint16_t>(engine::graphics::SpritePatch::Kind::Depth);
+
+} // namespace
+
+engine::graphics::SpriteDesc engine::graphics::SpriteManager::Chunk::load(uint32_t slot) const
+{
+	SpriteDesc desc;
+	desc.posX = position[slot].x;
+	desc.posY = position[slot].y;
+	desc.scaleX = scale[slot].x;
+	desc.scaleY = scale[slot].y;
+	desc.uvMinX = uvMin[slot].x;
+	desc.uvMinY = uvMin[slot].y;
+	desc.uvMaxX = uvMax[slot].x;
+	desc.uvMaxY = uvMax[slot].y;
+	desc.rotation = rotation[slot];
+	desc.depth = depth[slot];
+	desc.textureIndex = textureIndex[slot];
+	desc.colorRGBA = colorRGBA[slot];
+	return desc;
+}
+
+void engine::graphics::SpriteManager::Chunk::store(uint32_t slot, const SpriteDesc& desc)
+{
+	position[slot] = glm::vec2(desc.posX, desc.posY);
+	scale[slot] = glm::vec2(desc.scaleX, desc.scaleY);
+	uvMin[slot] = glm::vec2(desc.uvMinX, desc.uvMinY);
+	uvMax[slot] = glm::vec2(desc.uvMaxX, desc.uvMaxY);
+	rotation[slot] = desc.rotation;
+	depth[slot] = desc.depth;
+	textureIndex[slot] = desc.textureIndex;
+	colorRGBA[slot] = desc.colorRGBA;
+}
+
+void engine::graphics::SpriteManager::reserve(uint32_t count)
 {
-	assert(!m_freeList.empty() && "No free sprite handles available");
+	count = std::min(count, m_maxSprites);
+	const size_t chunkCount = (static_cast<size_t>(count) + CHUNK_MASK) >> CHUNK_SHIFT;
+	m_chunks.reserve(chunkCount);
+	while (m_chunks.size() < chunkCount) {
+		// value-initialized: versions, dirty bits and active flags start at zero
+		m_chunks.push_back(std::make_unique<Chunk>());
+	}
+}
 
-	uint32_t index = m_freeList.back();
-	m_freeList.pop_back();
+engine::graphics::SpriteHandle engine::graphics::SpriteManager::createSprite(const SpriteDesc& desc)
+{
+	uint32_t index;
+	if (!m_freeList.empty()) {
+		index = m_freeList.back();
+		m_freeList.pop_back();
+	} else {
+		if (m_slotCount >= m_maxSprites) return InvalidSpriteHandle;
+		index = m_slotCount++;
+		if ((index >> CHUNK_SHIFT) >= m_chunks.size()) {
+			m_chunks.push_back(std::make_unique<Chunk>());
+		}
+	}
 
+	Chunk& chunk = chunkOf(index);
+	const uint32_t slot = index & CHUNK_MASK;
+	SpriteHandle handle{ index, chunk.versions[slot] };
+	chunk.active[slot] = true;
+	chunk.store(slot, desc);
 
-	SpriteHandle handle{ index, m_spriteVersions[index]++ };
-	m_spriteActiveFlags[index] = true;
-	m_spriteDescriptions[index] = desc;
-	
-	m_dirtiedSprites.push_back(index);
-	m_dirtyMask.push_back(0xFF); // mark all properties as dirty initially
+	markDirty(index, 0xFFFF); // mark all properties as dirty initially
 
 	return handle;
 }
 
 void engine::graphics::SpriteManager::destroySprite(SpriteHandle h)
 {
-	assert(h.index < m_spriteActiveFlags.size() && "Invalid sprite handle");
-	m_spriteActiveFlags[h.index] = false;
-	m_freeList.push_back(h.index);
+	if (!isValid(h)) return;
+	Chunk& chunk = chunkOf(h.id);
+	const uint32_t slot = h.id & CHUNK_MASK;
+	chunk.active[slot] = false;
+	++chunk.versions[slot]; // outstanding handles to this slot become stale
+	m_freeList.push_back(h.id);
 
-	// if we removed a sprite and has not been committed yet, we can remove it from the dirty list
-	auto it = std::remove(m_dirtiedSprites.begin(), m_dirtiedSprites.end(), h.index);
-	if (it != m_dirtiedSprites.end()) {
-		m_dirtiedSprites.erase(it, m_dirtiedSprites.end());
-		// Reset the dirty mask for this sprite
-		m_dirtyMask[h.index] = 0;
-	}
+	// the next build clears the slot in the packed mirror so the GPU stops drawing it
+	markDirty(h.id, 0xFFFF);
 }
 
 bool engine::graphics::SpriteManager::setSprite(SpriteHandle h, const SpriteDesc& desc)
 {
-	assert(h.index < m_spriteActiveFlags.size() && "Invalid sprite handle");
-	if (!m_spriteActiveFlags[h.index]) return false;
+	if (!isValid(h)) return false;
 
-	m_spriteDescriptions[h.index] = desc;
+	chunkOf(h.id).store(h.id & CHUNK_MASK, desc);
+	markDirty(h.id, 0xFFFF);
 	return true;
 }
 
-bool engine::graphics::SpriteManager::applyPatch(const SpritePatch& p)
+bool engine::graphics::SpriteManager::storePatch(Chunk& chunk, uint32_t slot, const SpritePatch& p)
 {
-	assert(p.index < m_spriteActiveFlags.size() && "Invalid sprite patch");
-	if (!m_spriteActiveFlags[p.index]) return false;
-
-	//apply the patch to the sprite description
+	//apply the patch to the sprite's field arrays
 	switch (p.kind) {
 		case SpritePatch::Kind::Position:
-			m_spriteDescriptions[p.handle.id].posX = p.data.vec2v.x;
-			m_spriteDescriptions[p.handle.id].posY = p.data.vec2v.y;
+			chunk.position[slot] = p.data.vec2v;
 			break;
 		case SpritePatch::Kind::Scale:
-			m_spriteDescriptions[p.handle.id].scaleX = p.data.vec2v.x;
-			m_spriteDescriptions[p.handle.id].scaleY = p.data.vec2v.y;
+			chunk.scale[slot] = p.data.vec2v;
 			break;
 		case SpritePatch::Kind::Rotation:
-			m_spriteDescriptions[p.handle.id].rotation = p.data.f32v;
+			chunk.rotation[slot] = p.data.f32v;
 			break;
 		case SpritePatch::Kind::Depth:
-			m_spriteDescriptions[p.handle.id].depth = p.data.f32v;
+			chunk.depth[slot] = p.data.f32v;
 			break;
 		case SpritePatch::Kind::UV:
-			m_spriteDescriptions[p.handle.id].uvMinX = p.data.uv.uvMin.x;
-			m_spriteDescriptions[p.handle.id].uvMinY = p.data.uv.uvMin.y;
-			m_spriteDescriptions[p.handle.id].uvMaxX = p.data.uv.uvMax.x;
-			m_spriteDescriptions[p.handle.id].uvMaxY = p.data.uv.uvMax.y;
+			chunk.uvMin[slot] = p.data.uv.uvMin;
+			chunk.uvMax[slot] = p.data.uv.uvMax;
 			break;
 		case SpritePatch::Kind::TextureIndex:
-			m_spriteDescriptions[p.handle.id].textureIndex = p.data.u32v;
+			chunk.textureIndex[slot] = p.data.u32v;
 			break;
 		case SpritePatch::Kind::Color:
-			m_spriteDescriptions[p.handle.id].colorRGBA = p.data.u32v;
+			chunk.colorRGBA[slot] = p.data.u32v;
 			break;
 		default:
 			return false; // Unsupported patch kind
 	}
-	// maybe the sprite was already dirty, update the mask with the new changes
-	if (m_dirtiedSprites[p.handle.id] == 0) {
-		m_dirtiedSprites.push_back(p.handle.id);
-		m_dirtyMask[p.handle.id] = 0; // Reset the dirty mask for this sprite
-	}
-	m_dirtyMask[p.handle.id] |= p.kind; // Set the dirty mask for this sprite
 	return true;
 }
 
-void engine::graphics::SpriteManager::applyPatches(std::span<const SpritePatch> patches)
+bool engine::graphics::SpriteManager::applyPatch(const SpritePatch& p)
+{
+	if (!isValid(p.handle)) return false;
+
+	if (!storePatch(chunkOf(p.handle.id), p.handle.id & CHUNK_MASK, p)) return false;
+	markDirty(p.handle.id, static_cast<uint16_t>(p.kind));
+	return true;
+}
+
+void engine::graphics::SpriteManager::applyPatches(const SpritePatch* patches, size_t count)
 {
-	for (const auto& patch : patches) {
-		applyPatch(patch);
+	PROFILE_ZONE("SpriteManager::applyPatches");
+	// Validate, mark dirty and count per kind; the kind's bit position is its bucket.
+	// Until a second kind shows up, patches are stored right away: a single-kind batch
+	// (the common case: everything moved) is applied in this one pass
+	uint32_t offsets[PATCH_KIND_COUNT + 1] = {};
+	uint16_t kinds = 0;
+	m_patchBuckets.resize(count);
+	for (size_t i = 0; i < count; ++i) {
+		const SpritePatch& p = patches[i];
+		const uint32_t id = p.handle.id;
+		const uint16_t kind = static_cast<uint16_t>(p.kind);
+		m_patchBuckets[i] = PATCH_KIND_COUNT; // skipped, like applyPatch returning false, or already stored
+		if (id >= m_slotCount || kind == 0 || kind >= (1u << PATCH_KIND_COUNT) || (kind & (kind - 1)) != 0) continue;
+		// isValid and markDirty, sharing one chunk lookup
+		Chunk& chunk = chunkOf(id);
+		const uint32_t slot = id & CHUNK_MASK;
+		if (!chunk.active[slot] || chunk.versions[slot] != p.handle.version) continue;
+		uint64_t& word = chunk.dirtyBits[slot >> 6];
+		const uint64_t bit = uint64_t(1) << (slot & 63);
+		if ((word & bit) == 0) {
+			word |= bit;
+			m_dirtiedSprites.push_back(id);
+		}
+		kinds |= kind;
+		if (kinds == kind) {
+			storePatch(chunk, slot, p);
+			continue;
+		}
+		m_patchBuckets[i] = static_cast<uint8_t>(lowestBit(kind));
+		++offsets[m_patchBuckets[i] + 1];
+	}
+	m_sortKeysChanged |= (kinds & SORT_KEY_KINDS) != 0;
+	for (uint32_t k = 0; k < PATCH_KIND_COUNT; ++k) {
+		offsets[k + 1] += offsets[k];
 	}
+	if (offsets[PATCH_KIND_COUNT] == 0) return;
+
+	// Stable counting sort of the rest, so repeated patches of one kind to a sprite still apply in order.
+	// The stored patches are all of the first kind and came first, so order holds for that kind too
+	m_patchOrder.resize(offsets[PATCH_KIND_COUNT]);
+	uint32_t cursor[PATCH_KIND_COUNT];
+	std::copy_n(offsets, PATCH_KIND_COUNT, cursor);
+	for (size_t i = 0; i < count; ++i) {
+		const uint8_t bucket = m_patchBuckets[i];
+		if (bucket < PATCH_KIND_COUNT) {
+			m_patchOrder[cursor[bucket]++] = static_cast<uint32_t>(i);
+		}
+	}
+
+	// One loop per kind, each writing only its own field array
+	const auto applyBucket = [&](SpritePatch::Kind kind, auto&& apply) {
+		const uint32_t bucket = lowestBit(static_cast<uint16_t>(kind));
+		if (offsets[bucket] == offsets[bucket + 1]) return;
+		for (uint32_t i = offsets[bucket]; i < offsets[bucket + 1]; ++i) {
+			const SpritePatch& p = patches[m_patchOrder[i]];
+			apply(chunkOf(p.handle.id), p.handle.id & CHUNK_MASK, p.data);
+		}
+	};
+	applyBucket(SpritePatch::Kind::Position, [](Chunk& chunk, uint32_t slot, const auto& data) {
+		chunk.position[slot] = data.vec2v;
+	});
+	applyBucket(SpritePatch::Kind::Scale, [](Chunk& chunk, uint32_t slot, const auto& data) {
+		chunk.scale[slot] = data.vec2v;
+	});
+	applyBucket(SpritePatch::Kind::Rotation, [](Chunk& chunk, uint32_t slot, const auto& data) {
+		chunk.rotation[slot] = data.f32v;
+	});
+	applyBucket(SpritePatch::Kind::Depth, [](Chunk& chunk, uint32_t slot, const auto& data) {
+		chunk.depth[slot] = data.f32v;
+	});
+	applyBucket(SpritePatch::Kind::UV, [](Chunk& chunk, uint32_t slot, const auto& data) {
+		chunk.uvMin[slot] = data.uv.uvMin;
+		chunk.uvMax[slot] = data.uv.uvMax;
+	});
+	applyBucket(SpritePatch::Kind::TextureIndex, [](Chunk& chunk, uint32_t slot, const auto& data) {
+		chunk.textureIndex[slot] = data.u32v;
+	});
+	applyBucket(SpritePatch::Kind::Color, [](Chunk& chunk, uint32_t slot, const auto& data) {
+		chunk.colorRGBA[slot] = data.u32v;
+	});
 }
 
 bool engine::graphics::SpriteManager::getSprite(SpriteHandle h, SpriteDesc& out) const
 {
-	assert(h.index < m_spriteActiveFlags.size() && "Invalid sprite handle");
-	if (!m_spriteActiveFlags[h.index]) return false;
+	if (!isValid(h)) return false;
 
-	out = m_spriteDescriptions[h.index];
+	out = chunkOf(h.id).load(h.id & CHUNK_MASK);
 	return true;
 }
 
-BuildResult engine::graphics::SpriteManager::buildFrameBatch()
-{
-	//gather the sprites that were marked as dirty
-	BuildResult result;
-	//TODO: for now 1024 sounds a reasonable size for a temporary buffer
-	std::array<GPUSpritePacked, 1024> gpuSprites; // Temporary buffer for GPU sprites
-	//build the result data out of the dirty sprites
-	for (auto index : m_dirtiedSprites) {
-		gpuSprites.push_back(GPUSpritePacked{
-			.position = m_spriteDescriptions[index].position,
-			.scale = m_spriteDescriptions[index].scale,
-			.rotation = m_spriteDescriptions[index].rotation,
-			.depth = m_spriteDescriptions[index].depth,
-			.uv = m_spriteDescriptions[index].uv,
-			.textureIndex = m_spriteDescriptions[index].textureIndex,
-			.color = m_spriteDescriptions[index].color,
-			.pivot = m_spriteDescriptions[index].pivot,
-			.flags = m_spriteDescriptions[index].flags,
-			.userData = m_spriteDescriptions[index].userData
-		});
+bool engine::graphics::SpriteManager::isValid(SpriteHandle h) const
+{
+	if (h.id >= m_slotCount) return false;
+	const Chunk& chunk = chunkOf(h.id);
+	const uint32_t slot = h.id & CHUNK_MASK;
+	return chunk.active[slot] && chunk.versions[slot] == h.version;
+}
+
+void engine::graphics::SpriteManager::markDirty(uint32_t index, uint16_t mask)
+{
+	// the dirty bit keeps each sprite in the dirty list once
+	uint64_t& word = chunkOf(index).dirtyBits[(index & CHUNK_MASK) >> 6];
+	const uint64_t bit = uint64_t(1) << (index & 63);
+	if ((word & bit) == 0) {
+		word |= bit;
+		m_dirtiedSprites.push_back(index);
 	}
-	result.data = gpuSprites.data();
-	result.count = static_cast<uint32_t>(m_dirtiedSprites.size());
+	// texture or depth changes (and creation/destruction, which dirty everything) reorder the batched path
+	m_sortKeysChanged |= (mask & SORT_KEY_KINDS) != 0;
+}
 
+engine::graphics::SpriteManager::BuildResult engine::graphics::SpriteManager::buildFrameBatch()
+{
+	PROFILE_ZONE("SpriteManager::buildFrameBatch");
+	// slots are visited in ascending order so neighbouring dirty sprites share one copy region
+	m_ranges.clear();
+	const auto addRange = [this](uint32_t first, uint32_t count) {
+		if (!m_ranges.empty() && first - (m_ranges.back().first + m_ranges.back().count) <= RANGE_MERGE_GAP) {
+			m_ranges.back().count = first + count - m_ranges.back().first;
+		} else {
+			m_ranges.push_back(DirtyRange{ first, count });
+		}
+	};
+	const auto build = [&](Chunk& chunk, const SpriteFieldsView& fields, uint32_t index) {
+		const uint32_t slot = index & CHUNK_MASK;
+		if (chunk.active[slot]) {
+			chunk.packed[slot] = sprite_packer::pack(fields, slot);
+		} else {
+			chunk.packed[slot] = GPUSpritePacked{};
+		}
+		addRange(index, 1);
+	};
+
+	// A few dirty sprites are cheaper to sort; past one per 1024 slots, walking the dirty bits is
+	if (m_dirtiedSprites.size() <= m_slotCount / 1024) {
+		std::sort(m_dirtiedSprites.begin(), m_dirtiedSprites.end());
+		for (auto index : m_dirtiedSprites) {
+			Chunk& chunk = chunkOf(index);
+			chunk.dirtyBits[(index & CHUNK_MASK) >> 6] &= ~(uint64_t(1) << (index & 63));
+			build(chunk, chunk.fields(), index);
+		}
+	} else {
+		for (uint32_t base = 0; base < m_slotCount; base += CHUNK_SIZE) {
+			Chunk& chunk = *m_chunks[base >> CHUNK_SHIFT];
+			const SpriteFieldsView fields = chunk.fields();
+			for (uint32_t w = 0; w < CHUNK_SIZE / 64; ++w) {
+				const uint64_t dirty = chunk.dirtyBits[w];
+				if (dirty == ~uint64_t(0)) {
+					// a fully dirty word (everything moved, or new sprites) streams the field arrays as one run
+					const uint32_t first = w * 64;
+					sprite_packer::pack(fields, first, 64, chunk.packed + first);
+					for (uint32_t slot = first; slot < first + 64; ++slot) {
+						if (!chunk.active[slot]) chunk.packed[slot] = GPUSpritePacked{};
+					}
+					addRange(base + first, 64);
+				} else {
+					for (uint64_t word = dirty; word != 0; word &= word - 1) {
+						build(chunk, fields, base + w * 64 + lowestBit(word));
+					}
+				}
+				chunk.dirtyBits[w] = 0;
+			}
+		}
+	}
+
+	const uint32_t spriteCount = static_cast<uint32_t>(m_dirtiedSprites.size());
 	//clear the dirty list after building
 	m_dirtiedSprites.clear();
-	m_dirtyMask.clear();
-	return result;
+	const bool sortKeysChanged = m_sortKeysChanged;
+	m_sortKeysChanged = false;
+	return BuildResult{ m_ranges.data(), static_cast<uint32_t>(m_ranges.size()), spriteCount, sortKeysChanged };
+}
+
+void engine::graphics::SpriteManager::copyPacked(uint32_t first, uint32_t count, GPUSpritePacked* dst) const
+{
+	assert(static_cast<uint64_t>(first) + count <= m_slotCount && "Copy range past the last slot");
+	// a range may span chunks; copy it chunk by chunk
+	while (count > 0) {
+		const uint32_t slot = first & CHUNK_MASK;
+		const uint32_t n = std::min(count, CHUNK_SIZE - slot);
+		std::copy_n(chunkOf(first).packed + slot, n, dst);
+		dst += n;
+		first += n;
+		count -= n;
+	}
 }
 
 size_t engine::graphics::SpriteManager::liveCount() const
 {
-	return std::count(m_spriteActiveFlags.begin(), m_spriteActiveFlags.end(), true);
+	return m_slotCount - m_freeList.size();
 }
@@ -0,0 +1,234 @@
+#include "sprite_packer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+// MSVC has no __F16C__; its /arch:AVX2 implies F16C. GCC and Clang need -mf16c (or an -march that has it)
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#include <immintrin.h>
+#define SPRITE_PACKER_F16C 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SPRITE_PACKER_SSE2 1
+#endif
+
+namespace {
+
+using engine::graphics::GPUSpritePacked;
+using engine::graphics::SpriteDesc;
+
+using engine::graphics::SpriteFieldsView;
+
+// The three float pairs scale, uvMin and uvMax are converted together and land in six consecutive halves
+static_assert(offsetof(GPUSpritePacked, uvMaxY) == offsetof(GPUSpritePacked, scaleX) + 5 * sizeof(uint16_t), "GPUSpritePacked half fields must be contiguous");
+
+constexpr float TWO_PI = 6.28318530717958647692f;
+
+#if SPRITE_PACKER_SSE2
+inline __m128i select(__m128i mask, __m128i a, __m128i b)
+{
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+// floatToHalf for four lanes; halves come back sign-extended so _mm_packs_epi32 keeps them intact
+inline __m128i floatToHalf4(__m128 value)
+{
+	__m128i f = _mm_castps_si128(value);
+	const __m128i sign = _mm_and_si128(f, _mm_set1_epi32(static_cast<int>(0x80000000u)));
+	f = _mm_xor_si128(f, sign);
+
+	// Every lane computes all three cases of floatToHalf, then the right one is blended in
+	const __m128i overflow = _mm_cmpgt_epi32(f, _mm_set1_epi32(0x477FFFFF));
+	const __m128i nan = _mm_cmpgt_epi32(f, _mm_set1_epi32(0x7F800000));
+	const __m128i large = _mm_or_si128(_mm_set1_epi32(0x7C00), _mm_and_si128(nan, _mm_set1_epi32(0x0200)));
+	const __m128i subnormal = _mm_cmplt_epi32(f, _mm_set1_epi32(0x38800000));
+	const __m128i small = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(f), _mm_set1_ps(0.5f))), _mm_set1_epi32(0x3F000000));
+	const __m128i mantissaOdd = _mm_and_si128(_mm_srli_epi32(f, 13), _mm_set1_epi32(1));
+	const __m128i normal = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(f, _mm_set1_epi32(static_cast<int>(0xC8000FFFu))), mantissaOdd), 13);
+
+	__m128i half = select(overflow, large, select(subnormal, small, normal));
+	half = _mm_or_si128(half, _mm_srli_epi32(sign, 16));
+	return _mm_srai_epi32(_mm_slli_epi32(half, 16), 16);
+}
+#endif
+
+// Each argument points at an (x, y) float pair
+inline void packHalves(const float* scale, const float* uvMin, const float* uvMax, GPUSpritePacked& out)
+{
+#if SPRITE_PACKER_F16C || SPRITE_PACKER_SSE2
+	// scaleX, scaleY, uvMinX, uvMinY | uvMaxX, uvMaxY, 0, 0 (the last two halves are dropped)
+	const __m128 first = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(scale)), reinterpret_cast<const __m64*>(uvMin));
+	const __m128 second = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(uvMax));
+#if SPRITE_PACKER_F16C
+	const __m128i halves = _mm_unpacklo_epi64(_mm_cvtps_ph(first, _MM_FROUND_TO_NEAREST_INT), _mm_cvtps_ph(second, _MM_FROUND_TO_NEAREST_INT));
+#else
+	const __m128i halves = _mm_packs_epi32(floatToHalf4(first), floatToHalf4(second));
+#endif
+	_mm_storel_epi64(reinterpret_cast<__m128i*>(&out.scaleX), halves);
+	const int32_t uvMaxHalves = _mm_cvtsi128_si32(_mm_srli_si128(halves, 8));
+	std::memcpy(&out.uvMaxX, &uvMaxHalves, sizeof(uvMaxHalves));
+#else
+	using engine::graphics::sprite_packer::floatToHalf;
+	out.scaleX = floatToHalf(scale[0]);
+	out.scaleY = floatToHalf(scale[1]);
+	out.uvMinX = floatToHalf(uvMin[0]);
+	out.uvMinY = floatToHalf(uvMin[1]);
+	out.uvMaxX = floatToHalf(uvMax[0]);
+	out.uvMaxY = floatToHalf(uvMax[1]);
+#endif
+}
+
+inline uint16_t rotationSteps(float radians)
+{
+	// Round to the nearest step; whole turns wrap away in the 16-bit truncation
+	constexpr float STEPS_PER_RADIAN = engine::graphics::sprite_packer::ROTATION_STEPS / TWO_PI;
+	float steps = radians * STEPS_PER_RADIAN;
+	// Past int32 the conversion is undefined: drop whole turns first. NaN and infinities have no angle
+	if (!(std::fabs(steps) < 2147483520.0f)) {
+		if (!std::isfinite(radians)) return 0;
+		steps = std::remainder(radians, TWO_PI) * STEPS_PER_RADIAN;
+	}
+	return static_cast<uint16_t>(static_cast<int32_t>(steps + (steps < 0.0f ? -0.5f : 0.5f)));
+}
+
+inline uint32_t depthTextureWord(float depth, uint32_t textureIndex)
+{
+	using engine::graphics::sprite_packer::DEFAULT_TEXTURE_INDEX;
+	using engine::graphics::sprite_packer::MAX_TEXTURE_INDEX;
+	// Masking would alias another texture; the default one makes a bad index visible instead
+	const uint32_t texture = textureIndex <= MAX_TEXTURE_INDEX ? textureIndex : DEFAULT_TEXTURE_INDEX;
+	// Written so NaN fails the comparison and packs as 0
+	const float clamped = depth > 0.0f ? std::min(depth, 1.0f) : 0.0f;
+	const uint32_t depthBits = static_cast<uint32_t>(clamped * 65535.0f + 0.5f);
+	return (depthBits << 16) | texture;
+}
+
+// Writes straight into `out` so the batch loops need no temporary
+inline void packInto(const SpriteDesc& desc, GPUSpritePacked& out)
+{
+	out.posX = desc.posX;
+	out.posY = desc.posY;
+	packHalves(&desc.scaleX, &desc.uvMinX, &desc.uvMaxX, out);
+	out.rotation = rotationSteps(desc.rotation);
+	out.reserved = 0;
+	out.depthTexture = depthTextureWord(desc.depth, desc.textureIndex);
+	out.colorRGBA = desc.colorRGBA;
+}
+
+inline void packInto(const SpriteFieldsView& fields, size_t i, GPUSpritePacked& out)
+{
+	out.posX = fields.position[i].x;
+	out.posY = fields.position[i].y;
+	packHalves(&fields.scale[i].x, &fields.uvMin[i].x, &fields.uvMax[i].x, out);
+	out.rotation = rotationSteps(fields.rotation[i]);
+	out.reserved = 0;
+	out.depthTexture = depthTextureWord(fields.depth[i], fields.textureIndex[i]);
+	out.colorRGBA = fields.colorRGBA[i];
+}
+
+} // namespace
+
+engine::graphics::GPUSpritePacked engine::graphics::sprite_packer::pack(const SpriteDesc& desc)
+{
+	GPUSpritePacked out;
+	packInto(desc, out);
+	return out;
+}
+
+void engine::graphics::sprite_packer::pack(const SpriteDesc* src, GPUSpritePacked* dst, size_t count)
+{
+	for (size_t i = 0; i < count; ++i) {
+		packInto(src[i], dst[i]);
+	}
+}
+
+engine::graphics::GPUSpritePacked engine::graphics::sprite_packer::pack(const SpriteFieldsView& fields, size_t index)
+{
+	GPUSpritePacked out;
+	packInto(fields, index, out);
+	return out;
+}
+
+void engine::graphics::sprite_packer::pack(const SpriteFieldsView& fields, size_t first, size_t count, GPUSpritePacked* dst)
+{
+	for (size_t i = 0; i < count; ++i) {
+		packInto(fields, first + i, dst[i]);
+	}
+}
+
+uint16_t engine::graphics::sprite_packer::floatToHalf(float value)
+{
+	uint32_t f;
+	std::memcpy(&f, &value, sizeof(f));
+	const uint32_t sign = f & 0x80000000u;
+	f ^= sign;
+
+	uint16_t half;
+	if (f > 0x477FFFFFu) {
+		// At least 65536 (rounds past the largest half), infinity or NaN
+		half = f > 0x7F800000u ? 0x7E00 : 0x7C00;
+	} else if (f < 0x38800000u) {
+		// Below the smallest normal half: adding 0.5 lines the mantissa up so the FPU rounds it
+		float shifted;
+		std::memcpy(&shifted, &f, sizeof(shifted));
+		shifted += 0.5f;
+		uint32_t bits;
+		std::memcpy(&bits, &shifted, sizeof(bits));
+		half = static_cast<uint16_t>(bits - 0x3F000000u);
+	} else {
+		// Rebias the exponent and round to nearest, ties to even
+		const uint32_t mantissaOdd = (f >> 13) & 1u;
+		f += 0xC8000FFFu;
+		f += mantissaOdd;
+		half = static_cast<uint16_t>(f >> 13);
+	}
+	return static_cast<uint16_t>(half | (sign >> 16));
+}
+
+float engine::graphics::sprite_packer::halfToFloat(uint16_t half)
+{
+	const uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+	const uint32_t exponent = (half >> 10) & 0x1Fu;
+	const uint32_t mantissa = half & 0x3FFu;
+	uint32_t bits;
+	if (exponent == 0) {
+		// Subnormal or zero: mantissa * 2^-24
+		const float magnitude = static_cast<float>(mantissa) * 5.9604644775390625e-8f;
+		std::memcpy(&bits, &magnitude, sizeof(bits));
+		bits |= sign;
+	} else if (exponent == 0x1F) {
+		bits = sign | 0x7F800000u | (mantissa << 13);
+	} else {
+		bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+	}
+	float value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+uint16_t engine::graphics::sprite_packer::quantizeRotation(float radians)
+{
+	return rotationSteps(radians);
+}
+
+float engine::graphics::sprite_packer::dequantizeRotation(uint16_t rotation)
+{
+	return static_cast<float>(rotation) * (TWO_PI / ROTATION_STEPS);
+}
+
+uint32_t engine::graphics::sprite_packer::packDepthTexture(float depth, uint32_t textureIndex)
+{
+	return depthTextureWord(depth, textureIndex);
+}
+
+const char* engine::graphics::sprite_packer::simdPath()
+{
+#if SPRITE_PACKER_F16C
+	return "f16c";
+#elif SPRITE_PACKER_SSE2
+	return "sse2";
+#else
+	return "scalar";
+#endif
+}
@@ -289,7 +289,7 @@ namespace engine::graphics::GUI
 	}
 
 	/** Update vertex and index buffer containing the imGui elements when required */
-	bool UIOverlay::update()
+	bool UIOverlay::update(uint32_t currentBuffer)
 	{
 		ImDrawData* imDrawData = ImGui::GetDrawData();
 		bool updateCmdBuffers = false;
@@ -305,6 +305,11 @@ namespace engine::graphics::GUI
 			return false;
 		}
 
+		engine::graphics::vulkan_utils::VulkanBuffer& vertexBuffer = this->vertexBuffer[currentBuffer];
+		engine::graphics::vulkan_utils::VulkanBuffer& indexBuffer = this->indexBuffer[currentBuffer];
+		int32_t& vertexCount = this->vertexCount[currentBuffer];
+		int32_t& indexCount = this->indexCount[currentBuffer];
+
 		// Vertex buffer
 		if ((vertexBuffer.buffer == VK_NULL_HANDLE) || (vertexCount != imDrawData->TotalVtxCount)) {
 			vertexBuffer.unmap();
@@ -345,13 +350,13 @@ namespace engine::graphics::GUI
 		return updateCmdBuffers;
 	}
 
-	void UIOverlay::draw(const VkCommandBuffer commandBuffer)
+	void UIOverlay::draw(const VkCommandBuffer commandBuffer, uint32_t currentBuffer)
 	{
 		ImDrawData* imDrawData = ImGui::GetDrawData();
 		int32_t vertexOffset = 0;
 		int32_t indexOffset = 0;
 
-		if ((!imDrawData) || (imDrawData->CmdListsCount == 0)) {
+		if ((!imDrawData) || (imDrawData->CmdListsCount == 0) || (vertexBuffer[currentBuffer].buffer == VK_NULL_HANDLE)) {
 			return;
 		}
 
@@ -365,8 +370,8 @@ namespace engine::graphics::GUI
 		vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(PushConstBlock), &pushConstBlock);
 
 		VkDeviceSize offsets[1] = { 0 };
-		vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertexBuffer.buffer, offsets);
-		vkCmdBindIndexBuffer(commandBuffer, indexBuffer.buffer, 0, VK_INDEX_TYPE_UINT16);
+		vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertexBuffer[currentBuffer].buffer, offsets);
+		vkCmdBindIndexBuffer(commandBuffer, indexBuffer[currentBuffer].buffer, 0, VK_INDEX_TYPE_UINT16);
 
 		for (int32_t i = 0; i < imDrawData->CmdListsCount; i++)
 		{
@@ -386,7 +391,7 @@ namespace engine::graphics::GUI
 #if (defined(VK_USE_PLATFORM_IOS_MVK) || defined(VK_USE_PLATFORM_METAL_EXT)) && TARGET_OS_SIMULATOR
 			// Apple Device Simulator does not support vkCmdDrawIndexed() with vertexOffset > 0, so rebind vertex buffer instead
 			offsets[0] += cmd_list->VtxBuffer.Size * sizeof(ImDrawVert);
-			vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertexBuffer.buffer, offsets);
+			vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertexBuffer[currentBuffer].buffer, offsets);
 #else
 			vertexOffset += cmd_list->VtxBuffer.Size;
 #endif
@@ -401,8 +406,10 @@ namespace engine::graphics::GUI
 
 	void UIOverlay::freeResources()
 	{
-		vertexBuffer.destroy();
-		indexBuffer.destroy();
+		for (uint32_t i = 0; i < maxConcurrentFrames; i++) {
+			vertexBuffer[i].destroy();
+			indexBuffer[i].destroy();
+		}
 		vkDestroyImageView(device->logicalDevice, fontView, nullptr);
 		vkDestroyImage(device->logicalDevice, fontImage, nullptr);
 		vkFreeMemory(device->logicalDevice, fontMemory, nullptr);
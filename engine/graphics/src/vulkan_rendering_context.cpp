@@ -3,11 +3,14 @@
 #include "vulkan_device.h"
 #include "vulkan_tools.h"
 #include "window.h"
+#include <algorithm>
 #include <set>
 #include <vector>
 #include <array>
 #include "utils.h"
 #include "camera.h"
+#include "utils/profiler.h"
+#include "config_flags.h"
 
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
@@ -50,7 +53,7 @@ namespace vulkan_utils {
 }
 
 VulkanRenderingContext::VulkanRenderingContext(const glfw_window& window) :
-	m_window(window),
+	m_window(&window),
 	m_instance(VK_NULL_HANDLE),
 	m_surface(VK_NULL_HANDLE),
 	m_depthStencil(),
@@ -65,6 +68,23 @@ VulkanRenderingContext::VulkanRenderingContext(const glfw_window& window) :
 	m_commandPool(VK_NULL_HANDLE) {
 }
 
+VulkanRenderingContext::VulkanRenderingContext(uint32_t width, uint32_t height) :
+	m_window(nullptr),
+	m_offscreenWidth(width),
+	m_offscreenHeight(height),
+	m_instance(VK_NULL_HANDLE),
+	m_surface(VK_NULL_HANDLE),
+	m_depthStencil(),
+	m_framebuffers(),
+	m_shaderModules(),
+	m_gui(),
+	m_benchmark(),
+	m_currentFrame(0),
+	m_currentImageIndex(0),
+	m_framebufferResized(false),
+	m_commandPool(VK_NULL_HANDLE) {
+}
+
 VulkanRenderingContext::~VulkanRenderingContext() {
 	if (m_initialized) {
 		shutdown();
@@ -72,8 +92,8 @@ VulkanRenderingContext::~VulkanRenderingContext() {
 }
 
 bool VulkanRenderingContext::initialize() {
-	if (m_window.getWindowHandle() == nullptr) {
-		return false; // No window handle available
+	if (isOffscreen() ? (m_offscreenWidth == 0 || m_offscreenHeight == 0) : m_window->getWindowHandle() == nullptr) {
+		return false; // No window handle or empty offscreen target
 	}
 	if (m_initialized) {
 		return false; // Already initialized
@@ -90,11 +110,17 @@ bool VulkanRenderingContext::initialize() {
 	if (!createLogicalDevice()) {
 		return false;
 	}
-	if (!createSurface()) {
-		return false;
-	}
-	if (!createSwapchain()) {
-		return false;
+	if (isOffscreen()) {
+		if (!createOffscreenTargets()) {
+			return false;
+		}
+	} else {
+		if (!createSurface()) {
+			return false;
+		}
+		if (!createSwapchain()) {
+			return false;
+		}
 	}
 	if (!createCommandPool()) {
 		return false;
@@ -105,6 +131,9 @@ bool VulkanRenderingContext::initialize() {
 	if (!createSyncObjects()) {
 		return false;
 	}
+	if (!createGpuProfiler()) {
+		return false;
+	}
 	if (!setupDepthStencil()) {
 		return false;
 	}
@@ -126,6 +155,12 @@ bool VulkanRenderingContext::initialize() {
 	if (!createUniformBuffers()) {
 		return false;
 	}
+	if (!createSpriteBuffer()) {
+		return false;
+	}
+	if (!createTextureTable()) {
+		return false;
+	}
 	if (!createDescriptorSetLayout()) {
 		return false;
 	}
@@ -138,6 +173,9 @@ bool VulkanRenderingContext::initialize() {
 	if (!createPipelines()) {
 		return false;
 	}
+	if (!createSpriteCuller()) {
+		return false;
+	}
 	m_initialized = true;
 	return true;
 }
@@ -159,6 +197,16 @@ void VulkanRenderingContext::shutdown() {
 		}
 		vkDestroyFence(m_device->logicalDevice, m_inFlightFences[i], nullptr);
 	}
+
+	m_gpuProfiler.destroy();
+	m_spriteBuffer.destroy();
+	m_spriteCuller.destroy();
+	m_textureTable.destroy();
+	destroyDefaultTexture();
+	if (m_spritePipeline != VK_NULL_HANDLE) {
+		vkDestroyPipeline(m_device->logicalDevice, m_spritePipeline, nullptr);
+		m_spritePipeline = VK_NULL_HANDLE;
+	}
 	
 	// Cleanup command buffers
 	if (!m_commandBuffers.empty()) {
@@ -173,6 +221,8 @@ void VulkanRenderingContext::shutdown() {
 	if (m_swapchain) {
 		m_swapchain->cleanup();
 	}
+	destroyOffscreenTargets();
+	destroyReadbackBuffer();
 	
 	// Cleanup surface and instance
 	if (m_surface != VK_NULL_HANDLE) {
@@ -188,19 +238,24 @@ void VulkanRenderingContext::shutdown() {
 }
 
 bool VulkanRenderingContext::beginFrame() {
+	PROFILE_ZONE("Vulkan::beginFrame");
 	if (!m_initialized) {
 		return false; // Not initialized
 	}
 	
 	// Check if window is minimized (width or height = 0)
-	int windowWidth, windowHeight;
-	m_window.getWindowSize(&windowWidth, &windowHeight);
+	uint32_t windowWidth, windowHeight;
+	getRenderExtent(windowWidth, windowHeight);
 	if (windowWidth == 0 || windowHeight == 0) {
 		return false; // Skip rendering when minimized
 	}
 	
 	// Wait for the current frame to finish
-	VkResult waitResult = vkWaitForFences(m_device->logicalDevice, 1, &m_inFlightFences[m_currentFrame], VK_TRUE, UINT64_MAX);
+	VkResult waitResult;
+	{
+		PROFILE_ZONE("Vulkan::waitForFrameFence");
+		waitResult = vkWaitForFences(m_device->logicalDevice, 1, &m_inFlightFences[m_currentFrame], VK_TRUE, UINT64_MAX);
+	}
 		if (waitResult != VK_SUCCESS) {
 			std::cerr << "Failed to wait for fence! VkResult: " << waitResult << std::endl;
 			return false;
@@ -212,9 +267,22 @@ bool VulkanRenderingContext::beginFrame() {
 			std::cerr << "Failed to reset fence! VkResult: " << resetResult << std::endl;
 			return false;
 		}
+
+	// Texture slots removed MAX_FRAMES_IN_FLIGHT frames ago are no longer sampled by any pending frame
+	m_textureTable.nextFrame();
+
+	if (isOffscreen()) {
+		// Each frame in flight owns its offscreen target, guarded by the fence waited on above
+		m_currentImageIndex = m_currentFrame;
+		return true;
+	}
 	
 	// Acquire the next image from the swapchain
-	VkResult result = m_swapchain->acquireNextImage(m_imageAvailableSemaphores[m_currentFrame], m_currentImageIndex);
+	VkResult result;
+	{
+		PROFILE_ZONE("Vulkan::acquireNextImage");
+		result = m_swapchain->acquireNextImage(m_imageAvailableSemaphores[m_currentFrame], m_currentImageIndex);
+	}
 	if (result == VK_ERROR_OUT_OF_DATE_KHR) {
 		//window resizing is handled by the renderer.
 		return false; // Skip this frame
@@ -232,14 +300,50 @@ void VulkanRenderingContext::endFrame() {
 }
 
 void VulkanRenderingContext::render(const Camera& camera) {
-	renderGame(camera);
+	// The overlay is built first; its geometry is drawn inside the game's render pass
 	renderOverlay(camera);
+	renderGame(camera);
 }
 void VulkanRenderingContext::renderOverlay(const Camera& camera) {
-	// Record the command buffer for rendering the UI overlay
-	
+	PROFILE_ZONE("Vulkan::renderOverlay");
+	uint32_t width, height;
+	getRenderExtent(width, height);
+	m_gui.resize(width, height);
+
+	const auto now = std::chrono::steady_clock::now();
+	ImGuiIO& io = ImGui::GetIO();
+	io.DeltaTime = m_lastOverlayTime.time_since_epoch().count() == 0 ? 1.0f / 60.0f : std::max(std::chrono::duration<float>(now - m_lastOverlayTime).count(), 1e-6f);
+	m_lastOverlayTime = now;
+
+	ImGui::NewFrame();
+	ImGui::SetNextWindowPos(ImVec2(10.0f, 10.0f), ImGuiCond_FirstUseEver);
+	ImGui::Begin("GPU timings", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+	if (!m_gpuProfiler.isSupported()) {
+		ImGui::TextUnformatted("Timestamp queries not supported");
+	} else {
+		// Results lag a few frames behind, one per frame in flight
+		ImGui::Text("GPU frame: %.3f ms", m_gpuProfiler.getFrameMs());
+		for (const GpuScopeResult& scope : m_gpuProfiler.getResults()) {
+			ImGui::Text("%*s%s: %.3f ms", static_cast<int>(scope.depth * 2), "", scope.name, scope.durationMs);
+		}
+	}
+	const SpriteGpuBuffer::UploadStats& spriteUpload = m_spriteBuffer.getLastUploadStats();
+	ImGui::Separator();
+	ImGui::Text("Sprites: %zu live, %u slots", m_sprites.liveCount(), m_spriteBuffer.getSpriteCount());
+	ImGui::Text("Sprite upload: %.1f KB in %u ranges", static_cast<double>(spriteUpload.bytes) / 1024.0, spriteUpload.ranges);
+	if (m_textureTable.isBindless()) {
+		// Count of the frame this slot last rendered, a few frames back
+		ImGui::Text("Sprite draws: 1 (bindless), %u visible after culling", m_spriteCuller.getVisibleCount(m_currentFrame));
+	} else {
+		ImGui::Text("Sprite draws: %zu (per texture)", m_spriteBatcher.getRuns().size());
+	}
+	ImGui::End();
+	ImGui::Render();
+
+	m_gui.update(m_currentFrame);
 }
 void VulkanRenderingContext::renderGame(const Camera& camera) {
+	PROFILE_ZONE("Vulkan::renderGame");
 	ShaderData shaderData{};
 	
 	shaderData.projectionMatrix = camera.matrices.perspective;
@@ -250,6 +354,36 @@ void VulkanRenderingContext::renderGame(const Camera& camera) {
 	// Copy to the uniform buffer that matches the descriptor set we'll bind
 	memcpy(m_uniformBuffers[m_currentFrame].mapped, &shaderData, sizeof(ShaderData));
 
+	// Only sprites changed since this frame's buffer was last written are copied
+	bool spritesReady = false;
+	{
+		PROFILE_ZONE("Vulkan::uploadSprites");
+		const SpriteManager::BuildResult spriteBuild = m_sprites.buildFrameBatch();
+		spritesReady = m_spriteBuffer.upload(m_currentFrame, m_sprites, spriteBuild);
+		if (!m_textureTable.isBindless()) {
+			// Sprites that only moved keep their place in the order
+			if (spriteBuild.sortKeysChanged) {
+				m_spriteBatcher.build(m_sprites);
+			}
+			spritesReady = spritesReady && m_spriteBuffer.uploadOrder(m_currentFrame, m_spriteBatcher.getOrder(), m_spriteBatcher.getVersion());
+		}
+	}
+	// A failed allocation leaves this frame without a sprite buffer or visible list; skip the
+	// cull and the sprite pass (and keep the descriptors away from missing buffers) until one succeeds
+	if (spritesReady) {
+		const SpriteGpuBuffer::UploadStats& uploadStats = m_spriteBuffer.getLastUploadStats();
+		bool visibleReallocated = false;
+		if (m_textureTable.isBindless()) {
+			const SpriteCuller::PrepareResult visible = m_spriteCuller.prepare(m_currentFrame, m_spriteBuffer.getSpriteCount());
+			spritesReady = visible != SpriteCuller::PrepareResult::Failed;
+			visibleReallocated = visible == SpriteCuller::PrepareResult::Reallocated;
+		}
+		if (spritesReady && (uploadStats.reallocated || uploadStats.orderReallocated || visibleReallocated)) {
+			// This frame's fence was waited on, so its descriptor set is not in use
+			updateSpriteDescriptor(m_currentFrame);
+		}
+	}
+
 	// Use command buffer that matches the swapchain image (if we have enough)
 	uint32_t commandBufferIndex = (m_commandBuffers.size() > m_currentImageIndex) ? m_currentImageIndex : (m_currentImageIndex % m_commandBuffers.size());
 
@@ -269,10 +403,10 @@ void VulkanRenderingContext::renderGame(const Camera& camera) {
 	renderPassBeginInfo.renderPass = m_renderPass;
 	renderPassBeginInfo.renderArea.offset.x = 0;
 	renderPassBeginInfo.renderArea.offset.y = 0;
-	int width, height;
-	m_window.getWindowSize(&width, &height);
-	renderPassBeginInfo.renderArea.extent.width = static_cast<uint32_t>(width);
-	renderPassBeginInfo.renderArea.extent.height = static_cast<uint32_t>(height);
+	uint32_t width, height;
+	getRenderExtent(width, height);
+	renderPassBeginInfo.renderArea.extent.width = width;
+	renderPassBeginInfo.renderArea.extent.height = height;
 	renderPassBeginInfo.clearValueCount = 2;
 	renderPassBeginInfo.pClearValues = clearValues;
 	renderPassBeginInfo.framebuffer = m_framebuffers[m_currentImageIndex];
@@ -280,6 +414,17 @@ void VulkanRenderingContext::renderGame(const Camera& camera) {
 	const VkCommandBuffer commandBuffer = m_commandBuffers[commandBufferIndex];  // FIXED!
 	VK_CHECK_RESULT(vkBeginCommandBuffer(commandBuffer, &cmdBufInfo));
 
+	// Query resets must be recorded outside the render pass
+	m_gpuProfiler.beginFrame(commandBuffer, m_currentFrame);
+	const uint32_t frameScope = m_gpuProfiler.beginScope(commandBuffer, "Frame");
+	if (spritesReady && m_textureTable.isBindless() && m_spriteBuffer.getSpriteCount() > 0) {
+		// Compute work has to be recorded outside the render pass
+		GpuProfiler::Scope cullScope(m_gpuProfiler, commandBuffer, m_spriteCuller.isSorting() ? "SpriteCullSort" : "SpriteCull");
+		m_spriteCuller.record(commandBuffer, m_currentFrame, m_uniformBuffers[m_currentFrame].descriptorSet,
+			m_spriteBuffer.getSpriteCount(), shaderData.projectionMatrix * shaderData.viewMatrix);
+	}
+	const uint32_t renderPassScope = m_gpuProfiler.beginScope(commandBuffer, "RenderPass");
+
 	// Start the first sub pass specified in our default render pass setup by the base class
 	// This will clear the color and depth attachment
 	vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
@@ -292,8 +437,8 @@ void VulkanRenderingContext::renderGame(const Camera& camera) {
 	vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
 	// Update dynamic scissor state
 	VkRect2D scissor{};
-	scissor.extent.width = static_cast<uint32_t>(width);
-	scissor.extent.height = static_cast<uint32_t>(height);
+	scissor.extent.width = width;
+	scissor.extent.height = height;
 	scissor.offset.x = 0;
 	scissor.offset.y = 0;
 	vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
@@ -309,9 +454,19 @@ void VulkanRenderingContext::renderGame(const Camera& camera) {
 	vkCmdBindIndexBuffer(commandBuffer, m_indexBuffer.buffer, 0, VK_INDEX_TYPE_UINT32);
 	// Draw indexed triangle
 	vkCmdDrawIndexed(commandBuffer, m_indexBuffer.count, 1, 0, 0, 0);
+	if (spritesReady) {
+		drawSprites(commandBuffer);
+	}
+	if (m_gui.visible) {
+		GpuProfiler::Scope overlayScope(m_gpuProfiler, commandBuffer, "UIOverlay");
+		m_gui.draw(commandBuffer, m_currentFrame);
+	}
 	vkCmdEndRenderPass(commandBuffer);
+	m_gpuProfiler.endScope(commandBuffer, renderPassScope);
+	m_gpuProfiler.endScope(commandBuffer, frameScope);
 	// Ending the render pass will add an implicit barrier transitioning the frame buffer color attachment to
 	// VK_IMAGE_LAYOUT_PRESENT_SRC_KHR for presenting it to the windowing system
+	// (VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL for readback in offscreen mode)
 	VK_CHECK_RESULT(vkEndCommandBuffer(commandBuffer));
 	
 	// Submit the command buffer to the graphics queue
@@ -325,14 +480,27 @@ void VulkanRenderingContext::renderGame(const Camera& camera) {
 	submitInfo.commandBufferCount = 1;                  // We submit a single command buffer
 
 	// Semaphore to wait upon before the submitted command buffer starts executing
-	submitInfo.pWaitSemaphores = &m_imageAvailableSemaphores[m_currentFrame];
-	submitInfo.waitSemaphoreCount = 1;
-	// Semaphore to be signaled when command buffers have completed
-	submitInfo.pSignalSemaphores = &m_renderFinishedSemaphores[m_currentFrame];
-	submitInfo.signalSemaphoreCount = 1;
+	// Offscreen frames have no image acquire or present to synchronize with, only the fence
+	if (!isOffscreen()) {
+		submitInfo.pWaitSemaphores = &m_imageAvailableSemaphores[m_currentFrame];
+		submitInfo.waitSemaphoreCount = 1;
+		// Semaphore to be signaled when command buffers have completed
+		submitInfo.pSignalSemaphores = &m_renderFinishedSemaphores[m_currentFrame];
+		submitInfo.signalSemaphoreCount = 1;
+	}
 
 	// Submit to the graphics queue passing a wait fence
-	VK_CHECK_RESULT(vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, m_inFlightFences[m_currentFrame]));
+	{
+		PROFILE_ZONE("Vulkan::queueSubmit");
+		VK_CHECK_RESULT(vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, m_inFlightFences[m_currentFrame]));
+	}
+	// GPU scopes of this frame are placed on the CPU timeline at the submit
+	m_gpuProfiler.endFrame(Profiling::Profiler::getInstance().now());
+	m_lastSubmittedFrame = m_currentFrame;
+
+	if (isOffscreen()) {
+		return;
+	}
 
 	// Present the current frame buffer to the swap chain
 	VkPresentInfoKHR presentInfo{};
@@ -342,7 +510,11 @@ void VulkanRenderingContext::renderGame(const Camera& camera) {
 	presentInfo.swapchainCount = 1;
 	presentInfo.pSwapchains = &m_swapchain->swapChain;
 	presentInfo.pImageIndices = &m_currentImageIndex;
-	VkResult result = vkQueuePresentKHR(m_graphicsQueue, &presentInfo);
+	VkResult result;
+	{
+		PROFILE_ZONE("Vulkan::queuePresent");
+		result = vkQueuePresentKHR(m_graphicsQueue, &presentInfo);
+	}
 
 	if (result != VK_SUCCESS) {
 		std::cerr << "Failed to present swap chain image! VkResult: " << result << std::endl;
@@ -400,16 +572,25 @@ void VulkanRenderingContext::cleanupSwapchainResources()
 	if (m_swapchain) {
 		m_swapchain->cleanup();
 	}
+	destroyOffscreenTargets();
 }
 
 bool VulkanRenderingContext::recreateSwapchainResources(uint32_t width, uint32_t height)
 {
-	// Note: VulkanSwapChain::create expects references that can be modified
-	uint32_t swapchainWidth = width;
-	uint32_t swapchainHeight = height;
-	
-	// Recreate swapchain
-	m_swapchain->create(swapchainWidth, swapchainHeight, false, false);
+	if (isOffscreen()) {
+		m_offscreenWidth = width;
+		m_offscreenHeight = height;
+		if (!createOffscreenTargets()) {
+			return false;
+		}
+	} else {
+		// Note: VulkanSwapChain::create expects references that can be modified
+		uint32_t swapchainWidth = width;
+		uint32_t swapchainHeight = height;
+
+		// Recreate swapchain
+		m_swapchain->create(swapchainWidth, swapchainHeight, false, false);
+	}
 	
 	// Recreate depth stencil with new dimensions
 	if (!setupDepthStencil()) {
@@ -435,14 +616,75 @@ bool VulkanRenderingContext::recreateSwapchainResources(uint32_t width, uint32_t
 
 void VulkanRenderingContext::getDrawableSize(uint32_t& width, uint32_t& height) const
 {
-	//TODO: DO WE NEED THIS?
-	/*if (m_swapchain) {
-		
-		m_swapchain->images[0]->getSize(width, height);0
-    } else {
-        width = 0;
-        height = 0;
-    }*/
+	getRenderExtent(width, height);
+}
+
+void VulkanRenderingContext::getRenderExtent(uint32_t& width, uint32_t& height) const
+{
+	if (isOffscreen()) {
+		width = m_offscreenWidth;
+		height = m_offscreenHeight;
+		return;
+	}
+	int windowWidth, windowHeight;
+	m_window->getWindowSize(&windowWidth, &windowHeight);
+	width = static_cast<uint32_t>(windowWidth);
+	height = static_cast<uint32_t>(windowHeight);
+}
+
+bool VulkanRenderingContext::readbackFrame(std::vector<uint8_t>& pixels, uint32_t& width, uint32_t& height)
+{
+	if (!m_initialized || !isOffscreen() || m_lastSubmittedFrame == UINT32_MAX) {
+		return false; // Nothing rendered offscreen yet
+	}
+	const OffscreenTarget& target = m_offscreenTargets[m_lastSubmittedFrame];
+	width = m_offscreenWidth;
+	height = m_offscreenHeight;
+	const VkDeviceSize size = static_cast<VkDeviceSize>(width) * height * 4;
+
+	VK_CHECK(vkWaitForFences(m_device->logicalDevice, 1, &m_inFlightFences[m_lastSubmittedFrame], VK_TRUE, UINT64_MAX));
+
+	if (m_readbackSize < size) {
+		destroyReadbackBuffer();
+		VK_CHECK(m_device->createBuffer(VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			size, &m_readbackBuffer, &m_readbackMemory));
+		m_readbackSize = size;
+	}
+
+	VkCommandBuffer copyCmd = m_device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, m_commandPool, true);
+
+	// The render pass left the image in TRANSFER_SRC_OPTIMAL; make its color writes visible to the copy
+	VkImageMemoryBarrier imageBarrier = vulkan_utils::initializers::imageMemoryBarrier();
+	imageBarrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+	imageBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+	imageBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+	imageBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+	imageBarrier.image = target.image;
+	imageBarrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+	vkCmdPipelineBarrier(copyCmd, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageBarrier);
+
+	VkBufferImageCopy region{};
+	region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+	region.imageExtent = { width, height, 1 };
+	vkCmdCopyImageToBuffer(copyCmd, target.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, m_readbackBuffer, 1, &region);
+
+	VkBufferMemoryBarrier bufferBarrier = vulkan_utils::initializers::bufferMemoryBarrier();
+	bufferBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	bufferBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+	bufferBarrier.buffer = m_readbackBuffer;
+	bufferBarrier.size = size;
+	vkCmdPipelineBarrier(copyCmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr, 1, &bufferBarrier, 0, nullptr);
+
+	// Submits and waits on its own fence
+	m_device->flushCommandBuffer(copyCmd, m_graphicsQueue, m_commandPool);
+
+	void* mapped = nullptr;
+	VK_CHECK(vkMapMemory(m_device->logicalDevice, m_readbackMemory, 0, size, 0, &mapped));
+	pixels.resize(static_cast<size_t>(size));
+	memcpy(pixels.data(), mapped, static_cast<size_t>(size));
+	vkUnmapMemory(m_device->logicalDevice, m_readbackMemory);
+	return true;
 }
 
 // private methods
@@ -453,11 +695,15 @@ bool VulkanRenderingContext::createInstance() {
 	appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
 	appInfo.pEngineName = "Engine";
 	appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
-	appInfo.apiVersion = VK_API_VERSION_1_0;
+	// 1.2 for core descriptor indexing (bindless sprite textures) and the *2 feature queries
+	appInfo.apiVersion = VK_API_VERSION_1_2;
 	VkInstanceCreateInfo createInfo{};
 	createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
 	createInfo.pApplicationInfo = &appInfo;
-	createInfo.ppEnabledExtensionNames = glfwGetRequiredInstanceExtensions(&createInfo.enabledExtensionCount);
+	// Offscreen rendering needs no surface extensions (and glfw may not be initialized)
+	if (!isOffscreen()) {
+		createInfo.ppEnabledExtensionNames = glfwGetRequiredInstanceExtensions(&createInfo.enabledExtensionCount);
+	}
 	if (m_enableValidationLayers) {
 		createInfo.enabledLayerCount = static_cast<uint32_t>(m_validationLayers.size());
 		createInfo.ppEnabledLayerNames = m_validationLayers.data();
@@ -491,11 +737,11 @@ bool VulkanRenderingContext::setupDebugMessenger() {
 }
 
 bool VulkanRenderingContext::createSurface() {
-	if (!m_window.getWindowHandle()->handle) {
+	if (!m_window->getWindowHandle()->handle) {
 		return false; // No window to create surface for
 	}
 
-	glfwCreateWindowSurface(m_instance, m_window.getWindowHandle()->handle, nullptr, &m_surface);
+	glfwCreateWindowSurface(m_instance, m_window->getWindowHandle()->handle, nullptr, &m_surface);
 	if (m_surface == VK_NULL_HANDLE) {
 		std::cerr << "Failed to create Vulkan surface." << std::endl;
 		return false; // Surface creation failed
@@ -548,7 +794,20 @@ bool VulkanRenderingContext::createLogicalDevice() {
 		return false; // No physical device selected
 	}
 
-	auto result = m_device->createLogicalDevice();
+	// Enable what detectSpriteRenderingCapabilities found (descriptor indexing for the texture table)
+	VkPhysicalDeviceFeatures enabledFeatures{};
+	void* pNext = nullptr;
+	vulkan_utils::getSpriteRenderingRequiredFeatures(enabledFeatures, &pNext);
+	enabledFeatures.samplerAnisotropy &= m_device->features.samplerAnisotropy;
+	enabledFeatures.fillModeNonSolid &= m_device->features.fillModeNonSolid;
+	// Descriptor indexing is core in 1.2; the extension is only needed on older devices
+	std::vector<const char*> enabledExtensions;
+	if (m_device->properties.apiVersion < VK_API_VERSION_1_2) {
+		enabledExtensions = vulkan_utils::getSpriteRenderingRequiredExtensions();
+	}
+
+	// Offscreen mode does not present, so the swapchain extension is not requested
+	auto result = m_device->createLogicalDevice(enabledFeatures, enabledExtensions, pNext, !isOffscreen());
 	if (result != VK_SUCCESS) {
 		std::cerr << "Could not create Vulkan device: \n" << result << std::endl;
 		return false;
@@ -568,11 +827,8 @@ bool VulkanRenderingContext::createLogicalDevice() {
 
 bool VulkanRenderingContext::createSwapchain() {  
    
-    int width, height;  
-    m_window.getWindowSize(&width, &height);  
-
-    uint32_t swapchainWidth = static_cast<uint32_t>(width);  
-    uint32_t swapchainHeight = static_cast<uint32_t>(height);  
+    uint32_t swapchainWidth, swapchainHeight;  
+    getRenderExtent(swapchainWidth, swapchainHeight);  
 
     // VulkanSwapChain::create expects references that can be modified
     m_swapchain->create(swapchainWidth, swapchainHeight, false, false);
@@ -580,10 +836,73 @@ bool VulkanRenderingContext::createSwapchain() {
     return true; // Ensure the function returns a value  
 }
 
+bool VulkanRenderingContext::createOffscreenTargets()
+{
+	for (OffscreenTarget& target : m_offscreenTargets) {
+		VkImageCreateInfo imageCI = vulkan_utils::initializers::imageCreateInfo();
+		imageCI.imageType = VK_IMAGE_TYPE_2D;
+		imageCI.format = OFFSCREEN_COLOR_FORMAT;
+		imageCI.extent = { m_offscreenWidth, m_offscreenHeight, 1 };
+		imageCI.mipLevels = 1;
+		imageCI.arrayLayers = 1;
+		imageCI.samples = VK_SAMPLE_COUNT_1_BIT;
+		imageCI.tiling = VK_IMAGE_TILING_OPTIMAL;
+		imageCI.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+		VK_CHECK(vkCreateImage(m_device->logicalDevice, &imageCI, nullptr, &target.image));
+
+		VkMemoryRequirements memReqs{};
+		vkGetImageMemoryRequirements(m_device->logicalDevice, target.image, &memReqs);
+		VkMemoryAllocateInfo memAlloc = vulkan_utils::initializers::memoryAllocateInfo();
+		memAlloc.allocationSize = memReqs.size;
+		memAlloc.memoryTypeIndex = m_device->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+		VK_CHECK(vkAllocateMemory(m_device->logicalDevice, &memAlloc, nullptr, &target.memory));
+		VK_CHECK(vkBindImageMemory(m_device->logicalDevice, target.image, target.memory, 0));
+
+		VkImageViewCreateInfo viewCI = vulkan_utils::initializers::imageViewCreateInfo();
+		viewCI.viewType = VK_IMAGE_VIEW_TYPE_2D;
+		viewCI.format = OFFSCREEN_COLOR_FORMAT;
+		viewCI.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+		viewCI.image = target.image;
+		VK_CHECK(vkCreateImageView(m_device->logicalDevice, &viewCI, nullptr, &target.view));
+	}
+	std::cout << "Created " << m_offscreenTargets.size() << " offscreen targets of " << m_offscreenWidth << "x" << m_offscreenHeight << std::endl;
+	return true;
+}
+
+void VulkanRenderingContext::destroyOffscreenTargets()
+{
+	for (OffscreenTarget& target : m_offscreenTargets) {
+		if (target.view != VK_NULL_HANDLE) {
+			vkDestroyImageView(m_device->logicalDevice, target.view, nullptr);
+		}
+		if (target.image != VK_NULL_HANDLE) {
+			vkDestroyImage(m_device->logicalDevice, target.image, nullptr);
+		}
+		if (target.memory != VK_NULL_HANDLE) {
+			vkFreeMemory(m_device->logicalDevice, target.memory, nullptr);
+		}
+		target = OffscreenTarget{};
+	}
+	m_lastSubmittedFrame = UINT32_MAX;
+}
+
+void VulkanRenderingContext::destroyReadbackBuffer()
+{
+	if (m_readbackBuffer != VK_NULL_HANDLE) {
+		vkDestroyBuffer(m_device->logicalDevice, m_readbackBuffer, nullptr);
+		m_readbackBuffer = VK_NULL_HANDLE;
+	}
+	if (m_readbackMemory != VK_NULL_HANDLE) {
+		vkFreeMemory(m_device->logicalDevice, m_readbackMemory, nullptr);
+		m_readbackMemory = VK_NULL_HANDLE;
+	}
+	m_readbackSize = 0;
+}
+
 bool VulkanRenderingContext::createCommandPool() {
 	VkCommandPoolCreateInfo cmdPoolInfo = {};
 	cmdPoolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-	cmdPoolInfo.queueFamilyIndex = m_swapchain->queueNodeIndex;
+	cmdPoolInfo.queueFamilyIndex = m_swapchain ? m_swapchain->queueNodeIndex : m_device->queueFamilyIndices.graphics;
 	cmdPoolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
 	return vkCreateCommandPool(m_device->logicalDevice, &cmdPoolInfo, nullptr, &m_commandPool) == VK_SUCCESS;
 }
@@ -630,15 +949,112 @@ bool VulkanRenderingContext::createSyncObjects() {
 	return true; // Synchronization objects created successfully
 }
 
+bool VulkanRenderingContext::createGpuProfiler() {
+	uint32_t timestampValidBits = 0;
+#if ENABLE_SPRITE_PROFILING
+	if (g_spriteCapabilities.timestampQuerySupported) {
+		timestampValidBits = m_device->queueFamilyProperties[m_device->queueFamilyIndices.graphics].timestampValidBits;
+	}
+#endif
+	if (!m_gpuProfiler.initialize(m_device->logicalDevice, m_device->properties, timestampValidBits, MAX_FRAMES_IN_FLIGHT)) {
+		std::cerr << "Failed to create GPU timestamp query pools" << std::endl;
+		return false;
+	}
+	if (!m_gpuProfiler.isSupported()) {
+		std::cout << "GPU timestamp queries not supported, GPU profiling disabled" << std::endl;
+	}
+	return true;
+}
+
+bool VulkanRenderingContext::createSpriteBuffer()
+{
+	return m_spriteBuffer.initialize(m_device.get(), MAX_FRAMES_IN_FLIGHT);
+}
+
+bool VulkanRenderingContext::createTextureTable()
+{
+	// 1x1 white texture: slot 0 of the table, and what every free slot points at
+	VkImageCreateInfo imageCI = vulkan_utils::initializers::imageCreateInfo();
+	imageCI.imageType = VK_IMAGE_TYPE_2D;
+	imageCI.format = VK_FORMAT_R8G8B8A8_UNORM;
+	imageCI.extent = { 1, 1, 1 };
+	imageCI.mipLevels = 1;
+	imageCI.arrayLayers = 1;
+	imageCI.samples = VK_SAMPLE_COUNT_1_BIT;
+	imageCI.tiling = VK_IMAGE_TILING_OPTIMAL;
+	imageCI.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+	VK_CHECK(vkCreateImage(m_device->logicalDevice, &imageCI, nullptr, &m_defaultTexture.image));
+
+	VkMemoryRequirements memReqs{};
+	vkGetImageMemoryRequirements(m_device->logicalDevice, m_defaultTexture.image, &memReqs);
+	VkMemoryAllocateInfo memAlloc = vulkan_utils::initializers::memoryAllocateInfo();
+	memAlloc.allocationSize = memReqs.size;
+	memAlloc.memoryTypeIndex = m_device->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+	VK_CHECK(vkAllocateMemory(m_device->logicalDevice, &memAlloc, nullptr, &m_defaultTexture.memory));
+	VK_CHECK(vkBindImageMemory(m_device->logicalDevice, m_defaultTexture.image, m_defaultTexture.memory, 0));
+
+	// Clear it to white and leave it ready for sampling
+	VkImageSubresourceRange range{ VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+	VkCommandBuffer copyCmd = m_device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+	vulkan_utils::setImageLayout(copyCmd, m_defaultTexture.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, range);
+	VkClearColorValue white = { { 1.0f, 1.0f, 1.0f, 1.0f } };
+	vkCmdClearColorImage(copyCmd, m_defaultTexture.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &white, 1, &range);
+	vulkan_utils::setImageLayout(copyCmd, m_defaultTexture.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, range);
+	m_device->flushCommandBuffer(copyCmd, m_graphicsQueue);
+
+	VkImageViewCreateInfo viewCI = vulkan_utils::initializers::imageViewCreateInfo();
+	viewCI.viewType = VK_IMAGE_VIEW_TYPE_2D;
+	viewCI.image = m_defaultTexture.image;
+	viewCI.format = imageCI.format;
+	viewCI.subresourceRange = range;
+	VK_CHECK(vkCreateImageView(m_device->logicalDevice, &viewCI, nullptr, &m_defaultTexture.view));
+
+	// Shared by sprite textures unless they bring their own
+	VkSamplerCreateInfo samplerCI = vulkan_utils::initializers::samplerCreateInfo();
+	samplerCI.magFilter = VK_FILTER_LINEAR;
+	samplerCI.minFilter = VK_FILTER_LINEAR;
+	samplerCI.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+	samplerCI.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	samplerCI.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	samplerCI.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	samplerCI.maxLod = VK_LOD_CLAMP_NONE;
+	samplerCI.maxAnisotropy = 1.0f;
+	samplerCI.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
+	VK_CHECK(vkCreateSampler(m_device->logicalDevice, &samplerCI, nullptr, &m_spriteSampler));
+
+	// Without descriptor indexing sprites are drawn per texture run (see SpriteBatcher)
+	const bool bindless = ENABLE_BINDLESS && g_spriteCapabilities.bindlessSupported;
+	return m_textureTable.initialize(m_device->logicalDevice, bindless, g_spriteCapabilities.maxPerStageDescriptorSampledImages,
+		MAX_FRAMES_IN_FLIGHT, m_defaultTexture.view, m_spriteSampler);
+}
+
+void VulkanRenderingContext::destroyDefaultTexture()
+{
+	if (m_spriteSampler != VK_NULL_HANDLE) {
+		vkDestroySampler(m_device->logicalDevice, m_spriteSampler, nullptr);
+		m_spriteSampler = VK_NULL_HANDLE;
+	}
+	if (m_defaultTexture.view != VK_NULL_HANDLE) {
+		vkDestroyImageView(m_device->logicalDevice, m_defaultTexture.view, nullptr);
+	}
+	if (m_defaultTexture.image != VK_NULL_HANDLE) {
+		vkDestroyImage(m_device->logicalDevice, m_defaultTexture.image, nullptr);
+	}
+	if (m_defaultTexture.memory != VK_NULL_HANDLE) {
+		vkFreeMemory(m_device->logicalDevice, m_defaultTexture.memory, nullptr);
+	}
+	m_defaultTexture = {};
+}
+
 bool VulkanRenderingContext::setupDepthStencil()
 {
 	VkImageCreateInfo imageCI{};
 	imageCI.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
 	imageCI.imageType = VK_IMAGE_TYPE_2D;
 	imageCI.format = m_depthFormat;
-	int height, width;
-	m_window.getWindowSize(&width, &height);
-	imageCI.extent = { static_cast<uint32_t>(width), static_cast<uint32_t>(height), 1 };
+	uint32_t width, height;
+	getRenderExtent(width, height);
+	imageCI.extent = { width, height, 1 };
 	imageCI.mipLevels = 1;
 	imageCI.arrayLayers = 1;
 	imageCI.samples = VK_SAMPLE_COUNT_1_BIT;
@@ -681,14 +1097,15 @@ bool VulkanRenderingContext::setupRenderPass()
 {
 	std::array<VkAttachmentDescription, 2> attachments = {};
 	// Color attachment
-	attachments[0].format = m_swapchain->colorFormat;
+	attachments[0].format = getColorFormat();
 	attachments[0].samples = VK_SAMPLE_COUNT_1_BIT;
 	attachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
 	attachments[0].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
 	attachments[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
 	attachments[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
 	attachments[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-	attachments[0].finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+	// Offscreen targets are only ever copied from after the pass
+	attachments[0].finalLayout = isOffscreen() ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 	// Depth attachment
 	attachments[1].format = m_depthFormat;
 	attachments[1].samples = VK_SAMPLE_COUNT_1_BIT;
@@ -760,12 +1177,14 @@ bool VulkanRenderingContext::createPipelineCache()
 
 bool VulkanRenderingContext::setupFrameBuffer()
 {
-	// Create frame buffers for every swap chain image
-	m_framebuffers.resize(m_swapchain->images.size());
+	// Create frame buffers for every swap chain image (or offscreen target)
+	m_framebuffers.resize(isOffscreen() ? m_offscreenTargets.size() : m_swapchain->images.size());
+	uint32_t width, height;
+	getRenderExtent(width, height);
 	for (uint32_t i = 0; i < m_framebuffers.size(); i++)
 	{
 		const VkImageView attachments[2] = {
-			m_swapchain->imageViews[i],
+			isOffscreen() ? m_offscreenTargets[i].view : m_swapchain->imageViews[i],
 			// Depth/Stencil attachment is the same for all frame buffers
 			m_depthStencil.view
 		};
@@ -774,8 +1193,6 @@ bool VulkanRenderingContext::setupFrameBuffer()
 		frameBufferCreateInfo.renderPass = m_renderPass;
 		frameBufferCreateInfo.attachmentCount = 2;
 		frameBufferCreateInfo.pAttachments = attachments;
-		int width, height;
-		m_window.getWindowSize(&width, &height);
 		frameBufferCreateInfo.width = width;
 		frameBufferCreateInfo.height = height;
 		frameBufferCreateInfo.layers = 1;
@@ -795,7 +1212,7 @@ bool VulkanRenderingContext::setupUIOverlay()
 		loadShader("uioverlay.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT),
 	};
 	m_gui.prepareResources();
-	m_gui.preparePipeline(m_pipelineCache, m_renderPass, m_swapchain->colorFormat, m_depthFormat);
+	m_gui.preparePipeline(m_pipelineCache, m_renderPass, getColorFormat(), m_depthFormat);
 	return true;
 }
 
@@ -1011,18 +1428,45 @@ bool VulkanRenderingContext::createUniformBuffers()
 // So every shader binding should map to one descriptor set layout binding
 bool VulkanRenderingContext::createDescriptorSetLayout()
 {
+	// The sprite cull compute pass binds the same set, so sprite bindings are visible to compute too
+	std::array<VkDescriptorSetLayoutBinding, 5> layoutBindings{};
 	// Binding 0: Uniform buffer (Vertex shader)
-	VkDescriptorSetLayoutBinding layoutBinding{};
-	layoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-	layoutBinding.descriptorCount = 1;
-	layoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
-	layoutBinding.pImmutableSamplers = nullptr;
+	layoutBindings[0].binding = 0;
+	layoutBindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+	layoutBindings[0].descriptorCount = 1;
+	layoutBindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+	layoutBindings[0].pImmutableSamplers = nullptr;
+	// Binding 1: Sprite storage buffer, pulled by instance index (Vertex shader)
+	// Only written once the frame's sprite buffer exists; the triangle pipeline never reads it
+	layoutBindings[1].binding = 1;
+	layoutBindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	layoutBindings[1].descriptorCount = 1;
+	layoutBindings[1].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+	layoutBindings[1].pImmutableSamplers = nullptr;
+	// Binding 2: Sprite slots to draw: the cull output when bindless, the (texture, depth) order otherwise (Vertex/compute shader)
+	layoutBindings[2].binding = 2;
+	layoutBindings[2].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	layoutBindings[2].descriptorCount = 1;
+	layoutBindings[2].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+	layoutBindings[2].pImmutableSamplers = nullptr;
+	// Binding 3: Indirect sprite draw command, written by the cull pass (Compute shader)
+	layoutBindings[3].binding = 3;
+	layoutBindings[3].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	layoutBindings[3].descriptorCount = 1;
+	layoutBindings[3].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	layoutBindings[3].pImmutableSamplers = nullptr;
+	// Binding 4: Sort key per visible sprite, written by the cull pass and sorted with binding 2 (Compute shader)
+	layoutBindings[4].binding = 4;
+	layoutBindings[4].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	layoutBindings[4].descriptorCount = 1;
+	layoutBindings[4].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	layoutBindings[4].pImmutableSamplers = nullptr;
 
 	VkDescriptorSetLayoutCreateInfo descriptorLayoutCI{};
 	descriptorLayoutCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
 	descriptorLayoutCI.pNext = nullptr;
-	descriptorLayoutCI.bindingCount = 1;
-	descriptorLayoutCI.pBindings = &layoutBinding;
+	descriptorLayoutCI.bindingCount = static_cast<uint32_t>(layoutBindings.size());
+	descriptorLayoutCI.pBindings = layoutBindings.data();
 	VK_CHECK(vkCreateDescriptorSetLayout(m_device->logicalDevice, &descriptorLayoutCI, nullptr, &m_descriptorSetLayout));
 	return true;
 }
@@ -1030,11 +1474,13 @@ bool VulkanRenderingContext::createDescriptorSetLayout()
 bool VulkanRenderingContext::createDescriptorPool()
 {
 	// We need to tell the API the number of max. requested descriptors per type
-	VkDescriptorPoolSize descriptorTypeCounts[1]{};
-	// This example only one descriptor type (uniform buffer)
+	VkDescriptorPoolSize descriptorTypeCounts[2]{};
 	descriptorTypeCounts[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
 	// We have one buffer (and as such descriptor) per frame
 	descriptorTypeCounts[0].descriptorCount = MAX_CONCURRENT_FRAMES;
+	// And the sprite, sprite slot, draw command and sort key storage buffers per frame
+	descriptorTypeCounts[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	descriptorTypeCounts[1].descriptorCount = 4 * MAX_CONCURRENT_FRAMES;
 	// For additional types you need to add new entries in the type count list
 	// E.g. for two combined image samplers :
 	// typeCounts[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
@@ -1045,7 +1491,7 @@ bool VulkanRenderingContext::createDescriptorPool()
 	VkDescriptorPoolCreateInfo descriptorPoolCI{};
 	descriptorPoolCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
 	descriptorPoolCI.pNext = nullptr;
-	descriptorPoolCI.poolSizeCount = 1;
+	descriptorPoolCI.poolSizeCount = 2;
 	descriptorPoolCI.pPoolSizes = descriptorTypeCounts;
 	// Set the max. number of descriptor sets that can be requested from this pool (requesting beyond this limit will result in an error)
 	// Our sample will create one set per uniform buffer per frame
@@ -1096,8 +1542,14 @@ bool VulkanRenderingContext::createPipelines()
 	VkPipelineLayoutCreateInfo pipelineLayoutCI{};
 	pipelineLayoutCI.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
 	pipelineLayoutCI.pNext = nullptr;
-	pipelineLayoutCI.setLayoutCount = 1;
-	pipelineLayoutCI.pSetLayouts = &m_descriptorSetLayout;
+	// Set 0: per-frame uniforms and sprite buffer, set 1: the global sprite texture table
+	const std::array<VkDescriptorSetLayout, 2> setLayouts = { m_descriptorSetLayout, m_textureTable.getLayout() };
+	pipelineLayoutCI.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+	pipelineLayoutCI.pSetLayouts = setLayouts.data();
+	// The batched sprite pipeline gets the first order entry of its texture run
+	VkPushConstantRange pushConstantRange = vulkan_utils::initializers::pushConstantRange(VK_SHADER_STAGE_VERTEX_BIT, sizeof(uint32_t), 0);
+	pipelineLayoutCI.pushConstantRangeCount = 1;
+	pipelineLayoutCI.pPushConstantRanges = &pushConstantRange;
 	VK_CHECK(vkCreatePipelineLayout(m_device->logicalDevice, &pipelineLayoutCI, nullptr, &m_pipelineLayout));
 
 	// Create the graphics pipeline used in this example
@@ -1237,7 +1689,130 @@ bool VulkanRenderingContext::createPipelines()
 	VK_CHECK(vkCreateGraphicsPipelines(m_device->logicalDevice, m_pipelineCache, 1, &pipelineCI, nullptr, &m_pipeline));
 
 	// Shader modules are no longer needed once the graphics pipeline has been created
+	vkDestroyShaderModule(m_device->logicalDevice, shaderStages[0].module, nullptr);
+	vkDestroyShaderModule(m_device->logicalDevice, shaderStages[1].module, nullptr);
+	return createSpritePipeline();
+}
+
+bool VulkanRenderingContext::createSpritePipeline()
+{
+	// Vertex pulling: corners come from the vertex index and sprites from the storage buffer, so there is no vertex input
+	VkPipelineVertexInputStateCreateInfo vertexInputStateCI = vulkan_utils::initializers::pipelineVertexInputStateCreateInfo();
+	VkPipelineInputAssemblyStateCreateInfo inputAssemblyStateCI = vulkan_utils::initializers::pipelineInputAssemblyStateCreateInfo(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, 0, VK_FALSE);
+	VkPipelineRasterizationStateCreateInfo rasterizationStateCI = vulkan_utils::initializers::pipelineRasterizationStateCreateInfo(VK_POLYGON_MODE_FILL, VK_CULL_MODE_NONE, VK_FRONT_FACE_COUNTER_CLOCKWISE);
+
+	// Sprites are alpha blended in draw order
+	VkPipelineColorBlendAttachmentState blendAttachmentState{};
+	blendAttachmentState.blendEnable = VK_TRUE;
+	blendAttachmentState.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+	blendAttachmentState.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+	blendAttachmentState.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+	blendAttachmentState.colorBlendOp = VK_BLEND_OP_ADD;
+	blendAttachmentState.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+	blendAttachmentState.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+	blendAttachmentState.alphaBlendOp = VK_BLEND_OP_ADD;
+	VkPipelineColorBlendStateCreateInfo colorBlendStateCI = vulkan_utils::initializers::pipelineColorBlendStateCreateInfo(1, &blendAttachmentState);
+
+	VkPipelineDepthStencilStateCreateInfo depthStencilStateCI = vulkan_utils::initializers::pipelineDepthStencilStateCreateInfo(VK_FALSE, VK_FALSE, VK_COMPARE_OP_LESS_OR_EQUAL);
+	VkPipelineViewportStateCreateInfo viewportStateCI = vulkan_utils::initializers::pipelineViewportStateCreateInfo(1, 1, 0);
+	VkPipelineMultisampleStateCreateInfo multisampleStateCI = vulkan_utils::initializers::pipelineMultisampleStateCreateInfo(VK_SAMPLE_COUNT_1_BIT, 0);
+	std::array<VkDynamicState, 2> dynamicStateEnables = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+	VkPipelineDynamicStateCreateInfo dynamicStateCI = vulkan_utils::initializers::pipelineDynamicStateCreateInfo(dynamicStateEnables.data(), static_cast<uint32_t>(dynamicStateEnables.size()), 0);
+
+	// Same states either way; the batched shaders read sprites through the order buffer and sample one bound texture
+	const std::string shaderName = m_textureTable.isBindless() ? "sprite" : "sprite_batched";
+	std::array<VkPipelineShaderStageCreateInfo, 2> shaderStages{
+		loadShader(shaderName + ".vert.spv", VK_SHADER_STAGE_VERTEX_BIT),
+		loadShader(shaderName + ".frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT)};
+
+	VkGraphicsPipelineCreateInfo pipelineCI = vulkan_utils::initializers::pipelineCreateInfo(m_pipelineLayout, m_renderPass, 0);
+	pipelineCI.stageCount = static_cast<uint32_t>(shaderStages.size());
+	pipelineCI.pStages = shaderStages.data();
+	pipelineCI.pVertexInputState = &vertexInputStateCI;
+	pipelineCI.pInputAssemblyState = &inputAssemblyStateCI;
+	pipelineCI.pRasterizationState = &rasterizationStateCI;
+	pipelineCI.pColorBlendState = &colorBlendStateCI;
+	pipelineCI.pMultisampleState = &multisampleStateCI;
+	pipelineCI.pViewportState = &viewportStateCI;
+	pipelineCI.pDepthStencilState = &depthStencilStateCI;
+	pipelineCI.pDynamicState = &dynamicStateCI;
+	VK_CHECK(vkCreateGraphicsPipelines(m_device->logicalDevice, m_pipelineCache, 1, &pipelineCI, nullptr, &m_spritePipeline));
+
 	vkDestroyShaderModule(m_device->logicalDevice, shaderStages[0].module, nullptr);
 	vkDestroyShaderModule(m_device->logicalDevice, shaderStages[1].module, nullptr);
 	return true;
+}
+
+bool VulkanRenderingContext::createSpriteCuller()
+{
+	// Only the bindless path draws a single list of sprites; the batched path draws per texture run
+	if (!m_textureTable.isBindless()) {
+		return true;
+	}
+	VkPipelineShaderStageCreateInfo cullStage = loadShader("sprite_cull.comp.spv", VK_SHADER_STAGE_COMPUTE_BIT);
+#if ENABLE_SPRITE_DEPTH_SORT
+	// Back-to-front order for blending, sorted on the GPU after the cull
+	VkPipelineShaderStageCreateInfo sortStage = loadShader("sprite_sort.comp.spv", VK_SHADER_STAGE_COMPUTE_BIT);
+	const bool result = m_spriteCuller.initialize(m_device.get(), MAX_FRAMES_IN_FLIGHT, m_descriptorSetLayout, m_pipelineCache, cullStage, &sortStage);
+	vkDestroyShaderModule(m_device->logicalDevice, sortStage.module, nullptr);
+#else
+	const bool result = m_spriteCuller.initialize(m_device.get(), MAX_FRAMES_IN_FLIGHT, m_descriptorSetLayout, m_pipelineCache, cullStage, nullptr);
+#endif
+	vkDestroyShaderModule(m_device->logicalDevice, cullStage.module, nullptr);
+	return result;
+}
+
+void VulkanRenderingContext::updateSpriteDescriptor(uint32_t frameIndex)
+{
+	const VkDescriptorSet descriptorSet = m_uniformBuffers[frameIndex].descriptorSet;
+	VkWriteDescriptorSet writeDescriptorSet{};
+	if (m_spriteBuffer.getBuffer(frameIndex) != VK_NULL_HANDLE) {
+		// Binding 1 : Sprite storage buffer
+		VkDescriptorBufferInfo bufferInfo = m_spriteBuffer.getDescriptor(frameIndex);
+		writeDescriptorSet = vulkan_utils::initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, &bufferInfo);
+		vkUpdateDescriptorSets(m_device->logicalDevice, 1, &writeDescriptorSet, 0, nullptr);
+	}
+	if (m_textureTable.isBindless()) {
+		// Binding 2 : Visible sprite slots, Binding 3 : Indirect draw command, Binding 4 : Sort keys (all written by the cull pass)
+		VkDescriptorBufferInfo visibleInfo = m_spriteCuller.getVisibleDescriptor(frameIndex);
+		VkDescriptorBufferInfo drawInfo = m_spriteCuller.getDrawDescriptor(frameIndex);
+		VkDescriptorBufferInfo keyInfo = m_spriteCuller.getSortKeyDescriptor(frameIndex);
+		std::array<VkWriteDescriptorSet, 3> cullWrites = {
+			vulkan_utils::initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2, &visibleInfo),
+			vulkan_utils::initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 3, &drawInfo),
+			vulkan_utils::initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 4, &keyInfo)
+		};
+		vkUpdateDescriptorSets(m_device->logicalDevice, static_cast<uint32_t>(cullWrites.size()), cullWrites.data(), 0, nullptr);
+	} else if (m_spriteBuffer.hasOrder(frameIndex)) {
+		// Binding 2 : Sprite order buffer
+		VkDescriptorBufferInfo orderInfo = m_spriteBuffer.getOrderDescriptor(frameIndex);
+		writeDescriptorSet = vulkan_utils::initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2, &orderInfo);
+		vkUpdateDescriptorSets(m_device->logicalDevice, 1, &writeDescriptorSet, 0, nullptr);
+	}
+}
+
+void VulkanRenderingContext::drawSprites(VkCommandBuffer commandBuffer)
+{
+	const uint32_t spriteCount = m_spriteBuffer.getSpriteCount();
+	if (spriteCount == 0) {
+		return;
+	}
+	GpuProfiler::Scope spriteScope(m_gpuProfiler, commandBuffer, "Sprites");
+	// The per-frame descriptor set bound for the triangle also holds this frame's sprite buffer
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_spritePipeline);
+	if (!m_textureTable.isBindless()) {
+		// One draw per texture run; runs are unique per texture, so each binds its set once
+		for (const SpriteBatcher::TextureRun& run : m_spriteBatcher.getRuns()) {
+			const VkDescriptorSet runSet = m_textureTable.getDescriptorSet(run.textureIndex);
+			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 1, 1, &runSet, 0, nullptr);
+			vkCmdPushConstants(commandBuffer, m_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(uint32_t), &run.first);
+			vkCmdDraw(commandBuffer, 6, run.count, 0, 0);
+		}
+		return;
+	}
+	// All sprite textures live in one set, so sprites with different textures still share the draw
+	const VkDescriptorSet textureSet = m_textureTable.getDescriptorSet();
+	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 1, 1, &textureSet, 0, nullptr);
+	// One instance per sprite that survived culling; the count never reaches the CPU
+	vkCmdDrawIndirect(commandBuffer, m_spriteCuller.getDrawBuffer(m_currentFrame), 0, 1, sizeof(VkDrawIndirectCommand));
 }
\ No newline at end of file
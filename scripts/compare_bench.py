@@ -0,0 +1,50 @@
+# Compare two engine-bench JSON result files (engine-bench --json) and flag regressions
+
+import argparse
+import json
+import sys
+
+parser = argparse.ArgumentParser(description='Compare engine-bench results')
+parser.add_argument('baseline', type=str, help='JSON results of the reference build')
+parser.add_argument('current', type=str, help='JSON results of the build under test')
+parser.add_argument('--threshold', type=float, default=10.0, help='percent slowdown reported as a regression (default 10)')
+args = parser.parse_args()
+
+def load(path):
+    with open(path, 'r') as f:
+        data = json.load(f)
+    results = {}
+    for r in data['results']:
+        results[(r['suite'], r['name'], r['scale'])] = r
+    return data, results
+
+baselineInfo, baseline = load(args.baseline)
+currentInfo, current = load(args.current)
+print('baseline: {} ({}, {})'.format(baselineInfo.get('version'), baselineInfo.get('build_type'), baselineInfo.get('timestamp')))
+print('current:  {} ({}, {})'.format(currentInfo.get('version'), currentInfo.get('build_type'), currentInfo.get('timestamp')))
+print()
+
+regressions = 0
+print('{:<10} {:<32} {:>9} {:>14} {:>14} {:>9}'.format('suite', 'name', 'scale', 'base ns/item', 'curr ns/item', 'change'))
+for key in sorted(current.keys()):
+    if key not in baseline:
+        continue
+    before = baseline[key]['median_ns']
+    after = current[key]['median_ns']
+    if before <= 0:
+        continue
+    change = (after - before) / before * 100.0
+    flag = ''
+    if change > args.threshold:
+        flag = '  REGRESSION'
+        regressions += 1
+    print('{:<10} {:<32} {:>9} {:>14.3f} {:>14.3f} {:>+8.1f}%{}'.format(
+        key[0], key[1], key[2], baseline[key]['ns_per_item'], current[key]['ns_per_item'], change, flag))
+
+missing = sorted(set(baseline.keys()) - set(current.keys()))
+for key in missing:
+    print('{:<10} {:<32} {:>9}  missing from current results'.format(key[0], key[1], key[2]))
+
+print()
+print('{} regression(s) above {:.1f}%'.format(regressions, args.threshold))
+sys.exit(1 if regressions else 0)
@@ -0,0 +1,106 @@
+# Render a binary log written by Logging::BinaryLog (engine/entities/include/utils/BinaryLog.h) to text
+
+import argparse
+import struct
+import sys
+
+MAGIC = b'ECSBLOG\0'
+VERSION = 1
+DATA_OFFSET = 64
+
+HEADER = struct.Struct('<8sIIQQqQ')   # magic, version, reserved, capacity, used, start_wall_ns, dropped
+RECORD = struct.Struct('<HHIQIBBH')   # kind, size, format_id, timestamp_ns, thread, level, arg_count, reserved
+
+KIND_END = 0
+KIND_FORMAT = 1
+KIND_EVENT = 2
+
+LEVELS = ['DEBUG', 'INFO', 'WARNING', 'ERROR', 'FATAL']
+
+parser = argparse.ArgumentParser(description='Decode a binary engine log')
+parser.add_argument('log', type=str, help='path to the binary log file')
+parser.add_argument('--wall-clock', action='store_true', help='print absolute timestamps instead of seconds since open')
+args = parser.parse_args()
+
+def records(data, end):
+    offset = DATA_OFFSET
+    while offset + RECORD.size <= end:
+        record = RECORD.unpack_from(data, offset)
+        kind, size = record[0], record[1]
+        if kind == KIND_END or size < RECORD.size or offset + size > end:
+            return
+        yield record, data[offset + RECORD.size:offset + size]
+        offset += size
+
+def readArg(payload, pos):
+    tag = payload[pos]
+    pos += 1
+    if tag == 1:
+        return str(struct.unpack_from('<q', payload, pos)[0]), pos + 8
+    if tag == 2:
+        return str(struct.unpack_from('<Q', payload, pos)[0]), pos + 8
+    if tag == 3:
+        return '%g' % struct.unpack_from('<d', payload, pos)[0], pos + 8
+    if tag == 4:
+        length = struct.unpack_from('<H', payload, pos)[0]
+        pos += 2
+        return payload[pos:pos + length].decode('utf-8', 'replace'), pos + length
+    if tag == 5:
+        return '0x%x' % struct.unpack_from('<Q', payload, pos)[0], pos + 8
+    if tag == 6:
+        return ('true' if payload[pos] else 'false'), pos + 1
+    raise ValueError('unknown argument tag %d' % tag)
+
+def render(format, payload, count):
+    values = []
+    pos = 0
+    try:
+        for _ in range(count):
+            value, pos = readArg(payload, pos)
+            values.append(value)
+    except (ValueError, IndexError, struct.error):
+        values.append('<corrupt>')
+    text = ''
+    index = 0
+    parts = format.split('{}')
+    for i, part in enumerate(parts):
+        text += part
+        if i + 1 < len(parts):
+            text += values[index] if index < len(values) else '{}'
+            index += 1
+    # Arguments without a placeholder are appended
+    for value in values[index:]:
+        text += ' ' + value
+    return text
+
+with open(args.log, 'rb') as f:
+    data = f.read()
+
+if len(data) < DATA_OFFSET:
+    sys.exit('File too small to be a binary log')
+magic, version, _, capacity, used, start_wall_ns, dropped = HEADER.unpack_from(data, 0)
+if magic != MAGIC or version != VERSION:
+    sys.exit('Not a binary log, or unsupported version')
+# A log that was not closed has no size; scan until the first empty record
+end = min(used, len(data)) if used else len(data)
+
+formats = {}
+for record, payload in records(data, end):
+    if record[0] == KIND_FORMAT and len(payload) >= 8:
+        line, file_length, format_length = struct.unpack_from('<IHH', payload, 0)
+        formats[record[2]] = payload[8 + file_length:8 + file_length + format_length].decode('utf-8', 'replace')
+
+for record, payload in records(data, end):
+    kind, _, format_id, timestamp_ns, thread, level, arg_count, _ = record
+    if kind != KIND_EVENT:
+        continue
+    if args.wall_clock:
+        stamp = '%.6f' % ((start_wall_ns + timestamp_ns) * 1e-9)
+    else:
+        stamp = '%14.6f' % (timestamp_ns * 1e-9)
+    level_name = LEVELS[level] if level < len(LEVELS) else 'UNKNOWN'
+    format = formats.get(format_id, '<unknown format %d>' % format_id)
+    print('[%s] [T%d] [%s] %s' % (stamp, thread, level_name, render(format, payload, arg_count)))
+
+if dropped:
+    print('%d records dropped (log full)' % dropped)
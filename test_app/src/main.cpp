@@ -7,5 +7,7 @@ int main() {
         std::cerr << "Failed to initialize the engine" << std::endl;
         return 1;
     }
+    engine.run();
+    engine.shutdown();
     return 0;
 }